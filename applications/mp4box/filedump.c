@@ -894,6 +894,137 @@ void dump_isom_timestamps(GF_ISOFile *file, char *inName, Bool is_final_name)
 	if (has_error) fprintf(stderr, "\tFile has CTTS table errors\n");
 }
 
+#ifndef	GPAC_DISABLE_ISOM_FRAGMENTS
+
+typedef struct
+{
+	GF_ISOFile *file;
+	u32 last_box_type;
+	/*sample count of each track at the end of each mdat parsed and not yet dumped*/
+	u32 *counts;
+	u32 nb_counts, alloc_counts;
+} PushDumpCtx;
+
+static void dump_push_on_top_box(void *udta, u32 box_type, u64 box_start, u64 box_size)
+{
+	u32 i, nb_tracks;
+	PushDumpCtx *ctx = (PushDumpCtx *)udta;
+
+	ctx->last_box_type = box_type;
+	if (box_type != GF_4CC('m','d','a','t')) return;
+	/*samples are read once the callback returns, the file data may not be accessed while parsing*/
+	nb_tracks = gf_isom_get_track_count(ctx->file);
+	if (ctx->nb_counts + nb_tracks > ctx->alloc_counts) {
+		ctx->alloc_counts = ctx->nb_counts + nb_tracks + 32;
+		ctx->counts = (u32 *)gf_realloc(ctx->counts, sizeof(u32) * ctx->alloc_counts);
+	}
+	for (i=0; i<nb_tracks; i++) {
+		ctx->counts[ctx->nb_counts] = gf_isom_get_sample_count(ctx->file, i+1);
+		ctx->nb_counts++;
+	}
+}
+
+static void dump_push_samples(FILE *dump, GF_ISOFile *file, u32 *counts, u32 *nb_fetched)
+{
+	u32 i, j;
+	for (i=0; i<gf_isom_get_track_count(file); i++) {
+		u32 count = counts ? counts[i] : gf_isom_get_sample_count(file, i+1);
+		for (j=nb_fetched[i]; j<count; j++) {
+			u64 dts, cts;
+			GF_ISOSample *samp = gf_isom_get_sample(file, i+1, j+1, NULL);
+			if (!samp) {
+				fprintf(dump, "Track %d Sample %d NOT THERE !!!\n", gf_isom_get_track_id(file, i+1), j+1);
+				continue;
+			}
+			dts = samp->DTS;
+			cts = dts + (s32) samp->CTS_Offset;
+			fprintf(dump, "Track %d Sample %d\tDTS "LLD"\tCTS "LLD"\t%d\t%d\tCRC %08X\n", gf_isom_get_track_id(file, i+1), j+1, LLD_CAST dts, LLD_CAST cts, samp->dataLength, samp->IsRAP, gf_crc_32(samp->data, samp->dataLength));
+			gf_isom_sample_del(&samp);
+		}
+		if (count > nb_fetched[i]) nb_fetched[i] = count;
+	}
+}
+
+/*parses the file in push mode by chunks of chunk_size bytes, dumping the samples of each fragment once received
+and releasing the fragments after each chunk. Sample numbers are not reset by releases*/
+void dump_isom_push(char *fileName, u32 chunk_size, char *inName, Bool is_final_name)
+{
+	u32 i, read;
+	u32 nb_fetched[1024];
+	char *buf;
+	FILE *in, *dump;
+	GF_ISOFile *file;
+	GF_Err e;
+	PushDumpCtx ctx;
+	char szBuf[1024];
+
+	if (!chunk_size) chunk_size = 4096;
+	in = gf_fopen(fileName, "rb");
+	if (!in) {
+		fprintf(stderr, "Cannot open input file %s\n", fileName);
+		return;
+	}
+	if (inName) {
+		strcpy(szBuf, inName);
+		if (!is_final_name) strcat(szBuf, "_push.txt");
+		dump = gf_fopen(szBuf, "wt");
+		if (!dump) {
+			fprintf(stderr, "Failed to open %s\n", szBuf);
+			gf_fclose(in);
+			return;
+		}
+	} else {
+		dump = stdout;
+	}
+
+	memset(&ctx, 0, sizeof(PushDumpCtx));
+	memset(nb_fetched, 0, sizeof(nb_fetched));
+	buf = (char *)gf_malloc(sizeof(char) * chunk_size);
+	e = gf_isom_open_push(&file, dump_push_on_top_box, &ctx);
+	if (!e && !buf) e = GF_OUT_OF_MEM;
+	if (e) {
+		fprintf(stderr, "Cannot open push parser: %s\n", gf_error_to_string(e));
+		goto exit;
+	}
+	ctx.file = file;
+
+	while ((read = (u32) fread(buf, 1, chunk_size, in)) > 0) {
+		e = gf_isom_push_data(file, buf, read, NULL);
+		if (e && (e != GF_ISOM_INCOMPLETE_FILE)) {
+			fprintf(stderr, "Error parsing %s in push mode: %s\n", fileName, gf_error_to_string(e));
+			break;
+		}
+		if (gf_isom_get_track_count(file) > 1024) {
+			fprintf(stderr, "Too many tracks in %s\n", fileName);
+			break;
+		}
+		/*dump fragment by fragment, so that the output does not depend on the chunk size*/
+		for (i=0; i<ctx.nb_counts; i+=gf_isom_get_track_count(file)) {
+			dump_push_samples(dump, file, &ctx.counts[i], nb_fetched);
+		}
+		ctx.nb_counts = 0;
+		/*all received fragments are dumped, discard them unless a moof is waiting for its mdat*/
+		if (gf_isom_is_fragmented(file) && (ctx.last_box_type == GF_4CC('m','d','a','t'))) {
+			e = gf_isom_push_release(file);
+			if (e) {
+				fprintf(stderr, "Error releasing push data: %s\n", gf_error_to_string(e));
+				break;
+			}
+		}
+	}
+	if (gf_isom_get_track_count(file) <= 1024)
+		dump_push_samples(dump, file, NULL, nb_fetched);
+
+	gf_isom_close(file);
+
+exit:
+	if (buf) gf_free(buf);
+	if (ctx.counts) gf_free(ctx.counts);
+	gf_fclose(in);
+	if (inName) gf_fclose(dump);
+}
+#endif /*GPAC_DISABLE_ISOM_FRAGMENTS*/
+
 
 
 static u32 read_nal_size_hdr(char *ptr, u32 nalh_size)
@@ -114,6 +114,9 @@ void dump_isom_sdp(GF_ISOFile *file, char *inName, Bool is_final_name);
 
 void dump_isom_timestamps(GF_ISOFile *file, char *inName, Bool is_final_name);
 void dump_isom_nal(GF_ISOFile *file, u32 trackID, char *inName, Bool is_final_name);
+#ifndef GPAC_DISABLE_ISOM_FRAGMENTS
+void dump_isom_push(char *fileName, u32 chunk_size, char *inName, Bool is_final_name);
+#endif
 
 #ifndef GPAC_DISABLE_ISOM_DUMP
 void dump_isom_ismacryp(GF_ISOFile *file, char *inName, Bool is_final_name);
@@ -209,6 +212,8 @@ void PrintGeneralUsage()
 	        " -tight               performs tight interleaving (sample based) of the file\n"
 	        "                       * Note: reduces disk seek but increases file size\n"
 	        " -flat                stores file with all media data first, non-interleaved\n"
+	        " -moov-reserve kb     with -flat on a new file, reserves kb kilobytes before media data for the moov\n"
+	        "                       * Note: gives a fast-start file written in a single pass if the moov fits\n"
 	        " -frag time_in_ms     fragments file (track fragments of time_in_ms)\n"
 	        "                       * Note: Always disables interleaving\n"
 	        " -out filename        specifies output file name\n"
@@ -375,6 +380,7 @@ void PrintDASHUsage()
 	        " -ast-offset TIME     specifies MPD AvailabilityStartTime offset in ms if positive, or availabilityTimeOffset of each representation if negative. Default is 0 sec delay\n"
 	        " -dash-scale SCALE    specifies that timing for -dash and -frag are expressed in SCALE units per seconds\n"
 	        " -mem-frags           fragments will be produced in memory rather than on disk before flushing to disk\n"
+	        " -dash-threads N      segments up to N representations of an adaptation set in parallel (default 1). Ignored with -dash-ctx\n"
 	        " -pssh-moof           stores PSSH boxes in first moof of each segments. By default PSSH are stored in movie box.\n"
 	        " -sample-groups-traf  stores sample group descriptions in traf (duplicated for each traf) rather than in moof. By default sample group descriptions are stored in movie box.\n"
 
@@ -395,6 +401,9 @@ void PrintDASHUsage()
 	        " -single-traf         uses a single track fragment per moof (smooth streaming and derived specs may require this)\n"
 	        " -dash-ts-prog N      program_number to be considered in case of an MPTS input file.\n"
 	        " -frag-rt             when using fragments in live mode, flush fragments according to their timing (only supported with a single input).\n"
+	        " -chunk-dur DUR       low-latency chunked mode: segments are written as moof/mdat chunks of DUR (in SCALE units, cf -dash-scale) flushed\n"
+	        "                       as soon as completed, and are announced with availabilityTimeOffset in the MPD. Disables SIDX.\n"
+	        "                       Chunks are logged at info level of the dash tool\n"
 	        " -cp-location=MODE    sets ContentProtection element location. Possible values for mode are:\n"
 	        "                        as: sets ContentProtection in AdaptationSet element\n"
 	        "                        rep: sets ContentProtection in Representation element\n"
@@ -728,6 +737,7 @@ void PrintDumpUsage()
 	        " -drtp                rtp hint samples structure to XML output\n"
 	        " -dts                 prints sample timing to text output\n"
 	        " -dnal trackID        prints NAL sample info of given track\n"
+	        " -dpush size          prints sample timing and CRC of a fragmented file parsed in push mode by chunks of size bytes\n"
 	        " -sdp                 dumps SDP description of hinted file\n"
 	        " -dcr                 ISMACryp samples structure to XML output\n"
 	        " -dump-cover          Extracts cover art\n"
@@ -1737,6 +1747,11 @@ static GF_Err hash_file(char *name, u32 dump_std)
 Bool log_sys_clock = GF_FALSE;
 Bool log_utc_time = GF_FALSE;
 
+static void on_dash_chunk(void *udta, const char *segment_name, u64 offset, u64 size, Bool last_chunk)
+{
+	GF_LOG(GF_LOG_INFO, GF_LOG_DASH, ("[DASH] Chunk "LLU"-"LLU" of %s written%s\n", offset, offset+size, segment_name, last_chunk ? " - segment done" : ""));
+}
+
 static void on_gpac_log(void *cbk, GF_LOG_Level ll, GF_LOG_Tool lm, const char *fmt, va_list list)
 {
 	FILE *logs = cbk;
@@ -1772,7 +1787,7 @@ s32 subsegs_per_sidx;
 u32 *brand_add = NULL;
 u32 *brand_rem = NULL;
 GF_DashSwitchingMode bitstream_switching_mode = GF_DASH_BSMODE_DEFAULT;
-u32 i, stat_level, hint_flags, info_track_id, import_flags, nb_add, nb_cat, crypt, agg_samples, nb_sdp_ex, max_ptime, raw_sample_num, split_size, nb_meta_act, nb_track_act, rtp_rate, major_brand, nb_alt_brand_add, nb_alt_brand_rem, old_interleave, car_dur, minor_version, conv_type, nb_tsel_acts, program_number, dump_nal, time_shift_depth, initial_moof_sn, dump_std, import_subtitle;
+u32 i, stat_level, hint_flags, info_track_id, import_flags, nb_add, nb_cat, crypt, agg_samples, nb_sdp_ex, max_ptime, raw_sample_num, split_size, nb_meta_act, nb_track_act, rtp_rate, major_brand, nb_alt_brand_add, nb_alt_brand_rem, old_interleave, car_dur, minor_version, conv_type, nb_tsel_acts, program_number, dump_nal, dump_push, time_shift_depth, initial_moof_sn, dump_std, import_subtitle;
 GF_DashDynamicMode dash_mode=GF_DASH_STATIC;
 #ifndef GPAC_DISABLE_SCENE_DUMP
 GF_SceneDumpFormat dump_mode;
@@ -1826,6 +1841,8 @@ Bool segment_timeline = GF_FALSE;
 u32 segment_marker = GF_FALSE;
 GF_DashProfile dash_profile = GF_DASH_PROFILE_UNKNOWN;
 const char *dash_profile_extension = NULL;
+u32 dash_threads = 0;
+u32 chunk_duration = 0;
 Bool use_url_template = GF_FALSE;
 Bool seg_at_rap = GF_FALSE;
 Bool frag_at_rap = GF_FALSE;
@@ -1833,6 +1850,7 @@ Bool adjust_split_end = GF_FALSE;
 Bool memory_frags = GF_TRUE;
 Bool keep_utc = GF_FALSE;
 u32 timescale = 0;
+u32 moov_reserve = 0;
 const char *do_wget = NULL;
 GF_DashSegmenterInput *dash_inputs = NULL;
 u32 nb_dash_inputs = 0;
@@ -2066,6 +2084,11 @@ u32 mp4box_parse_args_continue(int argc, char **argv, u32 *current_index)
 			open_edit = GF_TRUE;
 			do_flat = GF_TRUE;
 		}
+		else if (!stricmp(arg, "-moov-reserve")) {
+			CHECK_NEXT_ARG
+			moov_reserve = atoi(argv[i + 1]);
+			i++;
+		}
 		else if (!stricmp(arg, "-keep-utc")) keep_utc = GF_TRUE;
 		else if (!stricmp(arg, "-new")) force_new = GF_TRUE;
 		else if (!stricmp(arg, "-timescale")) {
@@ -2957,6 +2980,11 @@ Bool mp4box_parse_args(int argc, char **argv)
 			dump_nal = atoi(argv[i + 1]);
 			i++;
 		}
+		else if (!stricmp(arg, "-dpush")) {
+			CHECK_NEXT_ARG
+			dump_push = atoi(argv[i + 1]);
+			i++;
+		}
 		else if (!stricmp(arg, "-dcr")) dump_cr = 1;
 		else if (!stricmp(arg, "-ttxt") || !stricmp(arg, "-srt")) {
 			if ((i + 1<(u32)argc) && (sscanf(argv[i + 1], "%u", &trackID) == 1)) {
@@ -3115,6 +3143,16 @@ Bool mp4box_parse_args(int argc, char **argv)
 			}
 			i++;
 		}
+		else if (!stricmp(arg, "-dash-threads")) {
+			CHECK_NEXT_ARG
+			dash_threads = atoi(argv[i + 1]);
+			i++;
+		}
+		else if (!stricmp(arg, "-chunk-dur")) {
+			CHECK_NEXT_ARG
+			chunk_duration = atoi(argv[i + 1]);
+			i++;
+		}
 		else if (!stricmp(arg, "-dash-ts-prog")) {
 			CHECK_NEXT_ARG
 			program_number = atoi(argv[i + 1]);
@@ -3321,7 +3359,7 @@ int mp4boxMain(int argc, char **argv)
 	import_flags = 0;
 	split_size = 0;
 	movie_time = 0;
-	dump_nal = 0;
+	dump_nal = dump_push = 0;
 	FullInter = HintInter = encode = do_log = old_interleave = do_saf = do_hash = verbose = GF_FALSE;
 #ifndef GPAC_DISABLE_SCENE_DUMP
 	dump_mode = GF_SM_DUMP_NONE;
@@ -3658,6 +3696,8 @@ int mp4boxMain(int argc, char **argv)
 			fprintf(stderr, "Cannot open destination file %s: %s\n", inName, gf_error_to_string(gf_isom_last_error(NULL)) );
 			return mp4box_cleanup(1);
 		}
+		if (moov_reserve && (open_mode == GF_ISOM_OPEN_WRITE))
+			gf_isom_reserve_moov_space(file, moov_reserve*1024);
 
 		for (i=0; i<(u32) argc; i++) {
 			if (!strcmp(argv[i], "-add")) {
@@ -3719,6 +3759,8 @@ int mp4boxMain(int argc, char **argv)
 				fprintf(stderr, "Cannot open destination file %s: %s\n", inName, gf_error_to_string(gf_isom_last_error(NULL)) );
 				return mp4box_cleanup(1);
 			}
+			if (moov_reserve && (open_mode == GF_ISOM_OPEN_WRITE))
+				gf_isom_reserve_moov_space(file, moov_reserve*1024);
 		}
 		for (i=0; i<(u32)argc; i++) {
 			if (!strcmp(argv[i], "-cat") || !strcmp(argv[i], "-catx")) {
@@ -3898,8 +3940,10 @@ int mp4boxMain(int argc, char **argv)
 		if (!e) e = gf_dasher_configure_isobmf_default(dasher, no_fragments_defaults, pssh_in_moof, samplegroups_in_traf, single_traf_per_moof);
 		if (!e) e = gf_dasher_enable_utc_ref(dasher, insert_utc);
 		if (!e) e = gf_dasher_enable_real_time(dasher, frag_real_time);
+		if (!e) e = gf_dasher_enable_chunked_mode(dasher, ((Double) chunk_duration) / dash_scale, on_dash_chunk, NULL);
 		if (!e) e = gf_dasher_set_content_protection_location_mode(dasher, cp_location_mode);
 		if (!e) e = gf_dasher_set_profile_extension(dasher, dash_profile_extension);
+		if (!e) e = gf_dasher_set_thread_count(dasher, dash_threads);
 
 		for (i=0; i < nb_dash_inputs; i++) {
 			if (!e) e = gf_dasher_add_input(dasher, &dash_inputs[i]);
@@ -4215,6 +4259,9 @@ int mp4boxMain(int argc, char **argv)
 
 	if (dump_timestamps) dump_isom_timestamps(file, dump_std ? NULL : (outName ? outName : outfile), outName ? GF_TRUE : GF_FALSE);
 	if (dump_nal) dump_isom_nal(file, dump_nal, dump_std ? NULL : (outName ? outName : outfile), outName ? GF_TRUE : GF_FALSE);
+#ifndef GPAC_DISABLE_ISOM_FRAGMENTS
+	if (dump_push) dump_isom_push(inName, dump_push, dump_std ? NULL : (outName ? outName : outfile), outName ? GF_TRUE : GF_FALSE);
+#endif
 
 	if (do_hash) {
 		e = hash_file(inName, dump_std);
@@ -632,7 +632,8 @@ void avi_audio_frame(void *udta, char *buffer, u32 buffer_size, u32 time, u32 de
 	gf_mx_p(avil->mx);
 
 	if (!avil->time_scale) {
-		AVI_set_audio(avil->avi, avil->nb_channel, avil->samplerate, avil->bits_per_sample, WAVE_FORMAT_PCM, 0);
+		/*the mixer outputs float samples when configured with 32 bits per sample*/
+		AVI_set_audio(avil->avi, avil->nb_channel, avil->samplerate, avil->bits_per_sample, (avil->bits_per_sample==32) ? WAVE_FORMAT_IEEE_FLOAT : WAVE_FORMAT_PCM, 0);
 		avil->time_scale = avil->nb_channel*avil->bits_per_sample*avil->samplerate/8;
 		gf_term_set_option(term, GF_OPT_FORCE_AUDIO_CONFIG, 1);
 	}
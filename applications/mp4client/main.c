@@ -252,6 +252,8 @@ void PrintUsage()
 	        "\t-speed S:       starts with speed S\n"
 	        "\t-loop:          loops presentation\n"
 	        "\t-no-regulation: disables framerate regulation\n"
+	        "\t-offline:       renders with a virtual clock advanced by one frame per composition, without threads and audio\n"
+	        "\t                 (as fast as possible, identical output for each run)\n"
 	        "\t-bench:         disable a/v output and bench source decoding (as fast as possible)\n"
 	        "\t-vbench:        disable audio output, video sync bench source decoding/display (as fast as possible)\n"
 	        "\t-sbench:        disable all decoders and bench systems layer (as fast as possible)\n"
@@ -1251,6 +1253,10 @@ int mp4client_main(int argc, char **argv)
 		else if (!strcmp(arg, "-no-compositor-thread")) threading_flags |= GF_TERM_NO_COMPOSITOR_THREAD;
 		else if (!strcmp(arg, "-no-audio")) no_audio = 1;
 		else if (!strcmp(arg, "-no-regulation")) no_regulation = 1;
+		else if (!strcmp(arg, "-offline")) {
+			threading_flags |= GF_TERM_USE_VIRTUAL_CLOCK | GF_TERM_NO_DECODER_THREAD | GF_TERM_NO_COMPOSITOR_THREAD;
+			no_audio = 1;
+		}
 		else if (!strcmp(arg, "-fs")) start_fs = 1;
 
 		else if (!strcmp(arg, "-opt")) {
@@ -0,0 +1,145 @@
+/*
+ *			GPAC - Multimedia Framework C SDK
+ *
+ *			Authors: Jean Le Feuvre
+ *			Copyright (c) Telecom ParisTech 2016
+ *					All rights reserved
+ *
+ *  This file is part of GPAC - color conversion benchmark
+ *
+ *  GPAC is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  GPAC is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; see the file COPYING.  If not, write to
+ *  the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+ *
+ */
+
+#include <gpac/tools.h>
+#include <gpac/constants.h>
+#include <gpac/color.h>
+
+/*times gf_stretch_bits for the YUV source formats used by video texturing, and prints a checksum of the
+output so that results of different builds (e.g. with and without SIMD) can be compared*/
+
+static u32 src_formats[] = {GF_PIXEL_YV12, GF_PIXEL_YV12_10, GF_PIXEL_YUY2, GF_PIXEL_NV21, GF_PIXEL_YUVA};
+static u32 dst_formats[] = {GF_PIXEL_RGB_32, GF_PIXEL_BGR_32, GF_PIXEL_ARGB};
+
+static void usage()
+{
+	fprintf(stderr, "usage: colorbench [-w width] [-h height] [-n nb_frames]\n"
+	        "\tconverts nb_frames random frames of width x height (default 1920x1080, 50 frames)\n"
+	        "\tfrom each YUV format to each RGB format, unscaled and scaled to 2/3 of the size\n");
+}
+
+static void fill_random(u8 *data, u32 size, Bool is_10)
+{
+	u32 i;
+	if (is_10) {
+		u16 *d = (u16 *) data;
+		for (i=0; i<size/2; i++) d[i] = (u16) (gf_rand() & 0x3FF);
+	} else {
+		for (i=0; i<size; i++) data[i] = (u8) gf_rand();
+	}
+}
+
+static u32 checksum(u8 *data, u32 size)
+{
+	u32 i, crc = 0;
+	for (i=0; i<size; i++) crc = crc*31 + data[i];
+	return crc;
+}
+
+int main(int argc, char **argv)
+{
+	u32 i, j, k, scale, width=1920, height=1080, nb_frames=50;
+	u32 src_size, src_pitch;
+	u8 *src_data, *dst_data;
+
+	for (i=1; i<(u32) argc; i++) {
+		if (!strcmp(argv[i], "-w") && (i+1<(u32) argc)) width = atoi(argv[++i]);
+		else if (!strcmp(argv[i], "-h") && (i+1<(u32) argc)) height = atoi(argv[++i]);
+		else if (!strcmp(argv[i], "-n") && (i+1<(u32) argc)) nb_frames = atoi(argv[++i]);
+		else {
+			usage();
+			return 1;
+		}
+	}
+	if (!width || !height || (width%2) || (height%2)) {
+		usage();
+		return 1;
+	}
+
+	gf_sys_init(GF_MemTrackerNone);
+	gf_rand_init(GF_TRUE);
+	/*worst case: YUVA or 10 bit 4:2:0*/
+	src_data = (u8 *) gf_malloc(sizeof(u8) * width * height * 3);
+	dst_data = (u8 *) gf_malloc(sizeof(u8) * width * height * 4);
+
+	for (i=0; i<sizeof(src_formats)/sizeof(u32); i++) {
+		GF_VideoSurface src;
+		memset(&src, 0, sizeof(GF_VideoSurface));
+		src.width = width;
+		src.height = height;
+		src.pixel_format = src_formats[i];
+		switch (src.pixel_format) {
+		case GF_PIXEL_YV12_10:
+			src_pitch = 2*width;
+			src_size = 3*width*height;
+			break;
+		case GF_PIXEL_YUY2:
+			src_pitch = 2*width;
+			src_size = 2*width*height;
+			break;
+		case GF_PIXEL_YUVA:
+			src_pitch = width;
+			src_size = 5*width*height/2;
+			break;
+		default:
+			src_pitch = width;
+			src_size = 3*width*height/2;
+			break;
+		}
+		src.pitch_y = src_pitch;
+		src.video_buffer = (char *) src_data;
+		fill_random(src_data, src_size, (src.pixel_format==GF_PIXEL_YV12_10) ? GF_TRUE : GF_FALSE);
+
+		for (j=0; j<sizeof(dst_formats)/sizeof(u32); j++) {
+			for (scale=0; scale<2; scale++) {
+				GF_VideoSurface dst;
+				u64 start, time;
+				char src_name[5];
+				memset(&dst, 0, sizeof(GF_VideoSurface));
+				dst.width = scale ? 2*width/3 : width;
+				dst.height = scale ? 2*height/3 : height;
+				dst.pitch_x = 4;
+				dst.pitch_y = 4*dst.width;
+				dst.pixel_format = dst_formats[j];
+				dst.video_buffer = (char *) dst_data;
+				memset(dst_data, 0, 4*dst.width*dst.height);
+
+				start = gf_sys_clock_high_res();
+				for (k=0; k<nb_frames; k++) {
+					gf_stretch_bits(&dst, &src, NULL, NULL, 0xFF, GF_FALSE, NULL, NULL);
+				}
+				time = gf_sys_clock_high_res() - start;
+				/*gf_4cc_to_str uses a static buffer*/
+				strcpy(src_name, gf_4cc_to_str(src.pixel_format));
+				fprintf(stdout, "%s -> %s %dx%d: %.2f ms/frame - checksum %08X\n", src_name, gf_4cc_to_str(dst.pixel_format), dst.width, dst.height,
+				        ((Double) (s64) time) / 1000 / nb_frames, checksum(dst_data, 4*dst.width*dst.height));
+			}
+		}
+	}
+	gf_free(src_data);
+	gf_free(dst_data);
+	gf_sys_close();
+	return 0;
+}
@@ -0,0 +1,11 @@
+/* Automatically generated by configure */
+#ifndef GF_CONFIG_H
+#define GF_CONFIG_H
+#define GPAC_CONFIGURATION "--disable-ssl --disable-x11 --disable-alsa --disable-pulseaudio --disable-jack --disable-oss-audio --disable-wx --disable-platinum"
+#define GPAC_CONFIG_LINUX
+#define GPAC_HAS_JPEG
+#define GPAC_HAS_PNG
+#define GPAC_HAS_IPV6
+#define GPAC_64_BITS
+#define GPAC_HAS_LINUX_DVB
+#endif
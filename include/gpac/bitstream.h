@@ -527,6 +527,18 @@ void gf_bs_flush(GF_BitStream *bs);
  */
 void gf_bs_reassign(GF_BitStream *bs, FILE *stream);
 
+/*!
+ *\brief Copies a file range into a bitstream
+ *
+ *Copies a byte range of a file at the current position of a file-based bitstream in write mode, letting the kernel move the data when supported (see \ref gf_fcopy_range). The bitstream must be byte-aligned.
+ *\param bs the target bitstream
+ *\param src the source file
+ *\param offset offset of the data in the source file
+ *\param size number of bytes to copy
+ *\return number of bytes copied. If less than size, the remaining bytes have to be written by the caller
+ */
+u64 gf_bs_write_file_range(GF_BitStream *bs, FILE *src, u64 offset, u64 size);
+
 /*! @} */
 
 #ifdef __cplusplus
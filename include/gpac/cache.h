@@ -238,6 +238,9 @@ u64 gf_cache_get_end_range( const DownloadedCacheEntry entry );
 Bool gf_cache_are_headers_processed(const DownloadedCacheEntry entry);
 GF_Err gf_cache_set_headers_processed(const DownloadedCacheEntry entry);
 
+/*returns the amount of memory allocated by a memory-stored entry, 0 for entries stored on disk*/
+u32 gf_cache_get_memory_size(const DownloadedCacheEntry entry);
+
 /*! @} */
 
 #ifdef __cplusplus
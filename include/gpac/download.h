@@ -542,6 +542,18 @@ u32 gf_dm_get_data_rate(GF_DownloadManager *dm);
  */
 u32 gf_dm_get_global_rate(GF_DownloadManager *dm);
 
+/*
+ *\brief gets connection pool statistics
+ *
+ *Connections are kept alive once a response has been entirely received, and reused by any session of the download manager requesting the same server.
+ *\param dm the download manager object
+ *\param nb_created set to the number of TCP connections established so far (optional)
+ *\param nb_reused set to the number of requests sent on a reused connection so far (optional)
+ *\param nb_idle set to the number of connections currently idle in the pool (optional)
+ *\return error if any
+ */
+GF_Err gf_dm_get_connection_pool_stats(GF_DownloadManager *dm, u32 *nb_created, u32 *nb_reused, u32 *nb_idle);
+
 
 /*
  *\brief fetches remote file in memory
@@ -290,6 +290,7 @@ typedef struct
 #define WAVE_FORMAT_PCM                 (0x0001)
 #endif
 #define WAVE_FORMAT_ADPCM               (0x0002)
+#define WAVE_FORMAT_IEEE_FLOAT          (0x0003)
 #define WAVE_FORMAT_IBM_CVSD            (0x0005)
 #define WAVE_FORMAT_ALAW                (0x0006)
 #define WAVE_FORMAT_MULAW               (0x0007)
@@ -216,6 +216,10 @@ struct __tag_compositor
 	Bool text_edit_changed;
 	//sampled value of audio clock used in bench mode only
 	u32 scene_sampled_clock;
+	//virtual clock mode: time base is virtual_clock_base + virtual_frames frames at the current frame rate
+	Bool virtual_clock;
+	u32 virtual_clock_base;
+	u64 virtual_frames;
 	u32 last_click_time;
 	s32 ms_until_next_frame;
 	s32 frame_delay;
@@ -967,7 +971,7 @@ struct _traversing_state
 };
 
 /*
-	Audio mixer - MAX 6 CHANNELS SUPPORTED
+	Audio mixer - up to 7.1 channel layouts, 8/16 bits integer or 32 bits float samples
 */
 
 /*the audio object as used by the mixer. All audio nodes need to implement this interface*/
@@ -980,7 +984,8 @@ typedef struct _audiointerface
 	void (*ReleaseFrame) (void *callback, u32 nb_bytes);
 	/*get media speed*/
 	Fixed (*GetSpeed)(void *callback);
-	/*gets volume for each channel - vol = Fixed[6]. returns 1 if volume shall be changed (!= 1.0)*/
+	/*gets volume for each channel - vol = Fixed[6]. returns 1 if volume shall be changed (!= 1.0)
+	the mixer uses the back channels volume for any extra channel (7.1)*/
 	Bool (*GetChannelVolume)(void *callback, Fixed *vol);
 	/*returns 1 if muted*/
 	Bool (*IsMuted)(void *callback);
@@ -990,7 +995,7 @@ typedef struct _audiointerface
 	otherwise AND IF @for_reconf is set, updates member var below and return TRUE
 	You may return 0 to force parent user invalidation*/
 	Bool (*GetConfig)(struct _audiointerface *ai, Bool for_reconf);
-	/*updated cfg, or 0 otherwise*/
+	/*updated cfg, or 0 otherwise - bps is 8, 16 or 32 for float samples*/
 	u32 chan, bps, samplerate, ch_cfg;
 } GF_AudioInterface;
 
@@ -1017,6 +1022,8 @@ Bool gf_mixer_is_src_present(GF_AudioMixer *am, GF_AudioInterface *ifce);
 u32 gf_mixer_get_src_count(GF_AudioMixer *am);
 void gf_mixer_force_chanel_out(GF_AudioMixer *am, u32 num_channels);
 u32 gf_mixer_get_block_align(GF_AudioMixer *am);
+/*sets resampling mode - if polyphase is set, inputs are resampled with a windowed-sinc polyphase filter rather than linear interpolation*/
+void gf_mixer_set_polyphase_resampling(GF_AudioMixer *am, Bool polyphase);
 Bool gf_mixer_must_reconfig(GF_AudioMixer *am);
 Bool gf_mixer_empty(GF_AudioMixer *am);
 
@@ -1057,6 +1064,8 @@ typedef struct _audio_render
 
 	Bool disable_resync;
 	Bool disable_multichannel;
+	/*use polyphase filtering rather than linear interpolation when resampling*/
+	Bool polyphase_resampling;
 	Bool clock_use_audio_out;
 
 	/*frozen time counter if set*/
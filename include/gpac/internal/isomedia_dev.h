@@ -982,6 +982,8 @@ typedef struct
 
 Bool gf_isom_is_nalu_based_entry(GF_MediaBox *mdia, GF_SampleEntryBox *_entry);
 GF_Err gf_isom_nalu_sample_rewrite(GF_MediaBox *mdia, GF_ISOSample *sample, u32 sampleNumber, GF_MPEGVisualSampleEntryBox *entry);
+/*returns GF_TRUE if gf_isom_nalu_sample_rewrite may modify the sample payload for this entry, GF_FALSE if it only inspects it*/
+Bool gf_isom_nalu_sample_rewrite_needed(GF_MediaBox *mdia, GF_MPEGVisualSampleEntryBox *entry);
 
 /*this is the default visual sdst (to handle unknown media)*/
 typedef struct
@@ -1286,6 +1288,43 @@ typedef struct
 } GF_SampleAuxiliaryInfoOffsetBox;
 
 
+/*number of samples sharing the same base offset and DTS in the sample index*/
+#define GF_ISOM_SAMPLE_INDEX_BLOCK	64
+
+typedef struct
+{
+	/*smallest data offset and DTS of the samples in the block*/
+	u64 offset, DTS;
+	/*chunk of the first sample in the block*/
+	u32 chunk;
+} GF_SampleIndexBlock;
+
+typedef struct
+{
+	/*offset and DTS relative to the block ones*/
+	u32 offset_delta, dts_delta;
+	s32 CTS_Offset;
+	/*chunk relative to the block one*/
+	u16 chunk_delta;
+	/*sample description index in the lower 15 bits, sync flag in the upper bit*/
+	u16 desc_sync;
+} GF_SampleIndexEntry;
+
+/*random access index of a sample table, built from stts/ctts/stsc/stco/stss when samples are not accessed in sequence.
+Only used for read-only sample tables*/
+typedef struct
+{
+	/*set if building the index failed (unsupported table layout), regular table lookup is then always used*/
+	Bool failed;
+	/*last sample number accessed while the index is not yet built*/
+	u32 last_sample;
+	u32 nb_samples;
+	/*duration of the last sample*/
+	u32 last_duration;
+	GF_SampleIndexBlock *blocks;
+	GF_SampleIndexEntry *samples;
+} GF_SampleIndex;
+
 typedef struct
 {
 	GF_ISOM_BOX
@@ -1323,6 +1362,9 @@ typedef struct
 	u32 currentEntryIndex;
 
 	Bool no_sync_found;
+
+	/*random access index, NULL if not enabled*/
+	GF_SampleIndex *sample_index;
 } GF_SampleTableBox;
 
 typedef struct __tag_media_info_box
@@ -1819,6 +1861,17 @@ enum
 	GF_ISOM_TRUN_CTS_OFFSET		= 0x800
 };
 
+typedef struct
+{
+	u32 Duration;
+	u32 size;
+	u32 flags;
+	s32 CTS_Offset;
+
+	/*internal*/
+	u32 SAP_type;
+} GF_TrunEntry;
+
 typedef struct
 {
 	GF_ISOM_FULL_BOX
@@ -1828,22 +1881,14 @@ typedef struct
 	u32 first_sample_flags;
 	/*can be empty*/
 	GF_List *entries;
+	/*entries parsed from file are allocated in a single block, the list only points into it*/
+	GF_TrunEntry *entries_block;
+	u32 entries_block_count;
 
 	/*in write mode with data caching*/
 	GF_BitStream *cache;
 } GF_TrackFragmentRunBox;
 
-typedef struct
-{
-	u32 Duration;
-	u32 size;
-	u32 flags;
-	s32 CTS_Offset;
-
-	/*internal*/
-	u32 SAP_type;
-} GF_TrunEntry;
-
 typedef struct
 {
 	GF_ISOM_BOX
@@ -2588,6 +2633,8 @@ typedef struct {
 #define GF_ISOM_DATA_FILE_MAPPING		0x02
 /*External file object. Needs implementation*/
 #define GF_ISOM_DATA_FILE_EXTERN		0x03
+/*Memory object, data is pushed by the user (push mode)*/
+#define GF_ISOM_DATA_MEM				0x04
 
 /*Data Map modes*/
 enum
@@ -2604,6 +2651,9 @@ enum
 	GF_ISOM_DATA_MAP_READ_ONLY = 4,
 	/*write-only access at the end of the movie - only used for movie fragments concatenation*/
 	GF_ISOM_DATA_MAP_CAT = 5,
+	/*read-only access to a complete local file through a file mapping object when supported by the platform,
+	mode is set to GF_ISOM_DATA_MAP_READ afterwards*/
+	GF_ISOM_DATA_MAP_READ_MAPPED = 6,
 };
 
 /*this is the DataHandler structure each data handler has its own bitstream*/
@@ -2640,12 +2690,27 @@ typedef struct
 	u64 byte_pos;
 } GF_FileMappingDataMap;
 
+/*memory handler, used in push mode. Data is appended by the user and may be discarded once consumed*/
+typedef struct
+{
+	GF_ISOM_BASE_DATA_HANDLER
+	char *buffer;
+	u32 size, alloc;
+} GF_MemDataMap;
+
 GF_Err gf_isom_datamap_new(const char *location, const char *parentPath, u8 mode, GF_DataMap **outDataMap);
 void gf_isom_datamap_del(GF_DataMap *ptr);
 GF_Err gf_isom_datamap_open(GF_MediaBox *minf, u32 dataRefIndex, u8 Edit);
 void gf_isom_datamap_close(GF_MediaInformationBox *minf);
 u32 gf_isom_datamap_get_data(GF_DataMap *map, char *buffer, u32 bufferLength, u64 Offset);
 
+/*Memory-based data map*/
+GF_DataMap *gf_isom_mdm_new();
+void gf_isom_mdm_del(GF_MemDataMap *ptr);
+u32 gf_isom_mdm_get_data(GF_MemDataMap *ptr, char *buffer, u32 bufferLength, u64 offset);
+GF_Err gf_isom_mdm_append(GF_MemDataMap *ptr, const char *data, u32 size);
+GF_Err gf_isom_mdm_discard(GF_MemDataMap *ptr, u32 nb_bytes);
+
 /*File-based data map*/
 GF_DataMap *gf_isom_fdm_new(const char *sPath, u8 mode);
 void gf_isom_fdm_del(GF_FileDataMap *ptr);
@@ -2659,10 +2724,16 @@ GF_DataMap *gf_isom_fdm_new_temp(const char *sTempPath);
 GF_DataMap *gf_isom_fmo_new(const char *sPath, u8 mode);
 void gf_isom_fmo_del(GF_FileMappingDataMap *ptr);
 u32 gf_isom_fmo_get_data(GF_FileMappingDataMap *ptr, char *buffer, u32 bufferLength, u64 fileOffset);
+/*returns a read-only pointer to the given range of a file mapping data map, or NULL if the map is not a file mapping
+or the range is not available*/
+const char *gf_isom_datamap_get_mapped_data(GF_DataMap *map, u32 size, u64 offset);
 
 #ifndef GPAC_DISABLE_ISOM_WRITE
 u64 gf_isom_datamap_get_offset(GF_DataMap *map);
 GF_Err gf_isom_datamap_add_data(GF_DataMap *ptr, char *data, u32 dataSize);
+/*copies size bytes at offset in the data map to the bitstream, using kernel copy when both ends are local files and
+the given buffer otherwise*/
+GF_Err gf_isom_datamap_copy_data(GF_DataMap *map, u64 offset, u64 size, GF_BitStream *bs, char *buffer, u32 buffer_size);
 #endif
 
 void gf_isom_datamap_flush(GF_DataMap *map);
@@ -2729,6 +2800,11 @@ struct __tag_isom {
 	u8 is_dump_mode;
 
 	Bool keep_utc, drop_date_version_info;
+#ifndef GPAC_DISABLE_ISOM_WRITE
+	/*capture mode only: size and position of the space reserved before the media data to write the moov in place*/
+	u32 moov_reserved_size;
+	u64 moov_reserved_offset;
+#endif
 	/*main boxes for fast access*/
 	/*moov*/
 	GF_MovieBox *moov;
@@ -2752,6 +2828,9 @@ struct __tag_isom {
 
 	GF_List *moof_list;
 	Bool use_segments, moof_first, append_segment, styp_written;
+	/*moof_first fragments only: size and position of the space reserved before the mdat of the current fragment*/
+	u32 moof_reserved_size;
+	u64 moof_reserved_offset;
 
 	/*used when building single-indexed self initializing media segments*/
 	GF_SegmentIndexBox *root_sidx;
@@ -2764,6 +2843,12 @@ struct __tag_isom {
 	/* 0: no moof found yet, 1: 1 moof found, 2: next moof found */
 	Bool single_moof_mode;
 	u32 single_moof_state;
+
+	/*push mode: called for each top-level box once parsed*/
+	void (*on_top_box)(void *udta, u32 box_type, u64 box_start, u64 box_size);
+	void *on_top_box_udta;
+	/*push mode: number of bytes released since the start of the stream*/
+	u64 push_discarded_bytes;
 #endif
 	GF_ProducerReferenceTimeBox *last_producer_ref_time;
 
@@ -2807,7 +2892,9 @@ Bool IsMP4Description(u32 entryType);
 GF_Err Track_FindRef(GF_TrackBox *trak, u32 ReferenceType, GF_TrackReferenceTypeBox **dpnd);
 /*Time and sample*/
 GF_Err GetMediaTime(GF_TrackBox *trak, Bool force_non_empty, u64 movieTime, u64 *MediaTime, s64 *SegmentStartTime, s64 *MediaOffset, u8 *useEdit, u64 *next_edit_start_plus_one);
-GF_Err Media_GetSample(GF_MediaBox *mdia, u32 sampleNumber, GF_ISOSample **samp, u32 *sampleDescriptionIndex, Bool no_data, u64 *out_offset);
+/*if static_sample is set, the sample object is reused by the caller: its data buffer is reallocated only when too small
+and payload may be borrowed from a file mapping data map*/
+GF_Err Media_GetSample(GF_MediaBox *mdia, u32 sampleNumber, GF_ISOSample **samp, u32 *sampleDescriptionIndex, Bool no_data, u64 *out_offset, Bool static_sample);
 GF_Err Media_CheckDataEntry(GF_MediaBox *mdia, u32 dataEntryIndex);
 GF_Err Media_FindSyncSample(GF_SampleTableBox *stbl, u32 searchFromTime, u32 *sampleNumber, u8 mode);
 GF_Err Media_RewriteODFrame(GF_MediaBox *mdia, GF_ISOSample *sample);
@@ -2835,6 +2922,14 @@ GF_Err stbl_GetSampleRAP(GF_SyncSampleBox *stss, u32 SampleNumber, SAPType *IsRA
 GF_Err stbl_SearchSAPs(GF_SampleTableBox *stbl, u32 SampleNumber, SAPType *IsRAP, u32 *prevRAP, u32 *nextRAP);
 GF_Err stbl_GetSampleInfos(GF_SampleTableBox *stbl, u32 sampleNumber, u64 *offset, u32 *chunkNumber, u32 *descIndex, u8 *isEdited);
 GF_Err stbl_GetSampleShadow(GF_ShadowSyncBox *stsh, u32 *sampleNumber, u32 *syncNum);
+
+/*sample index*/
+void stbl_SetSampleIndex(GF_SampleTableBox *stbl, Bool enable);
+/*checks if the sample index can be used for the given sample, building it if needed. The index is built on the first
+non-sequential access, or right away if is_seek is set*/
+Bool stbl_UseSampleIndex(GF_SampleTableBox *stbl, u32 sampleNumber, Bool is_seek);
+void stbl_GetIndexedSample(GF_SampleTableBox *stbl, u32 sampleNumber, u64 *DTS, s32 *CTS_Offset, SAPType *IsRAP, u64 *offset, u32 *chunkNumber, u32 *descIndex);
+u32 stbl_GetIndexedSampleDuration(GF_SampleTableBox *stbl, u32 sampleNumber);
 GF_Err stbl_GetPaddingBits(GF_PaddingBitsBox *padb, u32 SampleNumber, u8 *PadBits);
 u32 stbl_GetSampleFragmentCount(GF_SampleFragmentBox *stsf, u32 sampleNumber);
 u32 stbl_GetSampleFragmentSize(GF_SampleFragmentBox *stsf, u32 sampleNumber, u32 FragmentIndex);
@@ -2857,6 +2952,8 @@ GF_UserDataMap *udta_getEntry(GF_UserDataBox *ptr, u32 box_type, bin128 *uuid);
 #ifndef GPAC_DISABLE_ISOM_WRITE
 
 GF_Err FlushCaptureMode(GF_ISOFile *movie);
+GF_Err gf_isom_write_free_box(GF_BitStream *bs, u32 size);
+GF_Err gf_isom_set_reserved_space(GF_ISOFile *movie, u32 *reserved_size, u32 size);
 GF_Err CanAccessMovie(GF_ISOFile *movie, u32 Mode);
 GF_ISOFile *gf_isom_create_movie(const char *fileName, u32 OpenMode, const char *tmp_dir);
 void gf_isom_insert_moov(GF_ISOFile *file);
@@ -47,6 +47,7 @@ typedef struct _object_clock GF_Clock;
 typedef struct _es_channel GF_Channel;
 typedef struct _generic_codec GF_Codec;
 typedef struct _composition_memory GF_CompositionMemory;
+typedef struct _frame_pool GF_FramePool;
 typedef struct _gf_addon_media GF_AddonMedia;
 
 
@@ -337,6 +338,8 @@ enum
 	GF_TERM_THREAD_SINGLE,
 	/*all media (image, video, audio) decoders are threaded*/
 	GF_TERM_THREAD_MULTI,
+	/*media (video, audio) decoders are scheduled on a fixed pool of worker threads*/
+	GF_TERM_THREAD_POOL,
 };
 
 enum
@@ -346,7 +349,8 @@ enum
 	GF_TERM_SINGLE_THREAD = 1<<22,
 	GF_TERM_MULTI_THREAD = 1<<23,
 	GF_TERM_DROP_LATE_FRAMES = 1<<24,
-	GF_TERM_SINGLE_CLOCK = 1<<25
+	GF_TERM_SINGLE_CLOCK = 1<<25,
+	GF_TERM_POOL_THREAD = 1<<26
 };
 
 /*URI relocators are used for containers like zip or ISO FF with file items. The relocator
@@ -410,6 +414,12 @@ struct _tag_terminal
 	u32 cumulated_priority;
 	/*frame duration*/
 	u32 frame_duration;
+	/*decoder worker pool, only used in GF_TERM_THREAD_POOL mode*/
+	GF_List *mm_workers;
+	/*worker receiving the next started decoder*/
+	u32 mm_next_worker;
+	/*frame buffers released by composition memories, reused across codecs*/
+	GF_FramePool *frame_pool;
 
 	/*net services*/
 	GF_List *net_services;
@@ -656,6 +666,9 @@ struct _es_channel
 	u32 AU_Count;
 	/*decoding buffers for push mode*/
 	struct _decoding_buffer * AU_buffer_first, * AU_buffer_last;
+	/*AUs handed over by the service without locking the channel, most recent first. They are moved
+	to the decoding buffer by the next thread locking the channel*/
+	struct _decoding_buffer * volatile AU_inbox;
 	/*static decoding buffer for pull mode*/
 	struct _decoding_buffer * AU_buffer_pull;
 	char *pull_reaggregated_buffer;
@@ -671,6 +684,8 @@ struct _es_channel
 	u32 last_au_time;
 	/*Current reassembling buffer - currently packets are NOT reordered, only AUs are*/
 	char *buffer;
+	/*protects the reassembling buffer against channel resets - never held while locking the channel*/
+	GF_Mutex *buffer_mx;
 	u32 len, allocSize;
 	/*only for last packet of an AU*/
 	u8 padingBits;
@@ -81,6 +81,10 @@ enum
 	GF_ISOM_WRITE_EDIT,
 	/*Opens an existing file for fragment concatenation*/
 	GF_ISOM_OPEN_CAT_FRAGMENTS,
+
+	/*flag to combine with GF_ISOM_OPEN_READ: the file is mapped in memory when supported by the platform, so that sample
+	payloads can be accessed without copy through gf_isom_get_sample_ex. Only use this for complete local files*/
+	GF_ISOM_OPEN_FILE_MAPPING = 1<<8,
 };
 
 /*Movie Options for file writing*/
@@ -347,6 +351,11 @@ typedef struct
 	/*relative offset for composition if needed*/
 	s32 CTS_Offset;
 	SAPType IsRAP;
+	/*size of the buffer allocated for data when the sample object is reused through gf_isom_get_sample_ex, 0 otherwise*/
+	u32 alloc_size;
+	/*set when data points to memory owned by the file (file mapping) rather than by the sample: data shall not be
+	modified nor freed*/
+	Bool is_borrowed;
 } GF_ISOSample;
 
 
@@ -356,9 +365,13 @@ GF_ISOSample *gf_isom_sample_new();
 /*delete a sample. NOTE:the buffer content will be destroyed by default.
 if you wish to keep the buffer, set dataLength to 0 in the sample
 before deleting it
-the pointer is set to NULL after deletion*/
+the pointer is set to NULL after deletion. Borrowed data (see gf_isom_get_sample_ex) is never destroyed*/
 void gf_isom_sample_del(GF_ISOSample **samp);
 
+/*releases the payload of a sample fetched with gf_isom_get_sample_ex: borrowed data is detached from the sample,
+owned data is kept for the next fetch. The sample object itself is not destroyed*/
+void gf_isom_sample_release(GF_ISOSample *samp);
+
 /********************************************************************
 				GENERAL API FUNCTIONS
 ********************************************************************/
@@ -418,6 +431,28 @@ If the movie is successfully loaded (the_file non-NULL), BytesMissing is zero
 */
 GF_Err gf_isom_open_progressive(const char *fileName, u64 start_range, u64 end_range, GF_ISOFile **the_file, u64 *BytesMissing);
 
+/*opens a movie in push mode: no file or cache is used, the file data is given by the caller
+in chunks of any size (eg as received from the network) through gf_isom_push_data.
+Top-level boxes are parsed as soon as they are complete, movie fragments being merged
+in the sample tables as in progressive mode.
+
+on_top_box: optional callback, called for each top-level box (moov, moof, mdat...) once parsed
+and, for moof, merged. box_start is the position of the box in the push buffer
+udta: opaque data passed to the callback
+*/
+GF_Err gf_isom_open_push(GF_ISOFile **the_file, void (*on_top_box)(void *udta, u32 box_type, u64 box_start, u64 box_size), void *udta);
+
+/*appends data to the push buffer and parses all complete top-level boxes.
+Returns GF_ISOM_INCOMPLETE_FILE if more data is needed, in which case BytesMissing (optional) indicates
+the predicted number of bytes missing to complete the current box (0 if unknown).
+Samples whose data is already pushed may be fetched while their mdat is incomplete*/
+GF_Err gf_isom_push_data(GF_ISOFile *the_file, const char *data, u32 size, u64 *BytesMissing);
+
+/*discards all data of the push buffer up to the box currently being parsed, and resets the sample tables
+of fragmented tracks as done for media segments. Sample numbering and timing continue across releases.
+Call this once all samples of the received fragments have been fetched, to keep memory usage bounded*/
+GF_Err gf_isom_push_release(GF_ISOFile *the_file);
+
 /*If requesting a sample fails with error GF_ISOM_INCOMPLETE_FILE, use this function
 to get the number of bytes missing to retrieve the sample*/
 u64 gf_isom_get_missing_bytes(GF_ISOFile *the_file, u32 trackNumber);
@@ -564,6 +599,21 @@ this index allows to retrieve the stream description if needed (2 media in 1 tra
 return NULL if error*/
 GF_ISOSample *gf_isom_get_sample(GF_ISOFile *the_file, u32 trackNumber, u32 sampleNumber, u32 *StreamDescriptionIndex);
 
+/*same as gf_isom_get_sample but fills a sample object owned by the caller, created with gf_isom_sample_new and reused
+from call to call, avoiding per-sample allocations.
+If the file was opened with GF_ISOM_OPEN_FILE_MAPPING and the sample payload does not need any rewriting (no padding, no
+encryption, no NALU or OD rewriting), static_sample->data points directly to the mapped file and is flagged as borrowed: it is
+read-only and remains valid until the file is closed.
+Otherwise the payload is copied in static_sample->data, which is only reallocated when too small.
+The payload should be released with gf_isom_sample_release once consumed, and the sample destroyed with gf_isom_sample_del*/
+GF_Err gf_isom_get_sample_ex(GF_ISOFile *the_file, u32 trackNumber, u32 sampleNumber, u32 *StreamDescriptionIndex, GF_ISOSample *static_sample);
+
+/*enables or disables the random access index of a track. The index packs the position, timing and sync information of
+all samples; it is built on the first non-sequential access to the track (seek, sample lookup out of order), after which
+sample lookups no longer need to browse the sample tables. Only available for non-fragmented files opened in read mode,
+returns GF_NOT_SUPPORTED otherwise*/
+GF_Err gf_isom_enable_sample_index(GF_ISOFile *the_file, u32 trackNumber, Bool enable);
+
 /*same as gf_isom_get_sample but doesn't fetch media data
 @StreamDescriptionIndex (optional): set to stream description index
 @data_offset (optional): set to sample start offset in file.
@@ -990,6 +1040,12 @@ u32 gf_isom_get_interleave_time(GF_ISOFile *the_file);
 /*forces usage of 64 bit chunk offsets*/
 void gf_isom_force_64bit_chunk_offset(GF_ISOFile *the_file, Bool set_on);
 
+/*reserves @size bytes before the media data for the moov box (WRITE mode only, before any sample is added).
+Media data is then written once, directly to the final file, and the moov is written in the reserved space when closing
+the file if it fits, producing a fast-start file without rewriting the media; otherwise the moov is written after the media data
+and the reserved space is left as a free box. A size of 0 disables the reservation*/
+GF_Err gf_isom_reserve_moov_space(GF_ISOFile *the_file, u32 size);
+
 /*set the copyright in one language.*/
 GF_Err gf_isom_set_copyright(GF_ISOFile *the_file, const char *threeCharCode, char *notice);
 
@@ -1342,6 +1398,12 @@ GF_Err gf_isom_set_movie_duration(GF_ISOFile *movie, u64 duration);
 fragment media data for all tracks*/
 GF_Err gf_isom_start_fragment(GF_ISOFile *movie, Bool moof_first);
 
+/*reserves size bytes before the media data of each following moof_first fragment. Sample data is then written
+directly to the file and the moof is written in place when the fragment is stored, preceded by a free box for the
+unused space, instead of loading the fragment media data in memory to move it after the moof. If the moof does not fit,
+the fragment is stored as usual. Ignored when writing segments. A size of 0 disables the reservation*/
+GF_Err gf_isom_reserve_moof_space(GF_ISOFile *movie, u32 size);
+
 /*starts a new segment in the file. If SegName is given, the output will be written in the SegName file. If memory_mode is set, all samples writing is done in memory rather than on disk*/
 GF_Err gf_isom_start_segment(GF_ISOFile *movie, const char *SegName, Bool memory_mode);
 
@@ -1355,6 +1417,10 @@ GF_Err gf_isom_close_segment(GF_ISOFile *movie, s32 subsegs_per_sidx, u32 refere
 /*writes any pending fragment to file for low-latency output. shall only be used if no SIDX is used (subsegs_per_sidx<0 or flushing all fragments before calling gf_isom_close_segment)*/
 GF_Err gf_isom_flush_fragments(GF_ISOFile *movie, Bool last_segment);
 
+/*returns the offset in the segment output at which the next flushed fragments will be written, i.e. the number of bytes
+already output for the current segment file (or for the file when segments are not stored in separate files)*/
+u64 gf_isom_get_segment_write_offset(GF_ISOFile *movie);
+
 /*sets fragment prft box info, written just before the moof*/
 GF_Err gf_isom_set_fragment_reference_time(GF_ISOFile *movie, u32 reference_track_ID, u64 ntp, u64 timestamp);
 
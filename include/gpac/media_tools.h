@@ -805,6 +805,26 @@ GF_Err gf_dasher_enable_utc_ref(GF_DASHSegmenter *dasher, Bool insert_utc);
 */
 GF_Err gf_dasher_enable_real_time(GF_DASHSegmenter *dasher, Bool real_time);
 
+/*!
+ Callback function for chunked output, called each time a chunk of a media segment has been written.
+ *	\param udta user data passed to \ref gf_dasher_enable_chunked_mode
+ *	\param segment_name name of the media segment file, or of the output file if segments are not stored in separate files
+ *	\param offset offset of the chunk in the file
+ *	\param size size of the chunk in bytes
+ *	\param last_chunk set if this is the last chunk of the segment
+*/
+typedef void (*gf_dasher_chunk_callback)(void *udta, const char *segment_name, u64 offset, u64 size, Bool last_chunk);
+
+/*!
+ Enables low-latency chunked output of ISOBMFF media segments. Each segment is produced as a sequence of moof/mdat chunks of the given duration, each chunk being written to the segment file as soon as it is complete. Segments are announced in the MPD with an availabilityTimeOffset of the segment duration minus the chunk duration and availabilityTimeComplete set to false. This disables SIDX generation, overrides the fragment duration and enables memory fragmenting.
+ *	\param dasher the DASH segmenter object
+ *	\param chunk_duration duration of each chunk in seconds, 0 disables chunked mode. Default is disabled.
+ *	\param on_chunk callback function called for each chunk written, may be NULL. The callback may be called from the segmentation threads, see \ref gf_dasher_set_thread_count
+ *	\param udta user data for the callback
+ *	\return error code if any
+*/
+GF_Err gf_dasher_enable_chunked_mode(GF_DASHSegmenter *dasher, Double chunk_duration, gf_dasher_chunk_callback on_chunk, void *udta);
+
 /*!
  Sets where the  ContentProtection element is inserted in an adaptation set.
 *	\param dasher the DASH segmenter object
@@ -821,6 +841,14 @@ GF_Err gf_dasher_set_content_protection_location_mode(GF_DASHSegmenter *dasher,
 */
 GF_Err gf_dasher_set_profile_extension(GF_DASHSegmenter *dasher, const char *dash_profile_extension);
 
+/*!
+ Sets the number of threads used to segment the representations of an adaptation set.
+ *	\param dasher the DASH segmenter object
+ *	\param nb_threads maximum number of representations segmented in parallel. 0 or 1 segments representations one after the other (default). Parallel segmentation is not used with a DASH context, in real-time mode or for scalable or MPEG-2 TS representations; the generated MPD is the same as in sequential mode.
+ *	\return error code if any
+*/
+GF_Err gf_dasher_set_thread_count(GF_DASHSegmenter *dasher, u32 nb_threads);
+
 /*!
  Adds a media input to the DASHer
  *	\param dasher the DASH segmenter object
@@ -127,7 +127,7 @@ enum
 	GF_CODEC_SAMPLERATE,
 	/*Audio num channels*/
 	GF_CODEC_NB_CHAN,
-	/*Audio bps*/
+	/*Audio bps - 8 and 16 bits samples are signed integers, 32 bits samples are floats*/
 	GF_CODEC_BITS_PER_SAMPLE,
 	/*audio frame format*/
 	GF_CODEC_CHANNEL_CONFIG,
@@ -220,6 +220,10 @@ typedef struct _basedecoder
 /*interface name and version for media decoder */
 #define GF_MEDIA_DECODER_INTERFACE		GF_4CC('G', 'M', 'D', '3')
 
+/*decoded frame handed out by the decoder without copy. Frames are reference counted by the terminal: the composition
+memory holds one reference while the frame is queued, and the media object holds one on the last fetched frame so that
+the compositor can keep using its planes or textures after the composition unit is consumed. Release is called once
+the last reference is dropped, always before the decoder is detached*/
 typedef struct _mediadecoderframe
 {
 	//release media frame
@@ -234,6 +238,9 @@ typedef struct _mediadecoderframe
 
 	//allocated space by the decoder
 	void *user_data;
+
+	//number of references on the frame, managed by the terminal - must be 0 when the frame is handed out
+	u32 nb_refs;
 } GF_MediaDecoderFrame;
 
 /*the media module interface. A media module MUST be implemented in synchronous mode as time
@@ -260,7 +267,8 @@ typedef struct _mediadecoder
 	/*optionnal (may be null), retrievs internal output frame of decoder. this function is called only if the decoder returns GF_OK on a SetCapabilities GF_CODEC_RAW_MEMORY*/
 	GF_Err (*GetOutputBuffer)(struct _mediadecoder *, u16 ES_ID, u8 **pY_or_RGB, u8 **pU, u8 **pV);
 
-	/*optionnal (may be null), retrievs internal output frame object of decoder. this function is called only if the decoder returns GF_OK on a SetCapabilities GF_CODEC_FRAME_OUTPUT*/
+	/*optionnal (may be null), retrievs internal output frame object of decoder. this function is called only if the decoder returns GF_OK on a SetCapabilities GF_CODEC_FRAME_OUTPUT.
+	The returned frame must stay valid until released, regardless of subsequent decode calls*/
 	GF_Err (*GetOutputFrame)(struct _mediadecoder *, u16 ES_ID, GF_MediaDecoderFrame **frame, Bool *needs_resize);
 } GF_MediaDecoder;
 
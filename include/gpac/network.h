@@ -306,6 +306,14 @@ GF_Err gf_sk_send(GF_Socket *sock, const char *buffer, u32 length);
  *\param read the actual number of bytes received
  */
 GF_Err gf_sk_receive(GF_Socket *sock, char *buffer, u32 length, u32 start_from, u32 *read);
+/*!
+ *\brief data availability check
+ *
+ *Checks, without blocking nor consuming any data, whether data can be read on a socket. The socket must be in a bound or connected state
+ *\param sock the socket object
+ *\return GF_OK if data (or the end of the connection) is pending, GF_IP_NETWORK_EMPTY otherwise
+ */
+GF_Err gf_sk_probe(GF_Socket *sock);
 /*!
  *\brief socket listening
  *
@@ -33,6 +33,10 @@
 extern "C" {
 #endif
 
+/*!
+ * Single-producer / single-consumer ringbuffer. One thread may write to the ringbuffer while another one reads
+ * from it without any locking. Several writers (resp. readers) must be serialized by the caller.
+ */
 typedef struct
 {
 	u8           *buf;
@@ -40,7 +44,6 @@ typedef struct
 	volatile u32 read_ptr;
 	u32          size;
 	u32          size_mask;
-	GF_Mutex *   mx;
 }
 GF_Ringbuffer ;
 
@@ -49,7 +52,7 @@ GF_Ringbuffer ;
  * Creates a new ringbuffer with specified size. The caller has the
  * reponsability to free the ringbuffer using gf_ringbuffer_del()
  *
- * \param sz the ringbuffer size in bytes
+ * \param sz the ringbuffer size in bytes, rounded up to the next power of 2. At most size-1 bytes can be stored.
  *
  * \return a pointer to a new ringbuffer if successful, NULL otherwise.
  */
@@ -88,6 +91,47 @@ u32 gf_ringbuffer_available_for_read (GF_Ringbuffer * rb);
  */
 u32 gf_ringbuffer_write (GF_Ringbuffer * rb, const u8 * src, u32 sz);
 
+/*!
+ * Return the number of bytes available for writing.  This is the
+ * number of bytes in front of the write pointer and behind the read
+ * pointer.
+ * \param rb The ringbuffer
+ * \return the number of bytes available for writing
+ */
+u32 gf_ringbuffer_available_for_write (GF_Ringbuffer * rb);
+
+/*!
+ * Gets the contiguous region in front of the write pointer, so that the producer can write directly into the
+ * ringbuffer. The data is only visible to the reader once committed with gf_ringbuffer_commit().
+ * \param rb The ringbuffer to write to
+ * \param data Set to the start of the writable region, NULL if the ringbuffer is full
+ * \return the size of the writable region, which may be less than gf_ringbuffer_available_for_write() when the free space wraps around the end of the buffer
+ */
+u32 gf_ringbuffer_reserve(GF_Ringbuffer *rb, u8 **data);
+
+/*!
+ * Publishes bytes written in the region obtained by gf_ringbuffer_reserve().
+ * \param rb The ringbuffer
+ * \param size The number of bytes written, at most the size returned by gf_ringbuffer_reserve()
+ */
+void gf_ringbuffer_commit(GF_Ringbuffer *rb, u32 size);
+
+/*!
+ * Gets the contiguous region in front of the read pointer, so that the consumer can read directly from the
+ * ringbuffer. The data stays in the ringbuffer until released with gf_ringbuffer_consume().
+ * \param rb The ringbuffer to read from
+ * \param data Set to the start of the readable region, NULL if the ringbuffer is empty
+ * \return the size of the readable region, which may be less than gf_ringbuffer_available_for_read() when the data wraps around the end of the buffer
+ */
+u32 gf_ringbuffer_peek(GF_Ringbuffer *rb, u8 **data);
+
+/*!
+ * Releases bytes read from the region obtained by gf_ringbuffer_peek().
+ * \param rb The ringbuffer
+ * \param size The number of bytes consumed, at most the size returned by gf_ringbuffer_peek()
+ */
+void gf_ringbuffer_consume(GF_Ringbuffer *rb, u32 size);
+
 #ifdef __cplusplus
 }
 #endif
@@ -452,6 +452,13 @@ char* gf_strdup(const char *str);
 #define GPAC_STATIC_MODULES
 #endif
 
+/*SIMD instruction sets usable at compile time - the intrinsics headers are included by the code using them*/
+#if defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2)) || defined(__SSE2__)
+#define GPAC_HAS_SSE2
+#elif (defined(__ARM_NEON__) || defined(__ARM_NEON)) && !defined(__ARM_BIG_ENDIAN)
+#define GPAC_HAS_NEON
+#endif
+
 /*safety checks on macros*/
 
 #ifdef GPAC_DISABLE_ZLIB
@@ -280,6 +280,30 @@ void gf_sema_wait(GF_Semaphore *sm);
 Bool gf_sema_wait_for(GF_Semaphore *sm, u32 time_out);
 
 
+/*********************************************************************
+					Atomic Operations
+**********************************************************************/
+/*
+ *\brief atomic pointer compare and swap
+ *
+ *Atomically replaces the pointer stored at the given address if it is equal to an expected value. The operation is a full memory barrier.
+ *\param ptr address of the pointer
+ *\param old_val the expected pointer value
+ *\param new_val the new pointer value
+ *\return GF_TRUE if the pointer was replaced, GF_FALSE otherwise
+*/
+Bool gf_atomic_ptr_cas(void * volatile *ptr, void *old_val, void *new_val);
+/*
+ *\brief atomic pointer exchange
+ *
+ *Atomically replaces the pointer stored at the given address. The operation is a full memory barrier.
+ *\param ptr address of the pointer
+ *\param new_val the new pointer value
+ *\return the previous pointer value
+*/
+void *gf_atomic_ptr_swap(void * volatile *ptr, void *new_val);
+
+
 /*! @} */
 
 #ifdef __cplusplus
@@ -162,6 +162,18 @@ u64 gf_ftell(FILE *f);
 */
 u64 gf_fseek(FILE *f, s64 pos, s32 whence);
 
+/*!
+ *	\brief kernel-side file copy
+ *
+ *	Copies a byte range of a file to the current write position of another file without going through user memory, using copy_file_range or sendfile when available. The write position of the destination file is advanced by the number of bytes copied.
+ *	\param dst destination file, opened for writing. Pending stdio data is flushed before copying
+ *	\param src source file. Pending writes on this file must have been flushed by the caller
+ *	\param src_offset offset of the data to copy in the source file
+ *	\param size number of bytes to copy
+ *	\return number of bytes copied, possibly less than requested (0 if not supported on this platform or for these files). The caller is responsible for copying the remaining bytes
+*/
+u64 gf_fcopy_range(FILE *dst, FILE *src, u64 src_offset, u64 size);
+
 /*! @} */
 
 
@@ -87,6 +87,12 @@ enum
 	purposes, as it may result in non-smooth visual playback (time is not continuously increasing)*/
 	GF_TERM_USE_AUDIO_HW_CLOCK = 1<<6,
 
+	/*offline rendering: the terminal time base is a virtual clock advanced by the compositor by one frame (at the simulation
+	frame rate) for each call to gf_term_process_step, and all decoders are run to completion for that frame before it is composed.
+	No frame is dropped and no sleep is performed, so that the output is identical every run and produced as fast as possible.
+	Implies GF_TERM_NO_DECODER_THREAD, GF_TERM_NO_COMPOSITOR_THREAD and GF_TERM_NO_REGULATION*/
+	GF_TERM_USE_VIRTUAL_CLOCK = 1<<7,
+
 	/*works without window thread*/
 	GF_TERM_WINDOW_NO_THREAD = 1<<10,
 	/*lets the main user handle window events (needed for browser plugins)*/
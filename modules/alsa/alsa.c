@@ -122,10 +122,20 @@ static GF_Err ALSA_ConfigureOutput(GF_AudioOutput*dr, u32 *SampleRate, u32 *NbCh
 	/*set output format*/
 	ctx->nb_ch = (int) (*NbChannels);
 	ctx->block_align = ctx->nb_ch;
+	if ((*nbBitsPerSample) == 32) {
+		err = snd_pcm_hw_params_set_format(ctx->playback_handle, hw_params, SND_PCM_FORMAT_FLOAT_LE);
+		/*device cannot play float samples, let the mixer convert to 16 bits*/
+		if (err < 0) {
+			GF_LOG(GF_LOG_INFO, GF_LOG_MMIO, ("[ALSA] Float samples not supported by device, using 16 bits\n"));
+			(*nbBitsPerSample) = 16;
+		} else {
+			ctx->block_align *= 4;
+		}
+	}
 	if ((*nbBitsPerSample) == 16) {
 		ctx->block_align *= 2;
 		err = snd_pcm_hw_params_set_format(ctx->playback_handle, hw_params, SND_PCM_FORMAT_S16_LE);
-	} else {
+	} else if ((*nbBitsPerSample) != 32) {
 		err = snd_pcm_hw_params_set_format(ctx->playback_handle, hw_params, SND_PCM_FORMAT_U8);
 	}
 	if (err < 0) {
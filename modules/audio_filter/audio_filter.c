@@ -125,6 +125,9 @@ static GF_Err Configure(GF_AudioFilter *af, u32 in_sr, u32 in_bps, u32 in_nb_ch,
 {
 	FilterContext *ctx = (FilterContext*)af->udta;
 
+	/*distorsion and delay filters only process 16 bits samples*/
+	if (ctx->type && (in_bps != 16)) return GF_NOT_SUPPORTED;
+
 	*inplace = ctx->inplace;
 	*delay_ms = 0;
 	*out_nb_ch = in_nb_ch;
@@ -189,6 +189,8 @@ static GF_Err WAV_ConfigureOutput(GF_AudioOutput *dr, u32 *SampleRate, u32 *NbCh
 	ctx->sampleRateInHz = *SampleRate;
 	ctx->channelConfig = (*NbChannels == 1) ? CHANNEL_CONFIGURATION_MONO : CHANNEL_CONFIGURATION_STEREO; //AudioFormat.CHANNEL_CONFIGURATION_MONO
 	ctx->audioFormat = (*nbBitsPerSample == 8)? ENCODING_PCM_8BIT : ENCODING_PCM_16BIT; //AudioFormat.ENCODING_PCM_16BIT
+	/*no float output, let the mixer convert to 16 bits*/
+	if (*nbBitsPerSample != 8) *nbBitsPerSample = 16;
 
 	// Get the java environment in the new thread
 	(*GetJavaVM())->AttachCurrentThread(GetJavaVM(), &env, NULL);
@@ -36,6 +36,13 @@
 const static GUID  GPAC_KSDATAFORMAT_SUBTYPE_PCM = {0x00000001,0x0000,0x0010,
 	{0x80,0x00,0x00,0xaa,0x00,0x38,0x9b,0x71}
 };
+const static GUID  GPAC_KSDATAFORMAT_SUBTYPE_IEEE_FLOAT = {0x00000003,0x0000,0x0010,
+	{0x80,0x00,0x00,0xaa,0x00,0x38,0x9b,0x71}
+};
+#endif
+
+#ifndef WAVE_FORMAT_IEEE_FLOAT
+#define WAVE_FORMAT_IEEE_FLOAT	0x0003
 #endif
 
 
@@ -153,7 +160,8 @@ static GF_Err DS_ConfigureOutput(GF_AudioOutput *dr, u32 *SampleRate, u32 *NbCha
 	ctx->format.wBitsPerSample = *nbBitsPerSample;
 	ctx->format.nSamplesPerSec = *SampleRate;
 	ctx->format.cbSize = sizeof (WAVEFORMATEX);
-	ctx->format.wFormatTag = WAVE_FORMAT_PCM;
+	/*32 bits samples are float*/
+	ctx->format.wFormatTag = (*nbBitsPerSample==32) ? WAVE_FORMAT_IEEE_FLOAT : WAVE_FORMAT_PCM;
 	ctx->format.nBlockAlign = ctx->format.nChannels * ctx->format.wBitsPerSample / 8;
 	ctx->format.nAvgBytesPerSec = ctx->format.nSamplesPerSec * ctx->format.nBlockAlign;
 
@@ -184,7 +192,7 @@ static GF_Err DS_ConfigureOutput(GF_AudioOutput *dr, u32 *SampleRate, u32 *NbCha
 		memset(&format_ex, 0, sizeof(WAVEFORMATEXTENSIBLE));
 		format_ex.Format = ctx->format;
 		format_ex.Format.cbSize = sizeof(WAVEFORMATEXTENSIBLE);
-		format_ex.SubFormat = GPAC_KSDATAFORMAT_SUBTYPE_PCM;
+		format_ex.SubFormat = (*nbBitsPerSample==32) ? GPAC_KSDATAFORMAT_SUBTYPE_IEEE_FLOAT : GPAC_KSDATAFORMAT_SUBTYPE_PCM;
 		format_ex.Samples.wValidBitsPerSample = *nbBitsPerSample;
 		format_ex.dwChannelMask = 0;
 		if (channel_cfg & GF_AUDIO_CH_FRONT_LEFT) format_ex.dwChannelMask |= SPEAKER_FRONT_LEFT;
@@ -209,6 +217,12 @@ retry:
 		dsbBufferDesc.dwFlags = DSBCAPS_GETCURRENTPOSITION2 | DSBCAPS_GLOBALFOCUS;
 		hr = ctx->pDS->lpVtbl->CreateSoundBuffer(ctx->pDS, &dsbBufferDesc, &ctx->pOutput, NULL );
 		if (FAILED(hr)) {
+			/*device cannot play float samples, let the mixer convert to 16 bits*/
+			if (*nbBitsPerSample==32) {
+				GF_LOG(GF_LOG_WARNING, GF_LOG_AUDIO, ("[DirectSound] failed to configure float output (error %08x) - falling back to 16 bits\n", hr));
+				*nbBitsPerSample = 16;
+				return DS_ConfigureOutput(dr, SampleRate, NbChannels, nbBitsPerSample, channel_cfg);
+			}
 			if (ctx->format.nChannels>2) {
 				GF_LOG(GF_LOG_ERROR, GF_LOG_AUDIO, ("[DirectSound] failed to configure output for %d channels (error %08x) - falling back to stereo\n", *NbChannels, hr));
 				*NbChannels = 2;
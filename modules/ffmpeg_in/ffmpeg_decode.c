@@ -438,6 +438,12 @@ static GF_Err FFDEC_AttachStream(GF_BaseDecoder *plug, GF_ESD *esd)
 		if (!(*ctx)->channels) (*ctx)->channels = 2;
 
 #if defined(USE_AVCTX3)
+		ffd->audio_float = GF_FALSE;
+		sOpt = gf_modules_get_option((GF_BaseInterface *)plug, "Audio", "FloatSamples");
+		if (sOpt && !strcmp(sOpt, "yes") && (((*ctx)->sample_fmt==AV_SAMPLE_FMT_FLTP) || ((*ctx)->sample_fmt==AV_SAMPLE_FMT_FLT)) ) {
+			ffd->audio_float = GF_TRUE;
+			ffd->out_size *= 2;
+		}
 
 #if !defined(FF_API_AVFRAME_LAVC)
 		ffd->audio_frame = avcodec_alloc_frame();
@@ -516,6 +522,10 @@ static GF_Err FFDEC_AttachStream(GF_BaseDecoder *plug, GF_ESD *esd)
 		ffd->conv_to_8bit = GF_TRUE;
 	}
 
+	sOpt = gf_modules_get_option((GF_BaseInterface *)plug, "FFMPEG", "FrameOutput");
+	if (!sOpt) gf_modules_set_option((GF_BaseInterface *)plug, "FFMPEG", "FrameOutput", "no");
+	if (sOpt && !strcmp(sOpt, "yes")) ffd->frame_output = GF_TRUE;
+
 	return GF_OK;
 }
 
@@ -599,9 +609,11 @@ static GF_Err FFDEC_GetCapabilities(GF_BaseDecoder *plug, GF_CodecCapability *ca
 		capability->cap.valueBool = GF_TRUE;
 		return GF_OK;
 	case GF_CODEC_FRAME_OUTPUT:
-#if defined(USE_AVCTX3)
-		//deactivated by default until we have more tests (stride, color formats)
 		capability->cap.valueBool = GF_FALSE;
+#if defined(USE_AVCTX3)
+		//deactivated by default until we have more tests (stride, color formats), frames are never converted
+		if (ffd->frame_output && !ffd->conv_to_8bit && (ffd->st==GF_STREAM_VISUAL))
+			capability->cap.valueBool = GF_TRUE;
 #endif
 		return GF_OK;
 	case GF_CODEC_WANTS_THREAD:
@@ -626,6 +638,12 @@ static GF_Err FFDEC_GetCapabilities(GF_BaseDecoder *plug, GF_CodecCapability *ca
 		capability->cap.valueInt = ffd->base_ctx->channels;
 		break;
 	case GF_CODEC_BITS_PER_SAMPLE:
+#if defined(USE_AVCTX3)
+		if (ffd->audio_float) {
+			capability->cap.valueInt = 32;
+			break;
+		}
+#endif
 		capability->cap.valueInt = 16;
 		break;
 	case GF_CODEC_BUFFER_MIN:
@@ -673,11 +691,41 @@ static GF_Err FFDEC_GetCapabilities(GF_BaseDecoder *plug, GF_CodecCapability *ca
 		//ffd->ctx->hurry_up = 5;
 		break;
 	case GF_CODEC_CHANNEL_CONFIG:
-		/*currently unused in ffmpeg*/
 		if (ffd->base_ctx->channels==1) {
 			capability->cap.valueInt = GF_AUDIO_CH_FRONT_CENTER;
-		} else {
+		} else if (ffd->base_ctx->channels==2) {
 			capability->cap.valueInt = GF_AUDIO_CH_FRONT_LEFT | GF_AUDIO_CH_FRONT_RIGHT;
+		} else {
+			u32 i, nb_ch, cfg = 0;
+#ifdef AV_CH_FRONT_LEFT
+			u64 layout = ffd->base_ctx->channel_layout;
+			/*ffmpeg channel order matches the GPAC one, except for the front left/right of center channels we don't have*/
+			if (layout & AV_CH_FRONT_LEFT) cfg |= GF_AUDIO_CH_FRONT_LEFT;
+			if (layout & AV_CH_FRONT_RIGHT) cfg |= GF_AUDIO_CH_FRONT_RIGHT;
+			if (layout & AV_CH_FRONT_CENTER) cfg |= GF_AUDIO_CH_FRONT_CENTER;
+			if (layout & AV_CH_LOW_FREQUENCY) cfg |= GF_AUDIO_CH_LFE;
+			if (layout & AV_CH_BACK_LEFT) cfg |= GF_AUDIO_CH_BACK_LEFT;
+			if (layout & AV_CH_BACK_RIGHT) cfg |= GF_AUDIO_CH_BACK_RIGHT;
+			if (layout & AV_CH_BACK_CENTER) cfg |= GF_AUDIO_CH_BACK_CENTER;
+			if (layout & AV_CH_SIDE_LEFT) cfg |= GF_AUDIO_CH_SIDE_LEFT;
+			if (layout & AV_CH_SIDE_RIGHT) cfg |= GF_AUDIO_CH_SIDE_RIGHT;
+#endif
+			nb_ch = 0;
+			for (i=0; i<9; i++) {
+				if (cfg & (1<<i)) nb_ch++;
+			}
+			/*unknown or unmapped layout, use the default ones*/
+			if (nb_ch != (u32) ffd->base_ctx->channels) {
+				if (ffd->base_ctx->channels==6) {
+					cfg = GF_AUDIO_CH_FRONT_LEFT | GF_AUDIO_CH_FRONT_RIGHT | GF_AUDIO_CH_FRONT_CENTER | GF_AUDIO_CH_LFE | GF_AUDIO_CH_BACK_LEFT | GF_AUDIO_CH_BACK_RIGHT;
+				} else if (ffd->base_ctx->channels==8) {
+					cfg = GF_AUDIO_CH_FRONT_LEFT | GF_AUDIO_CH_FRONT_RIGHT | GF_AUDIO_CH_FRONT_CENTER | GF_AUDIO_CH_LFE | GF_AUDIO_CH_BACK_LEFT | GF_AUDIO_CH_BACK_RIGHT | GF_AUDIO_CH_SIDE_LEFT | GF_AUDIO_CH_SIDE_RIGHT;
+				} else {
+					cfg = 0;
+					for (i=0; (i<(u32) ffd->base_ctx->channels) && (i<9); i++) cfg |= 1<<i;
+				}
+			}
+			capability->cap.valueInt = cfg;
 		}
 		break;
 
@@ -820,7 +868,7 @@ redecode:
 	len = avcodec_decode_audio4(ctx, ffd->audio_frame, &gotpic, &pkt);
 	if (gotpic) {
 		//int inputDataSize = av_samples_get_buffer_size(NULL, ctx->channels, ffd->audio_frame->nb_samples, ctx->sample_fmt, 1);
-		gotpic = ffd->audio_frame->nb_samples * 2 * ctx->channels;
+		gotpic = ffd->audio_frame->nb_samples * (ffd->audio_float ? 4 : 2) * ctx->channels;
 	}
 #elif defined(USE_AVCODEC2)
 	gotpic = 192000;
@@ -841,6 +889,9 @@ redecode:
 	/*first config*/
 	if (!ffd->out_size) {
 		u32 bpp = 2;
+#if defined(USE_AVCTX3)
+		if (ffd->audio_float) bpp = 4;
+#endif
 		
 		if (ctx->channels * ctx->frame_size * bpp < gotpic) ctx->frame_size = gotpic / (bpp * ctx->channels);
 		ffd->out_size = ctx->channels * ctx->frame_size * bpp;
@@ -859,7 +910,20 @@ redecode:
 	}
 
 #if defined(USE_AVCTX3)
-	if (ffd->audio_frame->format==AV_SAMPLE_FMT_FLTP) {
+	if (ffd->audio_float && (ffd->audio_frame->format==AV_SAMPLE_FMT_FLTP)) {
+		s32 i, j;
+		Float *output = (Float *) outBuffer;
+		for (j=0; j<ctx->channels; j++) {
+			Float* inputChannel = (Float*)ffd->audio_frame->extended_data[j];
+			for (i=0 ; i<ffd->audio_frame->nb_samples ; i++) {
+				output[i*ctx->channels + j] = inputChannel[i];
+			}
+		}
+	} else if (ffd->audio_float && (ffd->audio_frame->format==AV_SAMPLE_FMT_FLT)) {
+		memcpy(outBuffer, ffd->audio_frame->data[0], sizeof(Float) * ffd->audio_frame->nb_samples * ctx->channels);
+	} else if (ffd->audio_float) {
+		GF_LOG(GF_LOG_ERROR, GF_LOG_CODEC, ("[FFMPEG Decoder] Raw Audio format %d changed during float output\n", ffd->audio_frame->format ));
+	} else if (ffd->audio_frame->format==AV_SAMPLE_FMT_FLTP) {
 		s32 i, j;
 		s16 *output = (s16 *) outBuffer;
 		for (j=0; j<ctx->channels; j++) {
@@ -1534,6 +1598,8 @@ void FFFrame_Release(GF_MediaDecoderFrame *frame)
 	FF_Frame *ff_frame = (FF_Frame *)frame->user_data;
 
 	av_frame_free(&ff_frame->frame);
+	gf_free(ff_frame);
+	gf_free(frame);
 }
 
 GF_Err FFFrame_GetPlane(GF_MediaDecoderFrame *frame, u32 plane_idx, const char **outPlane, u32 *outStride)
@@ -1582,7 +1648,13 @@ static GF_Err FFDEC_GetOutputFrame(GF_MediaDecoder *ifcg, u16 ES_ID, GF_MediaDec
 	}
 	a_frame->user_data = ff_frame;
 	ff_frame->ctx = ffd;
+	/*new reference on the decoder buffers, no copy*/
 	ff_frame->frame = av_frame_clone(ffd->base_frame);
+	if (!ff_frame->frame) {
+		gf_free(ff_frame);
+		gf_free(a_frame);
+		return GF_OUT_OF_MEM;
+	}
 
 	a_frame->Release = FFFrame_Release;
 	a_frame->GetPlane = FFFrame_GetPlane;
@@ -135,6 +135,8 @@ typedef struct
 	u32 raw_pix_fmt;
 	Bool flipped;
 	u32 direct_output_mode;
+	/*decoded frames are handed to the terminal by reference*/
+	Bool frame_output;
 	
 	u32 stride;
 
@@ -165,6 +167,8 @@ typedef struct
 
 #ifdef USE_AVCTX3
 	AVFrame *audio_frame;
+	/*float audio samples are output as is (32 bits) rather than converted to 16 bits*/
+	Bool audio_float;
 #endif
 
 
@@ -98,6 +98,8 @@ typedef struct
 	Bool wait_for_segment_switch;
 	/*current sample*/
 	GF_ISOSample *sample;
+	/*sample object reused when reading samples in sequence*/
+	GF_ISOSample *static_sample;
 	GF_SLHeader current_slh;
 	GF_Err last_state;
 
@@ -46,6 +46,7 @@ static void isor_delete_channel(ISOMReader *reader, ISOMChannel *ch)
 	while ((ch2 = (ISOMChannel *)gf_list_enum(reader->channels, &i))) {
 		if (ch2 == ch) {
 			isor_reset_reader(ch);
+			if (ch->static_sample) gf_isom_sample_del(&ch->static_sample);
 			gf_free(ch);
 			gf_list_rem(reader->channels, i-1);
 			return;
@@ -404,7 +405,21 @@ GF_Err ISOR_ConnectService(GF_InputService *plug, GF_ClientService *serv, const
 				end_range = param.url_query.end_range;
 			}
 		}
-		e = gf_isom_open_progressive(szURL, start_range, end_range, &read->mov, &read->missing_bytes);
+		e = GF_OK;
+		/*complete local files may be mapped in memory, letting samples point directly to the file data*/
+		if (!plug->query_proxy && strnicmp(szURL, "gmem://", 7)) {
+			const char *opt = gf_modules_get_option((GF_BaseInterface *)plug, "ISOReader", "FileMapping");
+			if (opt && !strcmp(opt, "yes")) {
+				read->mov = gf_isom_open(szURL, GF_ISOM_OPEN_READ | GF_ISOM_OPEN_FILE_MAPPING, NULL);
+				/*fragmented files are refreshed as they are played, use regular IO*/
+				if (read->mov && gf_isom_is_fragmented(read->mov)) {
+					gf_isom_close(read->mov);
+					read->mov = NULL;
+				}
+			}
+		}
+		if (!read->mov)
+			e = gf_isom_open_progressive(szURL, start_range, end_range, &read->mov, &read->missing_bytes);
 		if (e != GF_OK) {
 			GF_LOG(GF_LOG_ERROR, GF_LOG_NETWORK, ("[IsoMedia] : error while opening %s, error=%s\n", szURL, gf_error_to_string(e)));
 			if (read->input->query_proxy && read->input->proxy_udta && read->input->proxy_type) {
@@ -807,6 +822,8 @@ GF_Err ISOR_ConnectChannel(GF_InputService *plug, LPNETCHANNEL channel, const ch
 	ch->has_edit_list = gf_isom_get_edit_list_type(ch->owner->mov, ch->track, &ch->dts_offset) ? GF_TRUE : GF_FALSE;
 	ch->has_rap = (gf_isom_has_sync_points(ch->owner->mov, ch->track)==1) ? GF_TRUE : GF_FALSE;
 	ch->time_scale = gf_isom_get_media_timescale(ch->owner->mov, ch->track);
+	/*avoid browsing the sample tables when seeking, ignored for fragmented files*/
+	gf_isom_enable_sample_index(ch->owner->mov, ch->track, GF_TRUE);
 
 exit:
 	if (read->input->query_proxy && read->input->proxy_udta && read->input->proxy_type) {
@@ -435,6 +435,18 @@ static void init_reader(ISOMChannel *ch)
 
 
 
+/*discards the current sample, keeping the reused sample object*/
+static void isor_reader_drop_sample(ISOMChannel *ch)
+{
+	if (!ch->sample) return;
+	if (ch->sample == ch->static_sample) {
+		gf_isom_sample_release(ch->static_sample);
+		ch->sample = NULL;
+	} else {
+		gf_isom_sample_del(&ch->sample);
+	}
+}
+
 void isor_reader_get_sample(ISOMChannel *ch)
 {
 	GF_Err e;
@@ -554,10 +566,18 @@ void isor_reader_get_sample(ISOMChannel *ch)
 	} else {
 		ch->sample_num++;
 
-		ch->sample = gf_isom_get_sample(ch->owner->mov, ch->track, ch->sample_num, &sample_desc_index);
+		/*ISMA decryption replaces the sample payload, don't reuse the sample in this case*/
+		if (!ch->is_encrypted) {
+			if (!ch->static_sample) ch->static_sample = gf_isom_sample_new();
+			if (gf_isom_get_sample_ex(ch->owner->mov, ch->track, ch->sample_num, &sample_desc_index, ch->static_sample) == GF_OK) {
+				ch->sample = ch->static_sample;
+			}
+		} else {
+			ch->sample = gf_isom_get_sample(ch->owner->mov, ch->track, ch->sample_num, &sample_desc_index);
+		}
 		/*if sync shadow / carousel RAP skip*/
 		if (ch->sample && (ch->sample->IsRAP==RAP_REDUNDANT)) {
-			gf_isom_sample_del(&ch->sample);
+			isor_reader_drop_sample(ch);
 			ch->sample_num++;
 			isor_reader_get_sample(ch);
 			return;
@@ -568,7 +588,7 @@ void isor_reader_get_sample(ISOMChannel *ch)
 	if (ch->sample && ch->sample->IsRAP && ch->next_track) {
 		ch->track = ch->next_track;
 		ch->next_track = 0;
-		gf_isom_sample_del(&ch->sample);
+		isor_reader_drop_sample(ch);
 		isor_reader_get_sample(ch);
 		return;
 	}
@@ -655,8 +675,7 @@ void isor_reader_get_sample(ISOMChannel *ch)
 		default:
 			//TODO: do we want to support codec changes ?
 			GF_LOG(GF_LOG_ERROR, GF_LOG_CONTAINER, ("[IsoMedia] Change of sample description (%d->%d) for media type %s not supported\n", ch->last_sample_desc_index, sample_desc_index, gf_4cc_to_str(mtype) ));
-			gf_isom_sample_del(&ch->sample);
-			ch->sample = NULL;
+			isor_reader_drop_sample(ch);
 			ch->last_state = GF_NOT_SUPPORTED;
 			return;
 		}
@@ -752,8 +771,7 @@ void isor_reader_release_sample(ISOMChannel *ch)
 		gf_free(ch->current_slh.sai);
 		ch->current_slh.sai = NULL;
 	}
-	if (ch->sample) gf_isom_sample_del(&ch->sample);
-	ch->sample = NULL;
+	isor_reader_drop_sample(ch);
 	ch->current_slh.AU_sequenceNumber++;
 	ch->current_slh.packetSequenceNumber++;
 }
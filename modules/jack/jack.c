@@ -150,7 +150,18 @@ process_callback (jack_nframes_t nframes, void *arg)
 	readen = dr->FillBuffer (dr->audio_renderer, (void *) ctx->buffer,
 	                         bytesToRead);
 	toRead = readen / ctx->bytesPerSample;
-	if (ctx->bytesPerSample == 2)
+	if (ctx->bytesPerSample == 4)
+	{
+		/*float samples, only deinterleave*/
+		float *fltBuffer = (float *) ctx->buffer;
+		for (i = 0; i < nframes; i++)
+		{
+			for (channel = 0; channel < ctx->numChannels; channel++)
+				ctx->channels[channel][i] =
+				    ctx->volume * fltBuffer[i * ctx->numChannels + channel];
+		}
+	}
+	else if (ctx->bytesPerSample == 2)
 	{
 		tmpBuffer = (short *) ctx->buffer;
 		for (channel = 0; channel < nframes; channel += ctx->numChannels)
@@ -190,7 +201,7 @@ onBufferSizeChanged (jack_nframes_t nframes, void *arg)
 		return 1;
 	}
 	ctx = dr->opaque;
-	realBuffSize = nframes * ctx->numChannels * sizeof (short);
+	realBuffSize = nframes * ctx->numChannels * MAX(ctx->bytesPerSample, sizeof (short));
 	if (ctx->buffer != NULL && ctx->bufferSz == realBuffSize)
 		return 0;
 	if (ctx->channels != NULL)
@@ -340,7 +351,7 @@ Jack_ConfigureOutput (GF_AudioOutput * dr, u32 * SampleRate, u32 * NbChannels,
 	if (!ctx)
 		return GF_BAD_PARAM;
 	ctx->bytesPerSample = *nbBitsPerSample / 8;
-	if (ctx->bytesPerSample > 2 || ctx->bytesPerSample < 1)
+	if (ctx->bytesPerSample == 3 || ctx->bytesPerSample > 4 || ctx->bytesPerSample < 1)
 	{
 		GF_LOG (GF_LOG_ERROR, GF_LOG_MMIO,
 		        ("[Jack] Jack-ConfigureOutput : unable to use %d bits/sample.\n"));
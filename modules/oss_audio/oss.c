@@ -122,6 +122,8 @@ static GF_Err OSS_ConfigureOutput(GF_AudioOutput*dr, u32 *SampleRate, u32 *NbCha
 	if (ioctl(ctx->audio_dev, SNDCTL_DSP_CHANNELS, &ctx->nb_ch)==-1) return GF_IO_ERR;
 
 	blockalign = ctx->nb_ch;
+	/*no float format in OSS, let the mixer convert to 16 bits*/
+	if ((*nbBitsPerSample) == 32) (*nbBitsPerSample) = 16;
 	if ((*nbBitsPerSample) == 16) {
 		blockalign *= 2;
 		format = AFMT_S16_LE;
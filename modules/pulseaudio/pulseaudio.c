@@ -145,7 +145,12 @@ PulseAudio_ConfigureOutput (GF_AudioOutput * dr, u32 * SampleRate,
 		ctx->playback_handle = NULL;
 	}
 	ctx->consecutive_zero_reads = 0;
-	ctx->sample_spec.format = PA_SAMPLE_S16NE;
+	if (*nbBitsPerSample == 32) {
+		ctx->sample_spec.format = PA_SAMPLE_FLOAT32NE;
+	} else {
+		ctx->sample_spec.format = PA_SAMPLE_S16NE;
+		*nbBitsPerSample = 16;
+	}
 	ctx->sample_spec.channels = *NbChannels;
 	ctx->sample_spec.rate = *SampleRate;
 	ctx->playback_handle = pa_simple_new (NULL,
@@ -41,7 +41,7 @@ typedef struct
 	u32 pixel_format, bpp;
 	Bool passthrough;
 
-	u32 sample_rate, nb_channels, chan_cfg;
+	u32 sample_rate, nb_channels, chan_cfg, bits_per_sample;
 } RawContext;
 
 #define RAWCTX	RawContext *rc = (RawContext *)dr->opaque
@@ -207,13 +207,19 @@ static GF_Err RAW_ConfigureOutput(GF_AudioOutput *dr, u32 *SampleRate, u32 *NbCh
 	rc->sample_rate = *SampleRate;
 	rc->nb_channels = *NbChannels;
 	rc->chan_cfg = channel_cfg;
+	/*8, 16 or 32 (float) bits samples*/
+	rc->bits_per_sample = *nbBitsPerSample;
 	return GF_OK;
 }
 
 static void RAW_WriteAudio(GF_AudioOutput *dr)
 {
 	char buf[4096];
-	dr->FillBuffer(dr->audio_renderer, buf, 4096);
+	u32 size = 4096;
+	RAWCTX;
+	/*fetch complete sample frames only (6 channels or 32 bits samples do not divide 4096)*/
+	if (rc->nb_channels && rc->bits_per_sample) size -= size % (rc->nb_channels * rc->bits_per_sample / 8);
+	dr->FillBuffer(dr->audio_renderer, buf, size);
 }
 
 static void RAW_Play(GF_AudioOutput *dr, u32 PlayType)
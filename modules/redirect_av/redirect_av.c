@@ -471,7 +471,8 @@ static void avr_on_audio_reconfig ( void *udta, u32 samplerate, u32 bits_per_sam
 	if (avr->audioSampleRate != samplerate || avr->audioChannels != nb_channel) {
 		GF_LOG(GF_LOG_INFO, GF_LOG_MODULE, ("[AVRedirect] Audio %u Hz, bitsPerSample=%u, nbchannels=%u\n", samplerate, bits_per_sample, nb_channel));
 #ifdef AVR_DUMP_RAW_AVI
-		AVI_set_audio ( avr->avi_out, nb_channel, samplerate, bits_per_sample, WAVE_FORMAT_PCM, 0 );
+		/*the mixer outputs float samples when configured with 32 bits per sample*/
+		AVI_set_audio ( avr->avi_out, nb_channel, samplerate, bits_per_sample, (bits_per_sample==32) ? WAVE_FORMAT_IEEE_FLOAT : WAVE_FORMAT_PCM, 0 );
 #endif /* AVR_DUMP_RAW_AVI */
 		avr->audioChannels = nb_channel;
 		avr->audioSampleRate = samplerate;
@@ -131,7 +131,11 @@ static GF_Err SDLAud_ConfigureOutput(GF_AudioOutput *dr, u32 *SampleRate, u32 *N
 
 	memset(&want_format, 0, sizeof(SDL_AudioSpec));
 	want_format.freq = *SampleRate;
-	want_format.format = (*nbBitsPerSample==16) ? AUDIO_S16SYS : AUDIO_S8;
+#if SDL_VERSION_ATLEAST(2,0,0)
+	if (*nbBitsPerSample==32) want_format.format = AUDIO_F32SYS;
+	else
+#endif
+		want_format.format = (*nbBitsPerSample==8) ? AUDIO_S8 : AUDIO_S16SYS;
 	want_format.channels = *NbChannels;
 	want_format.callback = sdl_fill_audio;
 	want_format.userdata = dr;
@@ -160,6 +164,11 @@ static GF_Err SDLAud_ConfigureOutput(GF_AudioOutput *dr, u32 *SampleRate, u32 *N
 	case AUDIO_U8:
 		*nbBitsPerSample = 8;
 		break;
+#if SDL_VERSION_ATLEAST(2,0,0)
+	case AUDIO_F32SYS:
+		*nbBitsPerSample = 32;
+		break;
+#endif
 	default:
 		*nbBitsPerSample = 16;
 		break;
@@ -138,17 +138,22 @@ typedef struct  TRaster_
 	TPos x,  y, last_ey;
 	TArea area;
 	int cover;
-
-	EVG_Span gray_spans[FT_MAX_GRAY_SPANS];
-	int num_gray_spans;
-	EVG_Raster_Span_Func  render_span;
-	void *render_span_data;
+	Bool zero_non_zero_rule;
 
 #ifdef INLINE_POINT_CONVERSION
 	GF_Matrix2D *mx;
 #endif
 } TRaster;
 
+/*span state of a sweep - kept out of the raster so that several threads can sweep distinct lines of the same raster*/
+typedef struct
+{
+	EVG_Span gray_spans[FT_MAX_GRAY_SPANS];
+	int num_gray_spans;
+	EVG_Raster_Span_Func  render_span;
+	void *render_span_data;
+} TSweep;
+
 #define AA_CELL_STEP_ALLOC	8
 
 static GFINLINE void gray_record_cell( TRaster *raster )
@@ -596,7 +601,7 @@ static void gray_quick_sort( AACell *cells, int    count )
 }
 
 
-static void gray_hline( TRaster *raster, TCoord  x, TCoord  y, TPos    area, int     acount, Bool zero_non_zero_rule)
+static void gray_hline( TRaster *raster, TSweep *sweep, TCoord  x, TCoord  y, TPos    area, int     acount, Bool zero_non_zero_rule)
 {
 	EVG_Span*   span;
 	int        count;
@@ -631,8 +636,8 @@ static void gray_hline( TRaster *raster, TCoord  x, TCoord  y, TPos    area, int
 
 	if ( coverage ) {
 		/* see if we can add this span to the current list */
-		count = raster->num_gray_spans;
-		span  = raster->gray_spans + count - 1;
+		count = sweep->num_gray_spans;
+		span  = sweep->gray_spans + count - 1;
 		if ( count > 0                          &&
 		        (int)span->x + span->len == (int)x &&
 		        span->coverage == coverage )
@@ -642,10 +647,10 @@ static void gray_hline( TRaster *raster, TCoord  x, TCoord  y, TPos    area, int
 		}
 
 		if (count >= FT_MAX_GRAY_SPANS ) {
-			raster->render_span(y, count, raster->gray_spans, raster->render_span_data );
-			raster->num_gray_spans = 0;
+			sweep->render_span(y, count, sweep->gray_spans, sweep->render_span_data );
+			sweep->num_gray_spans = 0;
 
-			span  = raster->gray_spans;
+			span  = sweep->gray_spans;
 		} else
 			span++;
 
@@ -653,11 +658,11 @@ static void gray_hline( TRaster *raster, TCoord  x, TCoord  y, TPos    area, int
 		span->x        = (short)x;
 		span->len      = (unsigned short)acount;
 		span->coverage = (unsigned char)coverage;
-		raster->num_gray_spans++;
+		sweep->num_gray_spans++;
 	}
 }
 
-static void gray_sweep_line( TRaster *raster, AAScanline *sl, int y, Bool zero_non_zero_rule)
+static void gray_sweep_line( TRaster *raster, TSweep *sweep, AAScanline *sl, int y, Bool zero_non_zero_rule)
 {
 	TCoord  x, cover;
 	TArea   area;
@@ -665,7 +670,7 @@ static void gray_sweep_line( TRaster *raster, AAScanline *sl, int y, Bool zero_n
 
 	cur = sl->cells;
 	cover = 0;
-	raster->num_gray_spans = 0;
+	sweep->num_gray_spans = 0;
 
 	while (sl->num) {
 		start  = cur;
@@ -685,30 +690,26 @@ static void gray_sweep_line( TRaster *raster, AAScanline *sl, int y, Bool zero_n
 		/* if the start cell has a non-null area, we must draw an */
 		/* individual gray pixel there                            */
 		if ( area && x >= 0 ) {
-			gray_hline( raster, x, y, cover * ( ONE_PIXEL * 2 ) - area, 1, zero_non_zero_rule);
+			gray_hline( raster, sweep, x, y, cover * ( ONE_PIXEL * 2 ) - area, 1, zero_non_zero_rule);
 			x++;
 		}
 		if ( x < 0 ) x = 0;
 
 		/* draw a gray span between the start cell and the current one */
 		if ( cur->x > x )
-			gray_hline( raster, x, y, cover * ( ONE_PIXEL * 2 ), cur->x - x, zero_non_zero_rule);
+			gray_hline( raster, sweep, x, y, cover * ( ONE_PIXEL * 2 ), cur->x - x, zero_non_zero_rule);
 	}
-	raster->render_span((int) (y + raster->min_ey), raster->num_gray_spans, raster->gray_spans, raster->render_span_data );
+	sweep->render_span((int) (y + raster->min_ey), sweep->num_gray_spans, sweep->gray_spans, sweep->render_span_data );
 }
 
 
-int evg_raster_render(EVG_Raster raster, EVG_Raster_Params*  params)
+int evg_raster_decompose(EVG_Raster raster, EVG_Raster_Params*  params)
 {
-	Bool zero_non_zero_rule;
-	int i, size_y;
+	int size_y;
 	EVG_Outline*  outline = (EVG_Outline*)params->source;
 	/* return immediately if the outline is empty */
 	if ( outline->n_points == 0 || outline->n_contours <= 0 ) return 0;
 
-	raster->render_span  = (EVG_Raster_Span_Func) params->gray_spans;
-	raster->render_span_data = params->user;
-
 	/* Set up state in the raster object */
 	raster->min_ex = params->clip_xMin;
 	raster->min_ey = params->clip_yMin;
@@ -734,17 +735,35 @@ int evg_raster_render(EVG_Raster raster, EVG_Raster_Params*  params)
 	gray_record_cell( raster );
 
 	/*store odd/even rule*/
-	zero_non_zero_rule = (outline->flags & GF_PATH_FILL_ZERO_NONZERO) ? GF_TRUE : GF_FALSE;
+	raster->zero_non_zero_rule = (outline->flags & GF_PATH_FILL_ZERO_NONZERO) ? GF_TRUE : GF_FALSE;
+	return size_y;
+}
+
+void evg_raster_sweep(EVG_Raster raster, int first_line, int last_line, EVG_SpanFunc gray_spans, void *user)
+{
+	int i;
+	TSweep sweep;
+	sweep.num_gray_spans = 0;
+	sweep.render_span = (EVG_Raster_Span_Func) gray_spans;
+	sweep.render_span_data = user;
 
 	/* sort each scanline and render it*/
-	for (i=0; i<size_y; i++) {
+	for (i=first_line; i<last_line; i++) {
 		AAScanline *sl = &raster->scanlines[i];
 		if (sl->num) {
 			if (sl->num>1) gray_quick_sort(sl->cells, sl->num);
-			gray_sweep_line(raster, sl, i, zero_non_zero_rule);
+			gray_sweep_line(raster, &sweep, sl, i, raster->zero_non_zero_rule);
 			sl->num = 0;
 		}
 	}
+}
+
+int evg_raster_render(EVG_Raster raster, EVG_Raster_Params*  params)
+{
+	int size_y = evg_raster_decompose(raster, params);
+	if (size_y<=0) return 0;
+
+	evg_raster_sweep(raster, 0, size_y, params->gray_spans, params->user);
 
 #if 0
 	for (i=0; i<raster->max_lines; i++) {
@@ -113,6 +113,17 @@ typedef struct EVG_Raster_Params_
 EVG_Raster evg_raster_new();
 void evg_raster_del(EVG_Raster raster);
 int evg_raster_render(EVG_Raster raster, EVG_Raster_Params *params);
+/*splits rendering in two steps: decomposes the outline in scanline cells and returns the number of lines of the raster,
+then sweeps lines [first_line, last_line[ - lines being independent, sweeps of disjoint line ranges may run in parallel*/
+int evg_raster_decompose(EVG_Raster raster, EVG_Raster_Params *params);
+void evg_raster_sweep(EVG_Raster raster, int first_line, int last_line, EVG_SpanFunc gray_spans, void *user);
+
+/*pool of threads sweeping bands of lines of large fills - shared by all surfaces of a raster module*/
+typedef struct _evg_thread_pool EVGThreadPool;
+EVGThreadPool *evg_thread_pool_new(u32 nb_threads);
+void evg_thread_pool_del(EVGThreadPool *pool);
+/*gets the raster threads of the module, as configured by Compositor:RasterThreads*/
+EVGThreadPool *evg_get_thread_pool(GF_Raster2D *dr);
 
 /*the surface object - currently only ARGB/RGB32, RGB/BGR and RGB555/RGB565 supported*/
 struct _evg_surface
@@ -164,6 +175,8 @@ struct _evg_surface
 
 	/*FreeType raster*/
 	EVG_Raster raster;
+	/*raster threads, NULL if tiled rasterization is disabled*/
+	EVGThreadPool *pool;
 
 	/*FreeType outline (path converted to ft)*/
 	EVG_Outline ftoutline;
@@ -33,6 +33,212 @@ mul255(s32 a, s32 b)
 	return ((a+1) * b) >> 8;
 }
 
+/*SSE2/NEON span blending for 32 bit surfaces with a 4 bytes pixel pitch. The kernels compute exactly what the
+scalar code does (mul255(a, s-d)+d is computed as ((255-a)*d + (a+1)*s)>>8 which fits in 16 bits) and only process
+groups of 4 (SSE2) or 8 (NEON) pixels, the remaining pixels of a run being handled by the scalar code*/
+#if defined(GPAC_HAS_SSE2)
+# include <emmintrin.h>
+#elif defined(GPAC_HAS_NEON)
+# include <arm_neon.h>
+#endif
+
+#if defined(GPAC_HAS_SSE2) || defined(GPAC_HAS_NEON)
+#define EVG_SIMD_SPANS
+
+#ifdef GPAC_HAS_SSE2
+#define EVG_SIMD_PIXELS	4
+#else
+#define EVG_SIMD_PIXELS	8
+#endif
+
+/*builds a pixel value from its bytes in memory order*/
+static GFINLINE u32 evg_pix32(u8 c0, u8 c1, u8 c2, u8 c3)
+{
+	u32 pix;
+	u8 *p = (u8 *) &pix;
+	p[0] = c0;
+	p[1] = c1;
+	p[2] = c2;
+	p[3] = c3;
+	return pix;
+}
+
+/*fills count pixels with pix - returns the number of pixels filled*/
+static u32 evg_fill_run_32(u8 *dst, u32 pix, u32 count)
+{
+	u32 i, nb = count - count % EVG_SIMD_PIXELS;
+#ifdef GPAC_HAS_SSE2
+	__m128i v = _mm_set1_epi32((int) pix);
+	for (i=0; i<nb; i+=4) _mm_storeu_si128((__m128i *) (dst + 4*i), v);
+#else
+	uint32x4_t v = vdupq_n_u32(pix);
+	for (i=0; i<nb; i+=8) {
+		vst1q_u32((uint32_t *) (dst + 4*i), v);
+		vst1q_u32((uint32_t *) (dst + 4*i + 16), v);
+	}
+#endif
+	return nb;
+}
+
+/*blends a constant color on count pixels, each byte c of the pixel becoming ((mul[c]*dst[c] + add[c])>>8) + cst[c].
+If src_if_empty is set, pixels with a null 4th byte (alpha) are replaced by src_pix
+returns the number of pixels blended*/
+static u32 evg_blend_const_run_32(u8 *dst, u32 count, const u16 *mul, const u16 *add, const u16 *cst, Bool src_if_empty, u32 src_pix)
+{
+	u32 i, nb = count - count % EVG_SIMD_PIXELS;
+#ifdef GPAC_HAS_SSE2
+	__m128i zero = _mm_setzero_si128();
+	__m128i amask = _mm_set1_epi32((int) evg_pix32(0, 0, 0, 0xFF));
+	__m128i vsrc = _mm_set1_epi32((int) src_pix);
+	__m128i vmul = _mm_setr_epi16(mul[0], mul[1], mul[2], mul[3], mul[0], mul[1], mul[2], mul[3]);
+	__m128i vadd = _mm_setr_epi16(add[0], add[1], add[2], add[3], add[0], add[1], add[2], add[3]);
+	__m128i vcst = _mm_setr_epi16(cst[0], cst[1], cst[2], cst[3], cst[0], cst[1], cst[2], cst[3]);
+
+	for (i=0; i<nb; i+=4) {
+		__m128i d = _mm_loadu_si128((__m128i *) (dst + 4*i));
+		__m128i lo = _mm_unpacklo_epi8(d, zero);
+		__m128i hi = _mm_unpackhi_epi8(d, zero);
+		__m128i res;
+		lo = _mm_add_epi16(_mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(lo, vmul), vadd), 8), vcst);
+		hi = _mm_add_epi16(_mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(hi, vmul), vadd), 8), vcst);
+		res = _mm_packus_epi16(lo, hi);
+		if (src_if_empty) {
+			__m128i empty = _mm_cmpeq_epi32(_mm_and_si128(d, amask), zero);
+			res = _mm_or_si128(_mm_and_si128(empty, vsrc), _mm_andnot_si128(empty, res));
+		}
+		_mm_storeu_si128((__m128i *) (dst + 4*i), res);
+	}
+#else
+	u32 c;
+	u8 *src = (u8 *) &src_pix;
+	uint8x8_t zero = vdup_n_u8(0);
+	for (i=0; i<nb; i+=8) {
+		uint8x8x4_t d = vld4_u8(dst + 4*i);
+		uint8x8x4_t res;
+		for (c=0; c<4; c++) {
+			uint16x8_t v = vmlaq_u16(vdupq_n_u16(add[c]), vmovl_u8(d.val[c]), vdupq_n_u16(mul[c]));
+			res.val[c] = vmovn_u16(vaddq_u16(vshrq_n_u16(v, 8), vdupq_n_u16(cst[c])));
+		}
+		if (src_if_empty) {
+			uint8x8_t empty = vceq_u8(d.val[3], zero);
+			for (c=0; c<4; c++)
+				res.val[c] = vbsl_u8(empty, vdup_n_u8(src[c]), res.val[c]);
+		}
+		vst4_u8(dst + 4*i, res);
+	}
+#endif
+	return nb;
+}
+
+/*blends count ARGB colors with the given coverage on 32 bit pixels, skipping colors with a null alpha.
+rgb_order: destination bytes are R,G,B,X instead of B,G,R,X
+with_alpha: destination alpha is blended (BGRA), otherwise it is set to 0xFF
+returns the number of pixels blended*/
+static u32 evg_blend_var_run_32(u8 *dst, u32 *col, u32 count, u8 coverage, Bool rgb_order, Bool with_alpha)
+{
+	u32 i, nb = count - count % EVG_SIMD_PIXELS;
+#ifdef GPAC_HAS_SSE2
+	__m128i zero = _mm_setzero_si128();
+	__m128i one = _mm_set1_epi16(1);
+	__m128i c255 = _mm_set1_epi16(255);
+	__m128i c256 = _mm_set1_epi16(256);
+	__m128i cov = _mm_set1_epi16(coverage);
+	__m128i amask = _mm_set1_epi32((int) 0xFF000000);
+	__m128i amask16 = _mm_setr_epi16(0, 0, 0, -1, 0, 0, 0, -1);
+
+	for (i=0; i<nb; i+=4) {
+		__m128i s = _mm_loadu_si128((__m128i *) (col + i));
+		__m128i d, res, src_a, skip;
+		__m128i sh[2], dh[2], rh[2], eh[2];
+		u32 h;
+
+		skip = _mm_cmpeq_epi32(_mm_and_si128(s, amask), zero);
+		if (_mm_movemask_epi8(skip) == 0xFFFF) continue;
+
+		d = _mm_loadu_si128((__m128i *) (dst + 4*i));
+		sh[0] = _mm_unpacklo_epi8(s, zero);
+		sh[1] = _mm_unpackhi_epi8(s, zero);
+		dh[0] = _mm_unpacklo_epi8(d, zero);
+		dh[1] = _mm_unpackhi_epi8(d, zero);
+		for (h=0; h<2; h++) {
+			__m128i a, a1, S = sh[h], D = dh[h];
+			if (rgb_order) {
+				S = _mm_shufflelo_epi16(S, _MM_SHUFFLE(3, 0, 1, 2));
+				S = _mm_shufflehi_epi16(S, _MM_SHUFFLE(3, 0, 1, 2));
+			}
+			/*a = mul255(src alpha, coverage)*/
+			a = _mm_shufflelo_epi16(S, _MM_SHUFFLE(3, 3, 3, 3));
+			a = _mm_shufflehi_epi16(a, _MM_SHUFFLE(3, 3, 3, 3));
+			a = _mm_srli_epi16(_mm_mullo_epi16(_mm_add_epi16(a, one), cov), 8);
+			a1 = _mm_add_epi16(a, one);
+			rh[h] = _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(_mm_sub_epi16(c255, a), D), _mm_mullo_epi16(a1, S)), 8);
+			if (with_alpha) {
+				/*dst alpha = mul255(a, a) + mul255(255-a, dst alpha)*/
+				__m128i da = _mm_add_epi16(_mm_srli_epi16(_mm_mullo_epi16(a1, a), 8), _mm_srli_epi16(_mm_mullo_epi16(_mm_sub_epi16(c256, a), D), 8));
+				rh[h] = _mm_or_si128(_mm_and_si128(amask16, da), _mm_andnot_si128(amask16, rh[h]));
+				/*source color with blended alpha, used on empty destination pixels*/
+				eh[h] = _mm_or_si128(_mm_and_si128(amask16, a), _mm_andnot_si128(amask16, S));
+			}
+		}
+		res = _mm_packus_epi16(rh[0], rh[1]);
+		if (with_alpha) {
+			__m128i empty = _mm_cmpeq_epi32(_mm_and_si128(d, amask), zero);
+			src_a = _mm_packus_epi16(eh[0], eh[1]);
+			res = _mm_or_si128(_mm_and_si128(empty, src_a), _mm_andnot_si128(empty, res));
+		} else {
+			res = _mm_or_si128(res, amask);
+		}
+		res = _mm_or_si128(_mm_and_si128(skip, d), _mm_andnot_si128(skip, res));
+		_mm_storeu_si128((__m128i *) (dst + 4*i), res);
+	}
+#else
+	u32 c;
+	uint8x8_t zero = vdup_n_u8(0);
+	uint16x8_t one = vdupq_n_u16(1);
+	uint16x8_t c255 = vdupq_n_u16(255);
+	uint16x8_t c256 = vdupq_n_u16(256);
+	uint16x8_t cov = vdupq_n_u16(coverage);
+
+	for (i=0; i<nb; i+=8) {
+		uint8x8x4_t s = vld4_u8((u8 *) (col + i));
+		uint8x8x4_t d = vld4_u8(dst + 4*i);
+		uint8x8x4_t res;
+		uint8x8_t skip = vceq_u8(s.val[3], zero);
+		/*a = mul255(src alpha, coverage)*/
+		uint16x8_t a = vshrq_n_u16(vmulq_u16(vaddw_u8(one, s.val[3]), cov), 8);
+		uint16x8_t a1 = vaddq_u16(a, one);
+		uint16x8_t ia = vsubq_u16(c255, a);
+
+		if (rgb_order) {
+			uint8x8_t t = s.val[0];
+			s.val[0] = s.val[2];
+			s.val[2] = t;
+		}
+		for (c=0; c<3; c++) {
+			uint16x8_t v = vmlaq_u16(vmulq_u16(ia, vmovl_u8(d.val[c])), a1, vmovl_u8(s.val[c]));
+			res.val[c] = vshrn_n_u16(v, 8);
+		}
+		if (with_alpha) {
+			/*dst alpha = mul255(a, a) + mul255(255-a, dst alpha), empty destination pixels get the source color*/
+			uint8x8_t empty = vceq_u8(d.val[3], zero);
+			uint16x8_t da = vaddq_u16(vshrq_n_u16(vmulq_u16(a1, a), 8), vshrq_n_u16(vmulq_u16(vsubq_u16(c256, a), vmovl_u8(d.val[3])), 8));
+			res.val[3] = vmovn_u16(da);
+			for (c=0; c<3; c++)
+				res.val[c] = vbsl_u8(empty, s.val[c], res.val[c]);
+			res.val[3] = vbsl_u8(empty, vmovn_u16(a), res.val[3]);
+		} else {
+			res.val[3] = vdup_n_u8(0xFF);
+		}
+		for (c=0; c<4; c++)
+			res.val[c] = vbsl_u8(skip, d.val[c], res.val[c]);
+		vst4_u8(dst + 4*i, res);
+	}
+#endif
+	return nb;
+}
+
+#endif /*EVG_SIMD_SPANS*/
+
 /*
 		32 bit ARGB
 */
@@ -46,7 +252,7 @@ static void overmask_bgra(u32 src, u8 *dst, u32 alpha)
 	s32 dsta = dst[3];
 	srca = mul255(srca, alpha);
 	if (dsta) {
-		s32 dstr = dst[1];
+		s32 dstr = dst[2];
 		s32 dstg = dst[1];
 		s32 dstb = dst[0];
 		dst[0] = mul255(srca, srcb - dstb) + dstb;
@@ -68,6 +274,23 @@ static void overmask_bgra_const_run(u32 src, u8 *dst, s32 dst_pitch_x, u32 count
 	s32 srcg = (src >> 8) & 0xff;
 	s32 srcb = (src >> 0) & 0xff;
 
+#ifdef EVG_SIMD_SPANS
+	if ((dst_pitch_x==4) && (count>=EVG_SIMD_PIXELS)) {
+		u32 nb;
+		u16 mul[4], add[4], cst[4];
+		mul[0] = mul[1] = mul[2] = 255 - srca;
+		add[0] = (srca+1) * srcb;
+		add[1] = (srca+1) * srcg;
+		add[2] = (srca+1) * srcr;
+		cst[0] = cst[1] = cst[2] = 0;
+		mul[3] = 256 - srca;
+		add[3] = 0;
+		cst[3] = mul255(srca, srca);
+		nb = evg_blend_const_run_32(dst, count, mul, add, cst, GF_TRUE, evg_pix32(srcb, srcg, srcr, srca));
+		dst += 4*nb;
+		count -= nb;
+	}
+#endif
 
 	while (count) {
 		s32 dsta = dst[3];
@@ -82,7 +305,7 @@ static void overmask_bgra_const_run(u32 src, u8 *dst, s32 dst_pitch_x, u32 count
 			dst[2] = mul255(srca, srcr - dstr) + dstr;
 			dst[3] = mul255(srca, srca) + mul255(255-srca, dsta);
 		} else {
-			dst[0] = srcr;
+			dst[0] = srcb;
 			dst[1] = srcg;
 			dst[2] = srcr;
 			dst[3] = srca;
@@ -115,6 +338,13 @@ void evg_bgra_fill_const(s32 y, s32 count, EVG_Span *spans, EVGSurface *surf)
 			fin = (a<<24) | col_no_a;
 			overmask_bgra_const_run(fin, dst + x, surf->pitch_x, len);
 		} else {
+#ifdef EVG_SIMD_SPANS
+			if (surf->pitch_x==4) {
+				u32 nb = evg_fill_run_32(dst + x, evg_pix32(col_b, col_g, col_r, col_a), len);
+				x += 4*nb;
+				len -= nb;
+			}
+#endif
 			while (len--) {
 				dst[x] = col_b;
 				dst[x+1] = col_g;
@@ -157,6 +387,14 @@ void evg_bgra_fill_var(s32 y, s32 count, EVG_Span *spans, EVGSurface *surf)
 		surf->sten->fill_run(surf->sten, surf, spans[i].x, y, len);
 		x = spans[i].x * surf->pitch_x;
 		col = surf->stencil_pix_run;
+#ifdef EVG_SIMD_SPANS
+		if (surf->pitch_x==4) {
+			u32 nb = evg_blend_var_run_32(dst + x, col, len, spanalpha, GF_FALSE, GF_TRUE);
+			col += nb;
+			x += 4*nb;
+			len -= nb;
+		}
+#endif
 		while (len--) {
 			_col = *col;
 			col_a = GF_COL_A(_col);
@@ -204,7 +442,14 @@ GF_Err evg_surface_clear_bgra(GF_SURFACE surf, GF_IRect rc, GF_Color col)
 	if (!use_memset) {
 		for (y = 0; y < h; y++) {
 			data = (u8 *) _this ->pixels + (sy+y)* st + _this->pitch_x*sx;
-			for (x = 0; x < w; x++) {
+			x = 0;
+#ifdef EVG_SIMD_SPANS
+			if (_this->pitch_x==4) {
+				x = evg_fill_run_32(data, evg_pix32(col_b, col_g, col_r, col_a), w);
+				data += 4*x;
+			}
+#endif
+			for (; x < w; x++) {
 				data[0] = col_b;
 				data[1] = col_g;
 				data[2] = col_r;
@@ -252,6 +497,23 @@ GFINLINE static void overmask_bgrx_const_run(u32 src, u8 *dst, s32 dst_pitch_x,
 	u32 srcb = mul255(srca, ((src) & 0xff)) ;
 	u32 inva = 1 + 0xFF - srca;
 
+#ifdef EVG_SIMD_SPANS
+	if ((dst_pitch_x==4) && (count>=EVG_SIMD_PIXELS)) {
+		u32 nb;
+		u16 mul[4], add[4], cst[4];
+		mul[0] = mul[1] = mul[2] = inva;
+		add[0] = add[1] = add[2] = add[3] = 0;
+		cst[0] = srcb;
+		cst[1] = srcg;
+		cst[2] = srcr;
+		mul[3] = 0;
+		cst[3] = 0xFF;
+		nb = evg_blend_const_run_32(dst, count, mul, add, cst, GF_FALSE, 0);
+		dst += 4*nb;
+		count -= nb;
+	}
+#endif
+
 	while (count) {
 		dst[0] = srcb + ((inva*dst[0])>>8);
 		dst[1] = srcg + ((inva*dst[1])>>8);
@@ -284,6 +546,13 @@ void evg_bgrx_fill_const(s32 y, s32 count, EVG_Span *spans, EVGSurface *surf)
 			fin = (spana<<24) | col_no_a;
 			overmask_bgrx_const_run(fin, dst + x, surf->pitch_x, len);
 		} else {
+#ifdef EVG_SIMD_SPANS
+			if (surf->pitch_x==4) {
+				u32 nb = evg_fill_run_32(dst + x, evg_pix32(col_b, col_g, col_r, 0xFF), len);
+				x += 4*nb;
+				len -= nb;
+			}
+#endif
 			while (len--) {
 				dst[x] = col_b;
 				dst[x+1] = col_g;
@@ -326,6 +595,14 @@ void evg_bgrx_fill_var(s32 y, s32 count, EVG_Span *spans, EVGSurface *surf)
 		surf->sten->fill_run(surf->sten, surf, spans[i].x, y, len);
 		col = surf->stencil_pix_run;
 		x = spans[i].x * surf->pitch_x;
+#ifdef EVG_SIMD_SPANS
+		if (surf->pitch_x==4) {
+			u32 nb = evg_blend_var_run_32(dst + x, col, len, spanalpha, GF_FALSE, GF_FALSE);
+			col += nb;
+			x += 4*nb;
+			len -= nb;
+		}
+#endif
 		while (len--) {
 			u32 _col = *col;
 			col_a = GF_COL_A(_col);
@@ -375,6 +652,23 @@ GFINLINE static void overmask_rgbx_const_run(u32 src, u8 *dst, s32 dst_pitch_x,
 	u32 srcb = mul255(srca, ((src) & 0xff)) ;
 	u32 inva = 1 + 0xFF - srca;
 
+#ifdef EVG_SIMD_SPANS
+	if ((dst_pitch_x==4) && (count>=EVG_SIMD_PIXELS)) {
+		u32 nb;
+		u16 mul[4], add[4], cst[4];
+		mul[0] = mul[1] = mul[2] = inva;
+		add[0] = add[1] = add[2] = add[3] = 0;
+		cst[0] = srcr;
+		cst[1] = srcg;
+		cst[2] = srcb;
+		mul[3] = 256;
+		cst[3] = 0;
+		nb = evg_blend_const_run_32(dst, count, mul, add, cst, GF_FALSE, 0);
+		dst += 4*nb;
+		count -= nb;
+	}
+#endif
+
 	while (count) {
 		dst[0] = srcr + ((inva*dst[0])>>8);
 		dst[1] = srcg + ((inva*dst[1])>>8);
@@ -407,6 +701,13 @@ void evg_rgbx_fill_const(s32 y, s32 count, EVG_Span *spans, EVGSurface *surf)
 			fin = (spana<<24) | col_no_a;
 			overmask_rgbx_const_run(fin, dst + x, surf->pitch_x, len);
 		} else {
+#ifdef EVG_SIMD_SPANS
+			if (surf->pitch_x==4) {
+				u32 nb = evg_fill_run_32(dst + x, evg_pix32(r, g, b, 0xFF), len);
+				x += 4*nb;
+				len -= nb;
+			}
+#endif
 			while (len--) {
 				dst[x] = r;
 				dst[x+1] = g;
@@ -449,6 +750,14 @@ void evg_rgbx_fill_var(s32 y, s32 count, EVG_Span *spans, EVGSurface *surf)
 		surf->sten->fill_run(surf->sten, surf, spans[i].x, y, len);
 		col = surf->stencil_pix_run;
 		x = spans[i].x * surf->pitch_x;
+#ifdef EVG_SIMD_SPANS
+		if (surf->pitch_x==4) {
+			u32 nb = evg_blend_var_run_32(dst + x, col, len, spanalpha, GF_TRUE, GF_FALSE);
+			col += nb;
+			x += 4*nb;
+			len -= nb;
+		}
+#endif
 		while (len--) {
 			_col = *col;
 			col_a = GF_COL_A(_col);
@@ -487,7 +796,14 @@ GF_Err evg_surface_clear_rgbx(GF_SURFACE surf, GF_IRect rc, GF_Color col)
 	
 	for (y = 0; y < h; y++) {
 		u8 *data = (u8 *) _this ->pixels + (y + sy) * _this->pitch_y + st*sx;
-		for (x = 0; x < w; x++) {
+		x = 0;
+#ifdef EVG_SIMD_SPANS
+		if (st==4) {
+			x = evg_fill_run_32(data, evg_pix32(r, g, b, 0xFF), w);
+			data += 4*x;
+		}
+#endif
+		for (; x < w; x++) {
 			data[0] = r;
 			data[1] = g;
 			data[2] = b;
@@ -711,7 +1027,14 @@ GF_Err evg_surface_clear_rgba(GF_SURFACE surf, GF_IRect rc, GF_Color col)
 	if (!use_memset) {
 		for (y = 0; y < h; y++) {
 			data = (u8 *) _this ->pixels + (sy+y)* st + _this->pitch_x * rc.x;
-			for (x = 0; x < w; x++) {
+			x = 0;
+#ifdef EVG_SIMD_SPANS
+			if (_this->pitch_x==4) {
+				x = evg_fill_run_32(data, evg_pix32(r, g, b, a), w);
+				data += 4*x;
+			}
+#endif
+			for (; x < w; x++) {
 				*(data) = r;
 				*(data+1) = g;
 				*(data+2) = b;
@@ -26,12 +26,45 @@
 
 #include "rast_soft.h"
 
-/*we don't need any private context*/
+typedef struct
+{
+	Bool pool_init;
+	EVGThreadPool *pool;
+} EVGRasterCtx;
+
+/*the raster threads are created with the first surface, once the module is attached to its config*/
+EVGThreadPool *evg_get_thread_pool(GF_Raster2D *dr)
+{
+	u32 nb_threads = 0;
+	const char *opt;
+	EVGRasterCtx *ctx = (EVGRasterCtx *)dr->internal;
+	if (ctx->pool_init) return ctx->pool;
+	ctx->pool_init = GF_TRUE;
+
+	opt = gf_modules_get_option((GF_BaseInterface *)dr, "Compositor", "RasterThreads");
+	if (!opt) gf_modules_set_option((GF_BaseInterface *)dr, "Compositor", "RasterThreads", "0");
+	else if (!strcmp(opt, "auto")) {
+		GF_SystemRTInfo rti;
+		if (gf_sys_get_rti(0, &rti, GF_RTI_SYSTEM_MEMORY_ONLY)) nb_threads = rti.nb_cores;
+	} else {
+		nb_threads = atoi(opt);
+	}
+	ctx->pool = evg_thread_pool_new(nb_threads);
+	return ctx->pool;
+}
+
 GF_Raster2D *EVG_LoadRenderer()
 {
 	GF_Raster2D *dr;
+	EVGRasterCtx *ctx;
 	GF_SAFEALLOC(dr, GF_Raster2D);
 	if (!dr) return NULL;
+	GF_SAFEALLOC(ctx, EVGRasterCtx);
+	if (!ctx) {
+		gf_free(dr);
+		return NULL;
+	}
+	dr->internal = ctx;
 	GF_REGISTER_MODULE_INTERFACE(dr, GF_RASTER_2D_INTERFACE, "GPAC 2D Raster", "gpac distribution")
 
 
@@ -69,6 +102,9 @@ GF_Raster2D *EVG_LoadRenderer()
 
 void EVG_ShutdownRenderer(GF_Raster2D *dr)
 {
+	EVGRasterCtx *ctx = (EVGRasterCtx *)dr->internal;
+	evg_thread_pool_del(ctx->pool);
+	gf_free(ctx);
 	gf_free(dr);
 }
 
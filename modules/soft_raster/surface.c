@@ -26,6 +26,149 @@
 
 
 #include "rast_soft.h"
+#include <gpac/thread.h>
+
+/*tiled rasterization: fills covering at least EVG_TILED_MIN_AREA pixels are swept in bands of EVG_BAND_HEIGHT lines
+by the raster threads and the calling thread. Each band is owned by a single thread, and spans of a line are
+produced in the same order as in a single-threaded sweep, so the result is the same*/
+#define EVG_BAND_HEIGHT		16
+#define EVG_TILED_MIN_AREA	(128*128)
+
+typedef struct
+{
+	EVGThreadPool *pool;
+	GF_Thread *th;
+	/*copy of the surface being filled, using our own stencil run buffer*/
+	EVGSurface surf;
+	u32 *stencil_pix_run;
+	u32 pix_run_size;
+	Bool dead;
+} EVGRasterThread;
+
+struct _evg_thread_pool
+{
+	u32 nb_threads;
+	EVGRasterThread *threads;
+	/*one token per thread and per fill, one done notification per token*/
+	GF_Semaphore *start, *done;
+	GF_Mutex *mx;
+	Bool run;
+
+	/*fill being swept*/
+	EVGSurface *surf;
+	s32 next_line, nb_lines;
+};
+
+static void evg_pool_sweep(EVGThreadPool *pool, EVGSurface *surf)
+{
+	while (1) {
+		s32 first;
+		gf_mx_p(pool->mx);
+		first = pool->next_line;
+		pool->next_line += EVG_BAND_HEIGHT;
+		gf_mx_v(pool->mx);
+		if (first >= pool->nb_lines) break;
+
+		evg_raster_sweep(pool->surf->raster, first, MIN(first + EVG_BAND_HEIGHT, pool->nb_lines), surf->ftparams.gray_spans, surf);
+	}
+}
+
+static u32 evg_raster_thread_run(void *par)
+{
+	EVGRasterThread *th = (EVGRasterThread *)par;
+	EVGThreadPool *pool = th->pool;
+
+	while (1) {
+		gf_sema_wait(pool->start);
+		if (!pool->run) break;
+
+		memcpy(&th->surf, pool->surf, sizeof(EVGSurface));
+		if (th->pix_run_size < pool->surf->width + 2) {
+			th->pix_run_size = pool->surf->width + 2;
+			th->stencil_pix_run = (u32 *) gf_realloc(th->stencil_pix_run, sizeof(u32) * th->pix_run_size);
+		}
+		th->surf.stencil_pix_run = th->stencil_pix_run;
+		evg_pool_sweep(pool, &th->surf);
+		gf_sema_notify(pool->done, 1);
+	}
+	th->dead = GF_TRUE;
+	return 0;
+}
+
+EVGThreadPool *evg_thread_pool_new(u32 nb_threads)
+{
+	u32 i;
+	EVGThreadPool *pool;
+	/*the calling thread sweeps bands as well*/
+	if (nb_threads<2) return NULL;
+	GF_SAFEALLOC(pool, EVGThreadPool);
+	if (!pool) return NULL;
+	pool->nb_threads = nb_threads - 1;
+	pool->threads = (EVGRasterThread *) gf_malloc(sizeof(EVGRasterThread) * pool->nb_threads);
+	memset(pool->threads, 0, sizeof(EVGRasterThread) * pool->nb_threads);
+	pool->start = gf_sema_new(pool->nb_threads, 0);
+	pool->done = gf_sema_new(pool->nb_threads, 0);
+	pool->mx = gf_mx_new("RasterPool");
+	pool->run = GF_TRUE;
+	for (i=0; i<pool->nb_threads; i++) {
+		pool->threads[i].pool = pool;
+		pool->threads[i].th = gf_th_new("RasterThread");
+		gf_th_run(pool->threads[i].th, evg_raster_thread_run, &pool->threads[i]);
+	}
+	GF_LOG(GF_LOG_INFO, GF_LOG_COMPOSE, ("[Raster2D] Tiled rasterization using %d threads\n", nb_threads));
+	return pool;
+}
+
+void evg_thread_pool_del(EVGThreadPool *pool)
+{
+	u32 i;
+	if (!pool) return;
+	pool->run = GF_FALSE;
+	gf_sema_notify(pool->start, pool->nb_threads);
+	for (i=0; i<pool->nb_threads; i++) {
+		while (!pool->threads[i].dead) gf_sleep(1);
+		gf_th_del(pool->threads[i].th);
+		if (pool->threads[i].stencil_pix_run) gf_free(pool->threads[i].stencil_pix_run);
+	}
+	gf_free(pool->threads);
+	gf_sema_del(pool->start);
+	gf_sema_del(pool->done);
+	gf_mx_del(pool->mx);
+	gf_free(pool);
+}
+
+/*renders the current path, in parallel bands if the fill is large enough*/
+static void evg_surface_render(EVGSurface *surf)
+{
+	u32 i;
+	s32 nb_lines;
+	GF_Rect rc;
+	EVGThreadPool *pool = surf->pool;
+
+	/*callbacks of external raster targets are not thread-safe*/
+	if (!pool || surf->raster_cbk) {
+		evg_raster_render(surf->raster, &surf->ftparams);
+		return;
+	}
+	rc = surf->path_bounds;
+	gf_mx2d_apply_rect(&surf->mat, &rc);
+	if ((FIX2INT(rc.height) < 2*EVG_BAND_HEIGHT) || (FIX2INT(rc.width) * FIX2INT(rc.height) < EVG_TILED_MIN_AREA)) {
+		evg_raster_render(surf->raster, &surf->ftparams);
+		return;
+	}
+
+	nb_lines = evg_raster_decompose(surf->raster, &surf->ftparams);
+	if (nb_lines<=0) return;
+
+	pool->surf = surf;
+	pool->next_line = 0;
+	pool->nb_lines = nb_lines;
+	gf_sema_notify(pool->start, pool->nb_threads);
+	evg_pool_sweep(pool, surf);
+	for (i=0; i<pool->nb_threads; i++)
+		gf_sema_wait(pool->done);
+	pool->surf = NULL;
+}
 
 static void get_surface_world_matrix(EVGSurface *_this, GF_Matrix2D *mat)
 {
@@ -46,6 +189,7 @@ GF_SURFACE evg_surface_new(GF_Raster2D *_dr, Bool center_coords)
 		_this->ftparams.source = &_this->ftoutline;
 		_this->ftparams.user = _this;
 		_this->raster = evg_raster_new();
+		_this->pool = evg_get_thread_pool(_dr);
 	}
 	return _this;
 }
@@ -647,7 +791,7 @@ GF_Err evg_surface_fill(GF_SURFACE _this, GF_STENCIL stencil)
 	}
 
 	/*and call the raster*/
-	evg_raster_render(surf->raster, &surf->ftparams);
+	evg_surface_render(surf);
 
 	/*restore stencil matrix*/
 	if (sten->type != GF_STENCIL_SOLID) {
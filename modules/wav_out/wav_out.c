@@ -104,6 +104,7 @@ typedef struct {
 #endif
 
 const static GUID  GPAC_KSDATAFORMAT_SUBTYPE_PCM = {0x00000001,0x0000,0x0010, {0x80,0x00,0x00,0xaa,0x00,0x38,0x9b,0x71} };
+const static GUID  GPAC_KSDATAFORMAT_SUBTYPE_IEEE_FLOAT = {0x00000003,0x0000,0x0010, {0x80,0x00,0x00,0xaa,0x00,0x38,0x9b,0x71} };
 
 #pragma message("Using multichannel audio extensions")
 
@@ -195,6 +196,10 @@ static void WAV_Shutdown(GF_AudioOutput *dr)
 
 
 /*we assume what was asked is what we got*/
+#ifndef WAVE_FORMAT_IEEE_FLOAT
+#define WAVE_FORMAT_IEEE_FLOAT	0x0003
+#endif
+
 static GF_Err WAV_ConfigureOutput(GF_AudioOutput *dr, u32 *SampleRate, u32 *NbChannels, u32 *nbBitsPerSample, u32 channel_cfg)
 {
 	u32 i, retry;
@@ -217,7 +222,8 @@ static GF_Err WAV_ConfigureOutput(GF_AudioOutput *dr, u32 *SampleRate, u32 *NbCh
 
 	memset (&ctx->fmt, 0, sizeof(ctx->fmt));
 	ctx->fmt.cbSize = sizeof(WAVEFORMATEX);
-	ctx->fmt.wFormatTag = WAVE_FORMAT_PCM;
+	/*32 bits samples are float*/
+	ctx->fmt.wFormatTag = (*nbBitsPerSample==32) ? WAVE_FORMAT_IEEE_FLOAT : WAVE_FORMAT_PCM;
 	ctx->fmt.nChannels = *NbChannels;
 	ctx->fmt.wBitsPerSample = *nbBitsPerSample;
 	ctx->fmt.nSamplesPerSec = *SampleRate;
@@ -231,7 +237,7 @@ static GF_Err WAV_ConfigureOutput(GF_AudioOutput *dr, u32 *SampleRate, u32 *NbCh
 		format_ex.Format = ctx->fmt;
 		format_ex.Format.cbSize = 22;
 		format_ex.Format.wFormatTag = WAVE_FORMAT_EXTENSIBLE;
-		format_ex.SubFormat = GPAC_KSDATAFORMAT_SUBTYPE_PCM;
+		format_ex.SubFormat = (*nbBitsPerSample==32) ? GPAC_KSDATAFORMAT_SUBTYPE_IEEE_FLOAT : GPAC_KSDATAFORMAT_SUBTYPE_PCM;
 		format_ex.Samples.wValidBitsPerSample = ctx->fmt.wBitsPerSample;
 		format_ex.dwChannelMask = 0;
 		if (channel_cfg & GF_AUDIO_CH_FRONT_LEFT) format_ex.dwChannelMask |= SPEAKER_FRONT_LEFT;
@@ -250,11 +256,16 @@ static GF_Err WAV_ConfigureOutput(GF_AudioOutput *dr, u32 *SampleRate, u32 *NbCh
 	/* Open a waveform device for output using window callback. */
 	retry = 10;
 	while (retry) {
-		hr = waveOutOpen((LPHWAVEOUT)&ctx->hwo, WAVE_MAPPER, &ctx->fmt, (DWORD_PTR) WaveProc, (DWORD_PTR) dr,
+		hr = waveOutOpen((LPHWAVEOUT)&ctx->hwo, WAVE_MAPPER, fmt, (DWORD_PTR) WaveProc, (DWORD_PTR) dr,
 		                 CALLBACK_FUNCTION | WAVE_ALLOWSYNC | WAVE_FORMAT_DIRECT
 		                );
 
 		if (hr == MMSYSERR_NOERROR) break;
+		/*device cannot play float samples, let the mixer convert to 16 bits*/
+		if ((hr == WAVERR_BADFORMAT) && (*nbBitsPerSample==32)) {
+			*nbBitsPerSample = 16;
+			return WAV_ConfigureOutput(dr, SampleRate, NbChannels, nbBitsPerSample, channel_cfg);
+		}
 		/*couldn't open audio*/
 		if (hr != MMSYSERR_ALLOCATED) return GF_IO_ERR;
 		retry--;
@@ -91,7 +91,7 @@ static char *gf_audio_input_fetch_frame(void *callback, u32 *size, u32 audio_del
 
 	gf_mo_get_object_time(ai->stream, &obj_time);
 	obj_time += audio_delay_ms;
-	if (ai->compositor->bench_mode) {
+	if (ai->compositor->bench_mode || ai->compositor->virtual_clock) {
 		drift = 0;
 	} else {
 		drift = (s32)obj_time;
@@ -28,6 +28,23 @@
 /*max number of channels we support in mixer*/
 #define GF_SR_MAX_CHANNELS	16
 
+/*polyphase resampler: number of filter taps (multiple of 8) and of filter phases*/
+#define GF_MIX_FIR_TAPS	32
+#define GF_MIX_FIR_PHASES	256
+/*filter coefficients precision in bits*/
+#define GF_MIX_FIR_BITS	14
+
+/*when outputing float samples, mixing is done on 24 bits (16 bits samples shifted by GF_MIX_FLT_SHIFT).
+Float input samples are clamped to +/- GF_MIX_FLT_MAX to leave room for channel downmix and mixing*/
+#define GF_MIX_FLT_SHIFT	8
+#define GF_MIX_FLT_MAX	8.0f
+
+#if defined(GPAC_HAS_SSE2)
+# include <emmintrin.h>
+#elif defined(GPAC_HAS_NEON)
+# include <arm_neon.h>
+#endif
+
 /*
 	Notes about the mixer:
 	1- spatialization is out of scope for the mixer (eg that's the sound node responsability)
@@ -51,9 +68,20 @@ typedef struct
 	u32 in_bytes_used, out_samples_written, out_samples_to_write;
 
 	Fixed speed;
-	Fixed pan[6];
+	Fixed pan[GF_SR_MAX_CHANNELS];
 
 	Bool muted;
+
+	/*polyphase resampler state: last input samples of each channel, stored twice so that the filter window
+	is always contiguous, window start index and position of next output sample in 1/sample_rate input samples*/
+	s16 fir_hist[GF_SR_MAX_CHANNELS][2*GF_MIX_FIR_TAPS];
+	/*same for float or 24 bits mixing*/
+	Float fir_hist_flt[GF_SR_MAX_CHANNELS][2*GF_MIX_FIR_TAPS];
+	u32 fir_idx, fir_frac;
+	/*filter coefficients for the current resampling step*/
+	s16 *fir_coefs;
+	Float *fir_coefs_flt;
+	u32 fir_coefs_step, fir_coefs_sr;
 } MixerInput;
 
 struct __audiomix
@@ -74,8 +102,11 @@ struct __audiomix
 	/*set to non null if this outputs directly to the driver, in which case audio formats have to be checked*/
 	struct _audio_render *ar;
 
+	/*mixing buffer, one plane of s32 samples per output channel*/
 	s32 *output;
 	u32 output_size;
+
+	Bool polyphase;
 };
 
 GF_EXPORT
@@ -121,6 +152,8 @@ void gf_mixer_remove_all(GF_AudioMixer *am)
 		for (j=0; j<GF_SR_MAX_CHANNELS; j++) {
 			if (in->ch_buf[j]) gf_free(in->ch_buf[j]);
 		}
+		if (in->fir_coefs) gf_free(in->fir_coefs);
+		if (in->fir_coefs_flt) gf_free(in->fir_coefs_flt);
 		gf_free(in);
 	}
 	am->isEmpty = GF_TRUE;
@@ -152,6 +185,20 @@ u32 gf_mixer_get_block_align(GF_AudioMixer *am)
 	return am->nb_channels*am->bits_per_sample/8;
 }
 
+void gf_mixer_set_polyphase_resampling(GF_AudioMixer *am, Bool polyphase)
+{
+	u32 i;
+	MixerInput *in;
+	gf_mixer_lock(am, GF_TRUE);
+	am->polyphase = polyphase;
+	/*restart resampling of all inputs*/
+	i=0;
+	while ((in = (MixerInput *)gf_list_enum(am->sources, &i))) {
+		in->has_prev = GF_FALSE;
+	}
+	gf_mixer_lock(am, GF_FALSE);
+}
+
 GF_EXPORT
 void gf_mixer_lock(GF_AudioMixer *am, Bool lockIt)
 {
@@ -201,6 +248,8 @@ void gf_mixer_remove_input(GF_AudioMixer *am, GF_AudioInterface *src)
 		for (j=0; j<GF_SR_MAX_CHANNELS; j++) {
 			if (in->ch_buf[j]) gf_free(in->ch_buf[j]);
 		}
+		if (in->fir_coefs) gf_free(in->fir_coefs);
+		if (in->fir_coefs_flt) gf_free(in->fir_coefs_flt);
 		gf_free(in);
 		break;
 	}
@@ -461,13 +510,314 @@ static GFINLINE void gf_mixer_map_channels(s32 *inChan, u32 nb_in, u32 in_cfg, u
 }
 
 
+/*dot product of GF_MIX_FIR_TAPS input samples with filter coefficients*/
+static GFINLINE s32 gf_mixer_fir_dot(const s16 *samples, const s16 *coefs)
+{
+#if defined(GPAC_HAS_SSE2)
+	u32 i;
+	__m128i acc = _mm_setzero_si128();
+	for (i=0; i<GF_MIX_FIR_TAPS; i+=8) {
+		acc = _mm_add_epi32(acc, _mm_madd_epi16(_mm_loadu_si128((const __m128i *) (samples+i)), _mm_loadu_si128((const __m128i *) (coefs+i))));
+	}
+	acc = _mm_add_epi32(acc, _mm_shuffle_epi32(acc, _MM_SHUFFLE(1,0,3,2)));
+	acc = _mm_add_epi32(acc, _mm_shuffle_epi32(acc, _MM_SHUFFLE(2,3,0,1)));
+	return _mm_cvtsi128_si32(acc);
+#elif defined(GPAC_HAS_NEON)
+	u32 i;
+	int32x2_t sum;
+	int32x4_t acc = vdupq_n_s32(0);
+	for (i=0; i<GF_MIX_FIR_TAPS; i+=4) {
+		acc = vmlal_s16(acc, vld1_s16(samples+i), vld1_s16(coefs+i));
+	}
+	sum = vadd_s32(vget_low_s32(acc), vget_high_s32(acc));
+	return vget_lane_s32(vpadd_s32(sum, sum), 0);
+#else
+	u32 i;
+	s32 res = 0;
+	for (i=0; i<GF_MIX_FIR_TAPS; i++) res += samples[i] * coefs[i];
+	return res;
+#endif
+}
+
+/*dot product of GF_MIX_FIR_TAPS float input samples with filter coefficients*/
+static GFINLINE Float gf_mixer_fir_dot_flt(const Float *samples, const Float *coefs)
+{
+#if defined(GPAC_HAS_SSE2)
+	u32 i;
+	__m128 acc = _mm_setzero_ps();
+	for (i=0; i<GF_MIX_FIR_TAPS; i+=4) {
+		acc = _mm_add_ps(acc, _mm_mul_ps(_mm_loadu_ps(samples+i), _mm_loadu_ps(coefs+i)));
+	}
+	acc = _mm_add_ps(acc, _mm_movehl_ps(acc, acc));
+	acc = _mm_add_ss(acc, _mm_shuffle_ps(acc, acc, _MM_SHUFFLE(1,1,1,1)));
+	return _mm_cvtss_f32(acc);
+#elif defined(GPAC_HAS_NEON)
+	u32 i;
+	float32x2_t sum;
+	float32x4_t acc = vdupq_n_f32(0);
+	for (i=0; i<GF_MIX_FIR_TAPS; i+=4) {
+		acc = vmlaq_f32(acc, vld1q_f32(samples+i), vld1q_f32(coefs+i));
+	}
+	sum = vadd_f32(vget_low_f32(acc), vget_high_f32(acc));
+	return vget_lane_f32(vpadd_f32(sum, sum), 0);
+#else
+	u32 i;
+	Float res = 0;
+	for (i=0; i<GF_MIX_FIR_TAPS; i++) res += samples[i] * coefs[i];
+	return res;
+#endif
+}
+
+/*converts a float input sample to the mixer scale*/
+static GFINLINE s32 gf_mixer_flt_to_s32(Float samp, Float scale)
+{
+	if (samp > GF_MIX_FLT_MAX) samp = GF_MIX_FLT_MAX;
+	else if (samp < -GF_MIX_FLT_MAX) samp = -GF_MIX_FLT_MAX;
+	return (s32) (samp * scale);
+}
+
+/*adds nb_samples of src to dst*/
+static void gf_mixer_add_plane(s32 *dst, const s32 *src, u32 nb_samples)
+{
+	u32 i = 0;
+#if defined(GPAC_HAS_SSE2)
+	for (; i + 4 <= nb_samples; i += 4) {
+		__m128i d = _mm_loadu_si128((const __m128i *) (dst+i));
+		_mm_storeu_si128((__m128i *) (dst+i), _mm_add_epi32(d, _mm_loadu_si128((const __m128i *) (src+i))));
+	}
+#elif defined(GPAC_HAS_NEON)
+	for (; i + 4 <= nb_samples; i += 4) {
+		vst1q_s32(dst+i, vaddq_s32(vld1q_s32(dst+i), vld1q_s32(src+i)));
+	}
+#endif
+	for (; i<nb_samples; i++) dst[i] += src[i];
+}
+
+/*interleaves the mixed channel planes into the 16 bit output, with saturation*/
+static void gf_mixer_write_s16(s16 *out, s32 *planes, u32 plane_size, u32 nb_ch, u32 nb_samples)
+{
+	u32 i = 0, j;
+#if defined(GPAC_HAS_SSE2)
+	if (nb_ch==1) {
+		for (; i + 8 <= nb_samples; i += 8) {
+			__m128i a = _mm_loadu_si128((const __m128i *) (planes+i));
+			__m128i b = _mm_loadu_si128((const __m128i *) (planes+i+4));
+			_mm_storeu_si128((__m128i *) (out+i), _mm_packs_epi32(a, b));
+		}
+	} else if (nb_ch==2) {
+		s32 *right = planes + plane_size;
+		for (; i + 4 <= nb_samples; i += 4) {
+			__m128i l = _mm_loadu_si128((const __m128i *) (planes+i));
+			__m128i r = _mm_loadu_si128((const __m128i *) (right+i));
+			_mm_storeu_si128((__m128i *) (out+2*i), _mm_packs_epi32(_mm_unpacklo_epi32(l, r), _mm_unpackhi_epi32(l, r)));
+		}
+	}
+#elif defined(GPAC_HAS_NEON)
+	if (nb_ch==1) {
+		for (; i + 4 <= nb_samples; i += 4) {
+			vst1_s16(out+i, vqmovn_s32(vld1q_s32(planes+i)));
+		}
+	} else if (nb_ch==2) {
+		s32 *right = planes + plane_size;
+		for (; i + 4 <= nb_samples; i += 4) {
+			int16x4x2_t lr;
+			lr.val[0] = vqmovn_s32(vld1q_s32(planes+i));
+			lr.val[1] = vqmovn_s32(vld1q_s32(right+i));
+			vst2_s16(out+2*i, lr);
+		}
+	}
+#endif
+	for (; i<nb_samples; i++) {
+		for (j=0; j<nb_ch; j++) {
+			s32 samp = planes[j*plane_size + i];
+			if (samp > GF_SHORT_MAX) samp = GF_SHORT_MAX;
+			else if (samp < GF_SHORT_MIN) samp = GF_SHORT_MIN;
+			out[nb_ch*i + j] = samp;
+		}
+	}
+}
+
+/*interleaves the mixed channel planes (24 bits scale) into the float output - float samples are not clipped*/
+static void gf_mixer_write_flt(Float *out, s32 *planes, u32 plane_size, u32 nb_ch, u32 nb_samples)
+{
+	u32 i = 0, j;
+	const Float scale = 1.0f / (1 << (15 + GF_MIX_FLT_SHIFT));
+#if defined(GPAC_HAS_SSE2)
+	const __m128 vscale = _mm_set1_ps(scale);
+	if (nb_ch==1) {
+		for (; i + 4 <= nb_samples; i += 4) {
+			_mm_storeu_ps(out+i, _mm_mul_ps(_mm_cvtepi32_ps(_mm_loadu_si128((const __m128i *) (planes+i))), vscale));
+		}
+	} else if (nb_ch==2) {
+		s32 *right = planes + plane_size;
+		for (; i + 4 <= nb_samples; i += 4) {
+			__m128 l = _mm_mul_ps(_mm_cvtepi32_ps(_mm_loadu_si128((const __m128i *) (planes+i))), vscale);
+			__m128 r = _mm_mul_ps(_mm_cvtepi32_ps(_mm_loadu_si128((const __m128i *) (right+i))), vscale);
+			_mm_storeu_ps(out+2*i, _mm_unpacklo_ps(l, r));
+			_mm_storeu_ps(out+2*i+4, _mm_unpackhi_ps(l, r));
+		}
+	}
+#elif defined(GPAC_HAS_NEON)
+	if (nb_ch==1) {
+		for (; i + 4 <= nb_samples; i += 4) {
+			vst1q_f32(out+i, vmulq_n_f32(vcvtq_f32_s32(vld1q_s32(planes+i)), scale));
+		}
+	} else if (nb_ch==2) {
+		s32 *right = planes + plane_size;
+		for (; i + 4 <= nb_samples; i += 4) {
+			float32x4x2_t lr;
+			lr.val[0] = vmulq_n_f32(vcvtq_f32_s32(vld1q_s32(planes+i)), scale);
+			lr.val[1] = vmulq_n_f32(vcvtq_f32_s32(vld1q_s32(right+i)), scale);
+			vst2q_f32(out+2*i, lr);
+		}
+	}
+#endif
+	for (; i<nb_samples; i++) {
+		for (j=0; j<nb_ch; j++) {
+			out[nb_ch*i + j] = planes[j*plane_size + i] * scale;
+		}
+	}
+}
+
+/*builds the windowed-sinc (Blackman) filter bank for the given resampling step (in 1/sample_rate input samples).
+When downsampling, the cutoff frequency is lowered to the output Nyquist frequency to avoid aliasing*/
+static void gf_mixer_setup_fir(MixerInput *in, u32 step, u32 sample_rate, Bool use_float)
+{
+	u32 p, k;
+	Double cutoff = 0.95;
+	if (step > sample_rate) cutoff *= (Double) sample_rate / step;
+
+	/*only one of the integer or float filter banks is valid at a time*/
+	if (use_float) {
+		if (in->fir_coefs) gf_free(in->fir_coefs);
+		in->fir_coefs = NULL;
+		if (!in->fir_coefs_flt) in->fir_coefs_flt = (Float *) gf_malloc(sizeof(Float) * (GF_MIX_FIR_PHASES+1) * GF_MIX_FIR_TAPS);
+	} else {
+		if (in->fir_coefs_flt) gf_free(in->fir_coefs_flt);
+		in->fir_coefs_flt = NULL;
+		if (!in->fir_coefs) in->fir_coefs = (s16 *) gf_malloc(sizeof(s16) * (GF_MIX_FIR_PHASES+1) * GF_MIX_FIR_TAPS);
+	}
+	in->fir_coefs_step = step;
+	in->fir_coefs_sr = sample_rate;
+
+	for (p=0; p<=GF_MIX_FIR_PHASES; p++) {
+		Double c[GF_MIX_FIR_TAPS], sum = 0;
+		s32 isum = 0, max_k = 0;
+		s16 *coefs;
+		for (k=0; k<GF_MIX_FIR_TAPS; k++) {
+			/*distance between the tap and the output sample position, located between taps TAPS/2-1 and TAPS/2*/
+			Double x = (Double) k - (GF_MIX_FIR_TAPS/2 - 1) - (Double) p / GF_MIX_FIR_PHASES;
+			Double w = 0.42 + 0.5 * cos(GF_PI * x / (GF_MIX_FIR_TAPS/2)) + 0.08 * cos(2 * GF_PI * x / (GF_MIX_FIR_TAPS/2));
+			if ((x <= -GF_MIX_FIR_TAPS/2) || (x >= GF_MIX_FIR_TAPS/2)) w = 0;
+			c[k] = x ? w * sin(GF_PI * cutoff * x) / (GF_PI * x) : cutoff;
+			sum += c[k];
+		}
+		if (use_float) {
+			for (k=0; k<GF_MIX_FIR_TAPS; k++) in->fir_coefs_flt[p*GF_MIX_FIR_TAPS + k] = (Float) (c[k] / sum);
+			continue;
+		}
+		coefs = in->fir_coefs + p*GF_MIX_FIR_TAPS;
+		/*normalize to unity gain, putting the rounding error on the largest tap*/
+		for (k=0; k<GF_MIX_FIR_TAPS; k++) {
+			coefs[k] = (s16) floor(c[k] * (1<<GF_MIX_FIR_BITS) / sum + 0.5);
+			isum += coefs[k];
+			if (coefs[k] > coefs[max_k]) max_k = k;
+		}
+		coefs[max_k] += (1<<GF_MIX_FIR_BITS) - isum;
+	}
+}
+
+/*reads input sample idx at the mixer scale*/
+static GFINLINE s32 gf_mixer_get_sample(s16 *in_s16, s8 *in_s8, Float *in_flt, u32 idx, s32 mul, Float flt_scale)
+{
+	if (in_s16) return in_s16[idx] * mul;
+	if (in_flt) return gf_mixer_flt_to_s32(in_flt[idx], flt_scale);
+	return in_s8[idx] * mul;
+}
+
+/*polyphase resampling of the input, each output sample being filtered from the GF_MIX_FIR_TAPS surrounding input samples.
+Input samples are pushed to the filter history as they are needed so that the filter state is kept across input frames.
+Float inputs and 24 bits mixing use a float filter to keep the extra precision*/
+static void gf_mixer_fetch_input_polyphase(GF_AudioMixer *am, MixerInput *in, s16 *in_s16, s8 *in_s8, Float *in_flt, u32 src_samp, u32 src_size, u32 step, s32 mul, Float flt_scale)
+{
+	u32 j, in_ch, out_ch, consumed, one;
+	Bool use_float;
+	s32 inChan[GF_SR_MAX_CHANNELS];
+
+	in_ch = in->src->chan;
+	out_ch = am->nb_channels;
+	/*one input sample*/
+	one = am->sample_rate;
+	use_float = (in_flt || (mul != 1)) ? GF_TRUE : GF_FALSE;
+
+	if ((in->fir_coefs_step != step) || (in->fir_coefs_sr != one) || (use_float ? !in->fir_coefs_flt : !in->fir_coefs))
+		gf_mixer_setup_fir(in, step, one, use_float);
+	if (!in->has_prev) {
+		if (use_float) memset(in->fir_hist_flt, 0, sizeof(in->fir_hist_flt));
+		else memset(in->fir_hist, 0, sizeof(in->fir_hist));
+		in->fir_idx = 0;
+		in->fir_frac = one;
+		in->has_prev = GF_TRUE;
+	}
+
+	consumed = 0;
+	while (1) {
+		u32 phase;
+		/*push input samples until the output position is between the two center taps*/
+		while (in->fir_frac >= one) {
+			u32 idx = in->fir_idx;
+			if (consumed == src_samp) break;
+			if (use_float) {
+				for (j=0; j<in_ch; j++) {
+					Float v = (Float) gf_mixer_get_sample(in_s16, in_s8, in_flt, in_ch*consumed + j, mul, flt_scale);
+					in->fir_hist_flt[j][idx] = in->fir_hist_flt[j][idx + GF_MIX_FIR_TAPS] = v;
+				}
+			} else {
+				for (j=0; j<in_ch; j++) {
+					s16 v = in_s16 ? in_s16[in_ch*consumed + j] : in_s8[in_ch*consumed + j];
+					in->fir_hist[j][idx] = in->fir_hist[j][idx + GF_MIX_FIR_TAPS] = v;
+				}
+			}
+			in->fir_idx = (idx + 1) % GF_MIX_FIR_TAPS;
+			in->fir_frac -= one;
+			consumed++;
+		}
+		/*input frame exhausted*/
+		if (in->fir_frac >= one) break;
+
+		phase = (u32) (((u64) in->fir_frac * GF_MIX_FIR_PHASES + one/2) / one) * GF_MIX_FIR_TAPS;
+		if (use_float) {
+			for (j=0; j<in_ch; j++) {
+				inChan[j] = (s32) gf_mixer_fir_dot_flt(&in->fir_hist_flt[j][in->fir_idx], in->fir_coefs_flt + phase);
+			}
+		} else {
+			for (j=0; j<in_ch; j++) {
+				inChan[j] = gf_mixer_fir_dot(&in->fir_hist[j][in->fir_idx], in->fir_coefs + phase) >> GF_MIX_FIR_BITS;
+			}
+		}
+		gf_mixer_map_channels(inChan, in_ch, in->src->ch_cfg, out_ch, am->channel_cfg);
+		for (j=0; j<out_ch ; j++) {
+			*(in->ch_buf[j] + in->out_samples_written) = (s32) ((s64) inChan[j] * FIX2INT(100*in->pan[j]) / 100 );
+		}
+		in->fir_frac += step;
+
+		in->out_samples_written ++;
+		if (in->out_samples_written == in->out_samples_to_write) break;
+	}
+
+	in->in_bytes_used = (consumed==src_samp) ? src_size : consumed * in->src->bps * in_ch / 8;
+	/*cf gf_mixer_fetch_input*/
+	in->in_bytes_used += 1;
+}
+
 static void gf_mixer_fetch_input(GF_AudioMixer *am, MixerInput *in, u32 audio_delay)
 {
 	u32 i, j, in_ch, out_ch, prev, next, src_samp, ratio, src_size;
 	Bool use_prev;
 	s16 *in_s16;
 	s8 *in_s8;
-	s32 frac, inChan[GF_SR_MAX_CHANNELS], inChanNext[GF_SR_MAX_CHANNELS];
+	Float *in_flt, flt_scale;
+	s32 frac, mul, inChan[GF_SR_MAX_CHANNELS], inChanNext[GF_SR_MAX_CHANNELS];
 
 	in_s8 = (s8 *) in->src->FetchFrame(in->src->callback, &src_size, audio_delay);
 	if (!in_s8 || !src_size) {
@@ -481,18 +831,33 @@ static void gf_mixer_fetch_input(GF_AudioMixer *am, MixerInput *in, u32 audio_de
 	src_samp = (u32) (src_size * 8 / in->src->bps / in->src->chan);
 	in_ch = in->src->chan;
 	out_ch = am->nb_channels;
-	if (in->src->bps == 8) {
-		in_s16 = NULL;
-	} else {
+	in_s16 = NULL;
+	in_flt = NULL;
+	if (in->src->bps == 32) {
+		in_flt = (Float *) in_s8;
+		in_s8 = NULL;
+	} else if (in->src->bps != 8) {
 		in_s16 = (s16 *) in_s8;
 		in_s8 = NULL;
 	}
+	/*scale of input samples: 24 bits when outputing float, 16 bits otherwise*/
+	mul = (am->bits_per_sample == 32) ? (1<<GF_MIX_FLT_SHIFT) : 1;
+	flt_scale = (Float) (1 << 15) * mul;
+
+	if (am->polyphase) {
+		/*input samples per output sample, in 1/sample_rate units*/
+		u32 step = (u32) (FIX2FLT(in->speed) * in->src->samplerate + 0.5);
+		if (step && (step != am->sample_rate)) {
+			gf_mixer_fetch_input_polyphase(am, in, in_s16, in_s8, in_flt, src_samp, src_size, step, mul, flt_scale);
+			return;
+		}
+	}
 
 	/*just in case, if only 1 sample available in src, copy over and discard frame since we cannot
 	interpolate audio*/
 	if (src_samp==1) {
 		in->has_prev = GF_TRUE;
-		for (j=0; j<in_ch; j++) in->last_channels[j] = in_s16 ? in_s16[j] : in_s8[j];
+		for (j=0; j<in_ch; j++) in->last_channels[j] = gf_mixer_get_sample(in_s16, in_s8, in_flt, j, mul, flt_scale);
 		in->in_bytes_used = src_size;
 		return;
 	}
@@ -514,22 +879,28 @@ static void gf_mixer_fetch_input(GF_AudioMixer *am, MixerInput *in, u32 audio_de
 
 		if (in_s16) {
 			for (j=0; j<in_ch; j++) {
-				inChan[j] = use_prev ? in->last_channels[j] : in_s16[in_ch*prev + j];
-				inChanNext[j] = in_s16[in_ch*next + j];
-				inChan[j] = (frac*inChanNext[j] + (255-frac)*inChan[j]) / 255;
+				inChan[j] = use_prev ? in->last_channels[j] : in_s16[in_ch*prev + j] * mul;
+				inChanNext[j] = in_s16[in_ch*next + j] * mul;
+				inChan[j] = (s32) (((s64) frac*inChanNext[j] + (s64) (255-frac)*inChan[j]) / 255);
+			}
+		} else if (in_flt) {
+			for (j=0; j<in_ch; j++) {
+				inChan[j] = use_prev ? in->last_channels[j] : gf_mixer_flt_to_s32(in_flt[in_ch*prev + j], flt_scale);
+				inChanNext[j] = gf_mixer_flt_to_s32(in_flt[in_ch*next + j], flt_scale);
+				inChan[j] = (s32) (((s64) frac*inChanNext[j] + (s64) (255-frac)*inChan[j]) / 255);
 			}
 		} else {
 			for (j=0; j<in_ch; j++) {
-				inChan[j] = use_prev ? in->last_channels[j] : in_s8[in_ch*prev + j];
-				inChanNext[j] = in_s8[in_ch*next + j];
-				inChan[j] = (frac*inChanNext[j] + (255-frac)*inChan[j]) / 255;
+				inChan[j] = use_prev ? in->last_channels[j] : in_s8[in_ch*prev + j] * mul;
+				inChanNext[j] = in_s8[in_ch*next + j] * mul;
+				inChan[j] = (s32) (((s64) frac*inChanNext[j] + (s64) (255-frac)*inChan[j]) / 255);
 			}
 		}
 
 		gf_mixer_map_channels(inChan, in_ch, in->src->ch_cfg, out_ch, am->channel_cfg);
 		//Fixe me - we nee to uderstand how to map pan from N channels to K channels ...
 		for (j=0; j<out_ch ; j++) {
-			*(in->ch_buf[j] + in->out_samples_written) = (s32) (inChan[j] * FIX2INT(100*in->pan[j]) / 100 );
+			*(in->ch_buf[j] + in->out_samples_written) = (s32) ((s64) inChan[j] * FIX2INT(100*in->pan[j]) / 100 );
 		}
 
 		in->out_samples_written ++;
@@ -558,8 +929,8 @@ static void gf_mixer_fetch_input(GF_AudioMixer *am, MixerInput *in, u32 audio_de
 				u32 idx;
 				idx = (prev>=src_samp) ? in_ch*(src_samp-1) : in_ch*prev;
 				for (j=0; j<in_ch; j++) {
-					assert(idx + j < src_size/2);
-					in->last_channels[j] = in_s16 ? in_s16[idx + j] : in_s8[idx + j];
+					assert(idx + j < src_size * 8 / in->src->bps);
+					in->last_channels[j] = gf_mixer_get_sample(in_s16, in_s8, in_flt, idx + j, mul, flt_scale);
 				}
 			}
 		}
@@ -568,14 +939,24 @@ static void gf_mixer_fetch_input(GF_AudioMixer *am, MixerInput *in, u32 audio_de
 	in->in_bytes_used += 1;
 }
 
+/*audio interfaces only give the volume of the first 6 channels, the extra channels of 7.1 layouts use the
+volume of the back channels*/
+static Bool gf_mixer_get_channel_volume(GF_AudioInterface *src, Fixed *pan)
+{
+	u32 i;
+	Bool res = src->GetChannelVolume(src->callback, pan);
+	for (i=6; i<GF_SR_MAX_CHANNELS; i++) pan[i] = pan[4 + i%2];
+	return res;
+}
+
 GF_EXPORT
 u32 gf_mixer_get_output(GF_AudioMixer *am, void *buffer, u32 buffer_size, u32 delay)
 {
 	MixerInput *in, *single_source;
-	Fixed pan[6];
+	Fixed pan[GF_SR_MAX_CHANNELS];
 	Bool is_muted, force_mix;
 	u32 i, j, count, size, in_size, nb_samples, nb_written;
-	s32 *out_mix, nb_act_src;
+	s32 nb_act_src;
 	char *data, *ptr;
 
 	//reset buffer whatever the state of the mixer is
@@ -612,8 +993,9 @@ u32 gf_mixer_get_output(GF_AudioMixer *am, void *buffer, u32 buffer_size, u32 de
 	/*note we don't check output cfg: if the number of channel is the same then the channel cfg is the
 	same*/
 	if (single_source->src->chan != am->nb_channels) goto do_mix;
+	if (single_source->src->bps != am->bits_per_sample) goto do_mix;
 	if (single_source->src->GetSpeed(single_source->src->callback)!=FIX_ONE) goto do_mix;
-	if (single_source->src->GetChannelVolume(single_source->src->callback, pan)) goto do_mix;
+	if (gf_mixer_get_channel_volume(single_source->src, pan)) goto do_mix;
 
 single_source_mix:
 
@@ -702,12 +1084,12 @@ do_mix:
 			assert(in->src->samplerate);
 			in->out_samples_to_write = nb_samples;
 			if (in->src->IsMuted(in->src->callback)) {
-				memset(in->pan, 0, sizeof(Fixed)*6);
+				memset(in->pan, 0, sizeof(Fixed)*GF_SR_MAX_CHANNELS);
 			} else {
-				if (!force_mix  && !in->src->GetChannelVolume(in->src->callback, in->pan)) {
+				if (!force_mix  && !gf_mixer_get_channel_volume(in->src, in->pan)) {
 					/*track first active source with same cfg as mixer*/
 					if (!single_source && (in->src->samplerate == am->sample_rate)
-					        && (in->src->chan == am->nb_channels) && (in->speed == FIX_ONE)
+					        && (in->src->chan == am->nb_channels) && (in->src->bps == am->bits_per_sample) && (in->speed == FIX_ONE)
 					   )
 						single_source = in;
 				}
@@ -752,21 +1134,16 @@ do_mix:
 		//only resync on the first fill
 		delay=0;
 	}
-	/*step 3, mix the final buffer*/
+	/*step 3, mix the final buffer - channels are mixed in separate planes of nb_samples*/
 	memset(am->output, 0, sizeof(s32) * buffer_size);
 
 	nb_written = 0;
 	for (i=0; i<count; i++) {
-		out_mix = am->output;
 		in = (MixerInput *)gf_list_get(am->sources, i);
 		if (!in->out_samples_to_write) continue;
 		/*only write what has been filled in the source buffer (may be less than output size)*/
-		for (j=0; j<in->out_samples_written; j++) {
-			u32 k;
-			for (k=0; k<am->nb_channels; k++) {
-				(*out_mix) += * (in->ch_buf[k] + j);
-				out_mix += 1;
-			}
+		for (j=0; j<am->nb_channels; j++) {
+			gf_mixer_add_plane(am->output + j*nb_samples, in->ch_buf[j], in->out_samples_written);
 		}
 		if (nb_written < in->out_samples_written) nb_written = in->out_samples_written;
 	}
@@ -777,29 +1154,19 @@ do_mix:
 	}
 
 	//we do not re-normalize based on the numbner of input, this is the author's responsability
-	out_mix = am->output;
 	if (am->bits_per_sample==16) {
-		s16 *out_s16 = (s16 *) buffer;
-		for (i=0; i<nb_written; i++) {
-			for (j=0; j<am->nb_channels; j++) {
-				s32 samp = (*out_mix );
-				if (samp > GF_SHORT_MAX) samp = GF_SHORT_MAX;
-				else if (samp < GF_SHORT_MIN) samp = GF_SHORT_MIN;
-				(*out_s16) = samp;
-				out_s16 += 1;
-				out_mix += 1;
-			}
-		}
+		gf_mixer_write_s16((s16 *) buffer, am->output, nb_samples, am->nb_channels, nb_written);
+	} else if (am->bits_per_sample==32) {
+		gf_mixer_write_flt((Float *) buffer, am->output, nb_samples, am->nb_channels, nb_written);
 	} else {
 		s8 *out_s8 = (s8 *) buffer;
 		for (i=0; i<nb_written; i++) {
 			for (j=0; j<am->nb_channels; j++) {
-				s32 samp = (*out_mix ) / 255;
+				s32 samp = am->output[j*nb_samples + i] / 255;
 				if (samp > 127) samp = 127;
 				else if (samp < -128) samp = -128;
 				(*out_s8) = samp;
 				out_s8 += 1;
-				out_mix += 1;
 			}
 		}
 	}
@@ -470,8 +470,11 @@ GF_AudioRenderer *gf_sc_ar_load(GF_User *user)
 	ar->disable_resync = (sOpt && !stricmp(sOpt, "yes")) ? GF_TRUE : GF_FALSE;
 	sOpt = gf_cfg_get_key(user->config, "Audio", "DisableMultiChannel");
 	ar->disable_multichannel = (sOpt && !stricmp(sOpt, "yes")) ? GF_TRUE : GF_FALSE;
+	sOpt = gf_cfg_get_key(user->config, "Audio", "Resampler");
+	ar->polyphase_resampling = (sOpt && !stricmp(sOpt, "polyphase")) ? GF_TRUE : GF_FALSE;
 
 	ar->mixer = gf_mixer_new(ar);
+	gf_mixer_set_polyphase_resampling(ar->mixer, ar->polyphase_resampling);
 	ar->user = user;
 
 	sOpt = gf_cfg_get_key(user->config, "Audio", "Volume");
@@ -618,6 +618,8 @@ GF_Compositor *gf_sc_new(GF_User *user, Bool self_threaded, GF_Terminal *term)
 
 	if ((tmp->user->init_flags & GF_TERM_NO_REGULATION) || !tmp->VisualThread)
 		tmp->no_regulation = GF_TRUE;
+	if (tmp->user->init_flags & GF_TERM_USE_VIRTUAL_CLOCK)
+		tmp->virtual_clock = GF_TRUE;
 	
 	/*try to load GL extensions*/
 #ifndef GPAC_DISABLE_3D
@@ -745,6 +747,9 @@ void gf_sc_del(GF_Compositor *compositor)
 void gf_sc_set_fps(GF_Compositor *compositor, Double fps)
 {
 	if (fps) {
+		/*restart frame count of the virtual clock from the current time so that time stays continuous*/
+		compositor->virtual_clock_base = compositor->scene_sampled_clock;
+		compositor->virtual_frames = 0;
 		compositor->frame_rate = fps;
 		compositor->frame_duration = (u32) (1000 / fps);
 		gf_sc_reset_framerate(compositor);
@@ -778,7 +783,7 @@ static void gf_sc_set_play_state(GF_Compositor *compositor, u32 PlayState)
 
 u32 gf_sc_get_clock(GF_Compositor *compositor)
 {
-	if (!compositor->bench_mode) {
+	if (!compositor->bench_mode && !compositor->virtual_clock) {
 		return gf_sc_ar_get_clock(compositor->audio_renderer);
 	}
 	return compositor->scene_sampled_clock;
@@ -2316,7 +2321,7 @@ void gf_sc_render_frame(GF_Compositor *compositor)
 
 	if (compositor->freeze_display) {
 		gf_sc_lock(compositor, 0);
-		if (!compositor->bench_mode) {
+		if (!compositor->bench_mode && !compositor->virtual_clock) {
 			compositor->scene_sampled_clock = gf_sc_ar_get_clock(compositor->audio_renderer);
 		}
 		if (!compositor->no_regulation) gf_sleep(compositor->frame_duration);
@@ -2378,7 +2383,9 @@ void gf_sc_render_frame(GF_Compositor *compositor)
 #endif
 
 
-	if (!compositor->bench_mode) {
+	if (compositor->virtual_clock) {
+		//virtual clock is only advanced once the frame is composed
+	} else if (!compositor->bench_mode) {
 		compositor->scene_sampled_clock = gf_sc_ar_get_clock(compositor->audio_renderer);
 	} else {
 		if (compositor->force_bench_frame==1) {
@@ -2694,7 +2701,11 @@ void gf_sc_render_frame(GF_Compositor *compositor)
 		compositor->frame_time[compositor->current_frame] = compositor->last_frame_time;
 		compositor->frame_number++;
 	}
-	if (compositor->bench_mode && (frame_drawn || (has_timed_nodes&&all_tx_done) )) {
+	if (compositor->virtual_clock) {
+		//one simulation frame has been composed, move the time base to the next frame
+		compositor->virtual_frames++;
+		compositor->scene_sampled_clock = compositor->virtual_clock_base + (u32) (compositor->virtual_frames * 1000 / compositor->frame_rate);
+	} else if (compositor->bench_mode && (frame_drawn || (has_timed_nodes&&all_tx_done) )) {
 		//in bench mode we always increase the clock of the fixed target simulation rate - this needs refinement if video is used ...
 		compositor->scene_sampled_clock += frame_duration;
 	}
@@ -595,6 +595,7 @@ void compositor_init_audiobuffer(GF_Compositor *compositor, GF_Node *node)
 	st->set_duration = GF_TRUE;
 
 	st->am = gf_mixer_new(NULL);
+	if (compositor->audio_renderer) gf_mixer_set_polyphase_resampling(st->am, compositor->audio_renderer->polyphase_resampling);
 	st->new_inputs = gf_list_new();
 
 	gf_node_set_private(node, st);
@@ -84,6 +84,7 @@
 #pragma comment (linker, EXPORT_SYMBOL(gf_fopen) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_fclose) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_fseek) )
+#pragma comment (linker, EXPORT_SYMBOL(gf_fcopy_range) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_ftell) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_prompt_has_input) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_prompt_get_char) )
@@ -122,6 +123,11 @@
 #pragma comment (linker, EXPORT_SYMBOL(gf_ringbuffer_write) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_ringbuffer_available_for_read ) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_ringbuffer_del) )
+#pragma comment (linker, EXPORT_SYMBOL(gf_ringbuffer_available_for_write) )
+#pragma comment (linker, EXPORT_SYMBOL(gf_ringbuffer_reserve) )
+#pragma comment (linker, EXPORT_SYMBOL(gf_ringbuffer_commit) )
+#pragma comment (linker, EXPORT_SYMBOL(gf_ringbuffer_peek) )
+#pragma comment (linker, EXPORT_SYMBOL(gf_ringbuffer_consume) )
 #endif
 
 
@@ -216,6 +222,7 @@
 #pragma comment (linker, EXPORT_SYMBOL(gf_bs_set_output_buffering) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_bs_transfer) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_bs_flush) )
+#pragma comment (linker, EXPORT_SYMBOL(gf_bs_write_file_range) )
 
 
 /* Thread */
@@ -238,6 +245,8 @@
 #pragma comment (linker, EXPORT_SYMBOL(gf_sema_notify) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_sema_wait) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_sema_wait_for) )
+#pragma comment (linker, EXPORT_SYMBOL(gf_atomic_ptr_cas) )
+#pragma comment (linker, EXPORT_SYMBOL(gf_atomic_ptr_swap) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_global_resource_lock) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_global_resource_unlock) )
 
@@ -252,6 +261,7 @@
 #pragma comment (linker, EXPORT_SYMBOL(gf_sk_connect) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_sk_send) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_sk_receive) )
+#pragma comment (linker, EXPORT_SYMBOL(gf_sk_probe) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_sk_listen) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_sk_accept) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_sk_server_mode) )
@@ -394,6 +404,7 @@
 #pragma comment (linker, EXPORT_SYMBOL(gf_dm_sess_setup_from_url) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_dm_get_file_memory) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_dm_get_global_rate) )
+#pragma comment (linker, EXPORT_SYMBOL(gf_dm_get_connection_pool_stats) )
 
 
 
@@ -665,6 +676,7 @@
 #ifndef GPAC_DISABLE_ISOM
 #pragma comment (linker, EXPORT_SYMBOL(gf_isom_sample_new) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_isom_sample_del) )
+#pragma comment (linker, EXPORT_SYMBOL(gf_isom_sample_release) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_isom_last_error) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_isom_probe_file) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_isom_open) )
@@ -685,6 +697,9 @@
 #pragma comment (linker, EXPORT_SYMBOL(gf_isom_box_size) )
 #endif
 #pragma comment (linker, EXPORT_SYMBOL(gf_isom_open_progressive) )
+#pragma comment (linker, EXPORT_SYMBOL(gf_isom_open_push) )
+#pragma comment (linker, EXPORT_SYMBOL(gf_isom_push_data) )
+#pragma comment (linker, EXPORT_SYMBOL(gf_isom_push_release) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_isom_get_missing_bytes) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_isom_is_fragmented) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_isom_get_fragmented_duration) )
@@ -725,6 +740,8 @@
 #pragma comment (linker, EXPORT_SYMBOL(gf_isom_get_sample_count) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_isom_set_sample_padding) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_isom_get_sample) )
+#pragma comment (linker, EXPORT_SYMBOL(gf_isom_get_sample_ex) )
+#pragma comment (linker, EXPORT_SYMBOL(gf_isom_enable_sample_index) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_isom_get_sample_info) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_isom_get_sample_flags) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_isom_get_sample_for_media_time) )
@@ -889,6 +906,7 @@
 #pragma comment (linker, EXPORT_SYMBOL(gf_isom_set_final_name) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_isom_set_storage_mode) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_isom_force_64bit_chunk_offset) )
+#pragma comment (linker, EXPORT_SYMBOL(gf_isom_reserve_moov_space) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_isom_get_storage_mode) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_isom_set_interleave_time) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_isom_get_interleave_time) )
@@ -1049,7 +1067,9 @@
 #pragma comment (linker, EXPORT_SYMBOL(gf_isom_setup_track_fragment) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_isom_finalize_for_fragment) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_isom_start_fragment) )
+#pragma comment (linker, EXPORT_SYMBOL(gf_isom_reserve_moof_space) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_isom_flush_fragments) )
+#pragma comment (linker, EXPORT_SYMBOL(gf_isom_get_segment_write_offset) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_isom_set_fragment_reference_time) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_isom_set_fragment_option) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_isom_set_single_moof_mode) )
@@ -2025,8 +2045,10 @@
 #pragma comment (linker, EXPORT_SYMBOL(gf_dasher_configure_isobmf_default) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_dasher_enable_utc_ref) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_dasher_enable_real_time) )
+#pragma comment (linker, EXPORT_SYMBOL(gf_dasher_enable_chunked_mode) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_dasher_set_content_protection_location_mode) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_dasher_set_profile_extension) )
+#pragma comment (linker, EXPORT_SYMBOL(gf_dasher_set_thread_count) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_dasher_add_input) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_dasher_process) )
 
@@ -127,7 +127,7 @@ static GF_Err process_extractor(GF_ISOFile *file, GF_MediaBox *mdia, u32 sampleN
 		if (sample_offset < -sample_offset)
 			sample_offset = 0;
 
-		e = Media_GetSample(ref_trak->Media, sampleNumber + sample_offset, &ref_samp, &di, GF_FALSE, NULL);
+		e = Media_GetSample(ref_trak->Media, sampleNumber + sample_offset, &ref_samp, &di, GF_FALSE, NULL, GF_FALSE);
 		if (e) return e;
 
 		if (rewrite_start_codes) {
@@ -333,6 +333,24 @@ static void nalu_merge_ps(GF_BitStream *ps_bs, Bool rewrite_start_codes, u32 nal
 }
 
 
+/*must be kept in sync with the early exits of gf_isom_nalu_sample_rewrite*/
+Bool gf_isom_nalu_sample_rewrite_needed(GF_MediaBox *mdia, GF_MPEGVisualSampleEntryBox *entry)
+{
+	GF_TrackReferenceTypeBox *ref = NULL;
+	if (!entry) return GF_TRUE;
+	if (mdia->mediaTrack->extractor_mode & (GF_ISOM_NALU_EXTRACT_INBAND_PS_FLAG | GF_ISOM_NALU_EXTRACT_ANNEXB_FLAG))
+		return GF_TRUE;
+	if ((mdia->mediaTrack->extractor_mode & 0x0000FFFF) == GF_ISOM_NALU_EXTRACT_INSPECT)
+		return GF_FALSE;
+	/*tile tracks are aggregated*/
+	Track_FindRef(mdia->mediaTrack, GF_ISOM_REF_SABT, &ref);
+	if (ref) return GF_TRUE;
+	if (entry->svc_config || entry->shvc_config) return GF_TRUE;
+	Track_FindRef(mdia->mediaTrack, GF_ISOM_REF_SCAL, &ref);
+	if (ref) return GF_TRUE;
+	return GF_FALSE;
+}
+
 GF_Err gf_isom_nalu_sample_rewrite(GF_MediaBox *mdia, GF_ISOSample *sample, u32 sampleNumber, GF_MPEGVisualSampleEntryBox *entry)
 {
 	Bool is_hevc = GF_FALSE;
@@ -4613,6 +4613,7 @@ void stbl_del(GF_Box *s)
 	if (ptr->sai_sizes) gf_isom_box_array_del(ptr->sai_sizes);
 	if (ptr->sai_offsets) gf_isom_box_array_del(ptr->sai_offsets);
 
+	stbl_SetSampleIndex(ptr, GF_FALSE);
 	gf_free(ptr);
 }
 
@@ -7059,11 +7060,14 @@ void trun_del(GF_Box *s)
 	if (ptr == NULL) return;
 
 	while (gf_list_count(ptr->entries)) {
-		p = (GF_TrunEntry*)gf_list_get(ptr->entries, 0);
-		gf_list_rem(ptr->entries, 0);
+		p = (GF_TrunEntry*)gf_list_pop_back(ptr->entries);
+		/*entries from the parsed block are released all at once*/
+		if (ptr->entries_block && (p >= ptr->entries_block) && (p < ptr->entries_block + ptr->entries_block_count))
+			continue;
 		gf_free(p);
 	}
 	gf_list_del(ptr->entries);
+	if (ptr->entries_block) gf_free(ptr->entries_block);
 	if (ptr->cache) gf_bs_del(ptr->cache);
 	gf_free(ptr);
 }
@@ -7071,7 +7075,7 @@ void trun_del(GF_Box *s)
 GF_Err trun_Read(GF_Box *s, GF_BitStream *bs)
 {
 	GF_Err e;
-	u32 i;
+	u32 i, entry_size;
 	GF_TrunEntry *p;
 	GF_TrackFragmentRunBox *ptr = (GF_TrackFragmentRunBox *)s;
 
@@ -7094,12 +7098,26 @@ GF_Err trun_Read(GF_Box *s, GF_BitStream *bs)
 		ptr->size -= 4;
 	}
 
+	if (!ptr->sample_count) return GF_OK;
+
+	//check the run fits in the box before allocating it
+	entry_size = 0;
+	if (ptr->flags & GF_ISOM_TRUN_DURATION) entry_size += 4;
+	if (ptr->flags & GF_ISOM_TRUN_SIZE) entry_size += 4;
+	if (ptr->flags & GF_ISOM_TRUN_FLAGS) entry_size += 4;
+	if (ptr->flags & GF_ISOM_TRUN_CTS_OFFSET) entry_size += 4;
+	if (entry_size && (ptr->size / entry_size < ptr->sample_count)) return GF_ISOM_INVALID_FILE;
+
+	//all entries are allocated at once, this avoids one allocation per sample for each fragment
+	ptr->entries_block = (GF_TrunEntry *) gf_malloc(sizeof(GF_TrunEntry) * ptr->sample_count);
+	if (!ptr->entries_block) return GF_OUT_OF_MEM;
+	memset(ptr->entries_block, 0, sizeof(GF_TrunEntry) * ptr->sample_count);
+	ptr->entries_block_count = ptr->sample_count;
+
 	//read each entry (even though nothing may be written)
 	for (i=0; i<ptr->sample_count; i++) {
 		u32 trun_size = 0;
-		p = (GF_TrunEntry *) gf_malloc(sizeof(GF_TrunEntry));
-		if (!p) return GF_OUT_OF_MEM;
-		memset(p, 0, sizeof(GF_TrunEntry));
+		p = &ptr->entries_block[i];
 
 		if (ptr->flags & GF_ISOM_TRUN_DURATION) {
 			p->Duration = gf_bs_read_u32(bs);
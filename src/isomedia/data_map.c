@@ -60,6 +60,9 @@ void gf_isom_datamap_del(GF_DataMap *ptr)
 	case GF_ISOM_DATA_FILE_MAPPING:
 		gf_isom_fmo_del((GF_FileMappingDataMap *)ptr);
 		break;
+	case GF_ISOM_DATA_MEM:
+		gf_isom_mdm_del((GF_MemDataMap *)ptr);
+		break;
 	//not implemented
 	default:
 		break;
@@ -176,6 +179,10 @@ GF_Err gf_isom_datamap_new(const char *location, const char *parentPath, u8 mode
 #else
 		*outDataMap = gf_isom_fdm_new(sPath, mode);
 #endif
+	} else if (mode == GF_ISOM_DATA_MAP_READ_MAPPED) {
+		/*explicit request for a mapped file, falls back to regular IO if mapping is not possible*/
+		mode = GF_ISOM_DATA_MAP_READ;
+		*outDataMap = gf_isom_fmo_new(sPath, mode);
 	} else {
 		*outDataMap = gf_isom_fdm_new(sPath, mode);
 		if (*outDataMap) {
@@ -276,11 +283,22 @@ u32 gf_isom_datamap_get_data(GF_DataMap *map, char *buffer, u32 bufferLength, u6
 	case GF_ISOM_DATA_FILE_MAPPING:
 		return gf_isom_fmo_get_data((GF_FileMappingDataMap *)map, buffer, bufferLength, Offset);
 
+	case GF_ISOM_DATA_MEM:
+		return gf_isom_mdm_get_data((GF_MemDataMap *)map, buffer, bufferLength, Offset);
+
 	default:
 		return 0;
 	}
 }
 
+const char *gf_isom_datamap_get_mapped_data(GF_DataMap *map, u32 size, u64 offset)
+{
+	GF_FileMappingDataMap *fmo = (GF_FileMappingDataMap *)map;
+	if (!map || (map->type != GF_ISOM_DATA_FILE_MAPPING)) return NULL;
+	if (!fmo->byte_map || (offset > fmo->file_size) || (size > fmo->file_size - offset)) return NULL;
+	return fmo->byte_map + offset;
+}
+
 void gf_isom_datamap_flush(GF_DataMap *map)
 {
 	if (!map) return;
@@ -310,6 +328,45 @@ u64 gf_isom_datamap_get_offset(GF_DataMap *map)
 }
 
 
+//copy a range of the data map to the given bitstream - when both ends are local files, the copy is done by the kernel
+//otherwise the data goes through the provided buffer
+GF_Err gf_isom_datamap_copy_data(GF_DataMap *map, u64 offset, u64 size, GF_BitStream *bs, char *buffer, u32 buffer_size)
+{
+	u32 bytes, to_copy;
+	if (!map || !bs) return GF_BAD_PARAM;
+
+	if (map->type==GF_ISOM_DATA_FILE_MAPPING) {
+		const char *data;
+		if (size>0xFFFFFFFFUL) return GF_NOT_SUPPORTED;
+		data = gf_isom_datamap_get_mapped_data(map, (u32) size, offset);
+		if (!data) return GF_IO_ERR;
+		if (gf_bs_write_data(bs, data, (u32) size) != size) return GF_IO_ERR;
+		return GF_OK;
+	}
+	if (map->type==GF_ISOM_DATA_FILE) {
+		GF_FileDataMap *fdm = (GF_FileDataMap *)map;
+		if (fdm->stream && !fdm->is_stdout) {
+			u64 done;
+			gf_bs_flush(fdm->bs);
+			done = gf_bs_write_file_range(bs, fdm->stream, offset, size);
+			offset += done;
+			size -= done;
+		}
+	}
+	if (!buffer || !buffer_size) return size ? GF_BAD_PARAM : GF_OK;
+
+	while (size) {
+		to_copy = (size>buffer_size) ? buffer_size : (u32) size;
+		bytes = gf_isom_datamap_get_data(map, buffer, to_copy, offset);
+		if (bytes != to_copy) return GF_IO_ERR;
+		bytes = gf_bs_write_data(bs, buffer, to_copy);
+		if (bytes != to_copy) return GF_IO_ERR;
+		offset += to_copy;
+		size -= to_copy;
+	}
+	return GF_OK;
+}
+
 GF_Err gf_isom_datamap_add_data(GF_DataMap *ptr, char *data, u32 dataSize)
 {
 	if (!ptr || !data|| !dataSize) return GF_BAD_PARAM;
@@ -542,6 +599,82 @@ GF_Err FDM_AddData(GF_FileDataMap *ptr, char *data, u32 dataSize)
 #endif	/*GPAC_DISABLE_ISOM_WRITE*/
 
 
+GF_DataMap *gf_isom_mdm_new()
+{
+	GF_MemDataMap *tmp;
+	GF_SAFEALLOC(tmp, GF_MemDataMap);
+	if (!tmp) return NULL;
+
+	tmp->type = GF_ISOM_DATA_MEM;
+	tmp->mode = GF_ISOM_DATA_MAP_READ;
+	tmp->bs = gf_bs_new(NULL, 0, GF_BITSTREAM_READ);
+	if (!tmp->bs) {
+		gf_free(tmp);
+		return NULL;
+	}
+	return (GF_DataMap *)tmp;
+}
+
+void gf_isom_mdm_del(GF_MemDataMap *ptr)
+{
+	if (!ptr || (ptr->type != GF_ISOM_DATA_MEM)) return;
+	if (ptr->bs) gf_bs_del(ptr->bs);
+	if (ptr->buffer) gf_free(ptr->buffer);
+	gf_free(ptr);
+}
+
+/*the bitstream cannot follow buffer reallocations, recreate it at the same position*/
+static GF_Err gf_isom_mdm_reset_bs(GF_MemDataMap *ptr, u64 pos)
+{
+	if (ptr->bs) gf_bs_del(ptr->bs);
+	ptr->bs = gf_bs_new(ptr->size ? ptr->buffer : NULL, ptr->size, GF_BITSTREAM_READ);
+	if (!ptr->bs) return GF_OUT_OF_MEM;
+	if (pos > ptr->size) pos = ptr->size;
+	gf_bs_seek(ptr->bs, pos);
+	ptr->curPos = pos;
+	return GF_OK;
+}
+
+GF_Err gf_isom_mdm_append(GF_MemDataMap *ptr, const char *data, u32 size)
+{
+	if (!ptr || (ptr->type != GF_ISOM_DATA_MEM)) return GF_BAD_PARAM;
+	if (!data || !size) return GF_OK;
+
+	if (ptr->size + size > ptr->alloc) {
+		u32 alloc = MAX(ptr->size + size, 2*ptr->alloc);
+		char *buffer = (char*)gf_realloc(ptr->buffer, alloc);
+		if (!buffer) return GF_OUT_OF_MEM;
+		ptr->buffer = buffer;
+		ptr->alloc = alloc;
+	}
+	memcpy(ptr->buffer + ptr->size, data, size);
+	ptr->size += size;
+	return gf_isom_mdm_reset_bs(ptr, gf_bs_get_position(ptr->bs));
+}
+
+GF_Err gf_isom_mdm_discard(GF_MemDataMap *ptr, u32 nb_bytes)
+{
+	u64 pos;
+	if (!ptr || (ptr->type != GF_ISOM_DATA_MEM)) return GF_BAD_PARAM;
+	if (!nb_bytes) return GF_OK;
+	if (nb_bytes > ptr->size) nb_bytes = ptr->size;
+
+	pos = gf_bs_get_position(ptr->bs);
+	pos = (pos > nb_bytes) ? pos - nb_bytes : 0;
+	memmove(ptr->buffer, ptr->buffer + nb_bytes, ptr->size - nb_bytes);
+	ptr->size -= nb_bytes;
+	return gf_isom_mdm_reset_bs(ptr, pos);
+}
+
+u32 gf_isom_mdm_get_data(GF_MemDataMap *ptr, char *buffer, u32 bufferLength, u64 offset)
+{
+	if ((offset > ptr->size) || (bufferLength > ptr->size - offset)) return 0;
+	memcpy(buffer, ptr->buffer + offset, bufferLength);
+	ptr->curPos = offset + bufferLength;
+	return bufferLength;
+}
+
+
 #ifdef WIN32
 
 #include <windows.h>
@@ -643,6 +776,79 @@ u32 gf_isom_fmo_get_data(GF_FileMappingDataMap *ptr, char *buffer, u32 bufferLen
 	return bufferLength;
 }
 
+#elif defined(GPAC_CONFIG_LINUX) || defined(GPAC_CONFIG_FREEBSD) || defined(GPAC_CONFIG_DARWIN) || defined(GPAC_ANDROID)
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+GF_DataMap *gf_isom_fmo_new(const char *sPath, u8 mode)
+{
+	GF_FileMappingDataMap *tmp;
+	FILE *f;
+	void *map;
+	u64 size;
+
+	//only in read only
+	if (mode != GF_ISOM_DATA_MAP_READ) return NULL;
+
+	f = gf_fopen(sPath, "rb");
+	if (!f) return NULL;
+	gf_fseek(f, 0, SEEK_END);
+	size = gf_ftell(f);
+	//empty files or files not addressable by the mapping use regular IO
+	if (!size || (size != (size_t) size)) {
+		gf_fclose(f);
+		return gf_isom_fdm_new(sPath, mode);
+	}
+	map = mmap(NULL, (size_t) size, PROT_READ, MAP_PRIVATE, fileno(f), 0);
+	//the mapping stays valid once the descriptor is closed
+	gf_fclose(f);
+	if (map == MAP_FAILED) {
+		GF_LOG(GF_LOG_WARNING, GF_LOG_CONTAINER, ("[IsoMedia] Cannot map file %s, using regular IO\n", sPath));
+		return gf_isom_fdm_new(sPath, mode);
+	}
+
+	GF_SAFEALLOC(tmp, GF_FileMappingDataMap);
+	if (!tmp) {
+		munmap(map, (size_t) size);
+		return NULL;
+	}
+	tmp->type = GF_ISOM_DATA_FILE_MAPPING;
+	tmp->mode = mode;
+	tmp->name = gf_strdup(sPath);
+	tmp->file_size = size;
+	tmp->byte_map = (char *) map;
+
+	//finaly open our bitstream (from buffer)
+	tmp->bs = gf_bs_new(tmp->byte_map, tmp->file_size, GF_BITSTREAM_READ);
+	return (GF_DataMap *)tmp;
+}
+
+void gf_isom_fmo_del(GF_FileMappingDataMap *ptr)
+{
+	if (!ptr) return;
+	//mapping failed at creation time, this is a regular file data map
+	if (ptr->type != GF_ISOM_DATA_FILE_MAPPING) {
+		gf_isom_fdm_del((GF_FileDataMap *)ptr);
+		return;
+	}
+	if (ptr->bs) gf_bs_del(ptr->bs);
+	if (ptr->byte_map) munmap(ptr->byte_map, (size_t) ptr->file_size);
+	gf_free(ptr->name);
+	gf_free(ptr);
+}
+
+u32 gf_isom_fmo_get_data(GF_FileMappingDataMap *ptr, char *buffer, u32 bufferLength, u64 fileOffset)
+{
+	//can we seek till that point ???
+	if (fileOffset > ptr->file_size) return 0;
+	if (bufferLength > ptr->file_size - fileOffset) bufferLength = (u32) (ptr->file_size - fileOffset);
+
+	//we do only read operations, so trivial
+	memcpy(buffer, ptr->byte_map + fileOffset, bufferLength);
+	return bufferLength;
+}
+
 #else
 
 GF_DataMap *gf_isom_fmo_new(const char *sPath, u8 mode) {
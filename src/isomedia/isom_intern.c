@@ -77,6 +77,15 @@ GF_Err MergeFragment(GF_MovieFragmentBox *moof, GF_ISOFile *mov)
 			return GF_ISOM_INVALID_FILE;
 		}
 
+		/*in push mode, absolute base offsets are relative to the start of the stream, not of the push buffer*/
+		if (mov->push_discarded_bytes && (traf->tfhd->flags & GF_ISOM_TRAF_BASE_OFFSET)) {
+			if (traf->tfhd->base_data_offset < mov->push_discarded_bytes) {
+				GF_LOG(GF_LOG_ERROR, GF_LOG_CONTAINER, ("[iso file] Error: track fragment base data offset points to released data\n"));
+				return GF_ISOM_INVALID_FILE;
+			}
+			traf->tfhd->base_data_offset -= mov->push_discarded_bytes;
+		}
+
 		e = MergeTrack(trak, traf, mov->current_top_box_start, !trak->first_traf_merged);
 		if (e) return e;
 
@@ -190,6 +199,9 @@ GF_Err gf_isom_parse_movie_boxes(GF_ISOFile *mov, u64 *bytesMissing, Bool progre
 
 	/*while we have some data, parse our boxes*/
 	while (gf_bs_available(mov->movieFileMap->bs)) {
+#ifndef	GPAC_DISABLE_ISOM_FRAGMENTS
+		u32 box_type;
+#endif
 		*bytesMissing = 0;
 #ifndef	GPAC_DISABLE_ISOM_FRAGMENTS
 		mov->current_top_box_start = gf_bs_get_position(mov->movieFileMap->bs);
@@ -214,6 +226,9 @@ GF_Err gf_isom_parse_movie_boxes(GF_ISOFile *mov, u64 *bytesMissing, Bool progre
 		} else {
 			return e;
 		}
+#ifndef	GPAC_DISABLE_ISOM_FRAGMENTS
+		box_type = a->type;
+#endif
 
 		switch (a->type) {
 		/*MOOV box*/
@@ -423,6 +438,11 @@ GF_Err gf_isom_parse_movie_boxes(GF_ISOFile *mov, u64 *bytesMissing, Bool progre
 		}
 
 #ifndef	GPAC_DISABLE_ISOM_FRAGMENTS
+		/*notify the box once merged, so that new samples are visible from the callback*/
+		if (mov->on_top_box) {
+			u64 box_end = gf_bs_get_position(mov->movieFileMap->bs);
+			mov->on_top_box(mov->on_top_box_udta, box_type, mov->current_top_box_start, box_end - mov->current_top_box_start);
+		}
 		/*remember where we left, in case we append an entire number of movie fragments*/
 		mov->current_top_box_start = gf_bs_get_position(mov->movieFileMap->bs);
 #endif
@@ -502,9 +522,15 @@ GF_ISOFile *gf_isom_open_file(const char *fileName, u32 OpenMode, const char *tm
 {
 	GF_Err e;
 	u64 bytes;
+	u8 read_mode = GF_ISOM_DATA_MAP_READ_ONLY;
 	GF_ISOFile *mov = gf_isom_new_movie();
 	if (! mov) return NULL;
 
+	if (OpenMode & GF_ISOM_OPEN_FILE_MAPPING) {
+		read_mode = GF_ISOM_DATA_MAP_READ_MAPPED;
+		OpenMode &= 0xFF;
+	}
+
 	mov->fileName = gf_strdup(fileName);
 	mov->openMode = OpenMode;
 
@@ -519,7 +545,7 @@ GF_ISOFile *gf_isom_open_file(const char *fileName, u32 OpenMode, const char *tm
 		//the bitstream IS PART OF the GF_DataMap
 		//as this is read-only, use a FileMapping. this is the only place where
 		//we use file mapping
-		e = gf_isom_datamap_new(fileName, NULL, GF_ISOM_DATA_MAP_READ_ONLY, &mov->movieFileMap);
+		e = gf_isom_datamap_new(fileName, NULL, read_mode, &mov->movieFileMap);
 		if (e) {
 			gf_isom_set_last_error(NULL, e);
 			gf_isom_delete_movie(mov);
@@ -85,11 +85,23 @@ GF_EXPORT
 void gf_isom_sample_del(GF_ISOSample **samp)
 {
 	if (! *samp) return;
-	if ((*samp)->data && (*samp)->dataLength) gf_free((*samp)->data);
+	if ((*samp)->data && !(*samp)->is_borrowed && ((*samp)->dataLength || (*samp)->alloc_size)) gf_free((*samp)->data);
 	gf_free(*samp);
 	*samp = NULL;
 }
 
+//release sample payload, keeping the allocated buffer for next gf_isom_get_sample_ex
+GF_EXPORT
+void gf_isom_sample_release(GF_ISOSample *samp)
+{
+	if (!samp) return;
+	if (samp->is_borrowed) {
+		samp->data = NULL;
+		samp->is_borrowed = GF_FALSE;
+	}
+	samp->dataLength = 0;
+}
+
 GF_EXPORT
 u32 gf_isom_probe_file(const char *fileName)
 {
@@ -200,6 +212,86 @@ GF_Err gf_isom_open_progressive(const char *fileName, u64 start_range, u64 end_r
 	return GF_OK;
 }
 
+/**************************************************************
+					File Opening in push mode
+			the file map is a memory buffer filled by the user
+**************************************************************/
+GF_EXPORT
+GF_Err gf_isom_open_push(GF_ISOFile **the_file, void (*on_top_box)(void *udta, u32 box_type, u64 box_start, u64 box_size), void *udta)
+{
+#ifdef	GPAC_DISABLE_ISOM_FRAGMENTS
+	return GF_NOT_SUPPORTED;
+#else
+	GF_ISOFile *movie;
+
+	if (!the_file) return GF_BAD_PARAM;
+	*the_file = NULL;
+
+	movie = gf_isom_new_movie();
+	if (!movie) return GF_OUT_OF_MEM;
+
+	movie->fileName = gf_strdup("push://");
+	movie->openMode = GF_ISOM_OPEN_READ;
+	movie->movieFileMap = gf_isom_mdm_new();
+	if (!movie->movieFileMap) {
+		gf_isom_delete_movie(movie);
+		return GF_OUT_OF_MEM;
+	}
+#ifndef GPAC_DISABLE_ISOM_WRITE
+	movie->editFileMap = NULL;
+	movie->finalName = NULL;
+#endif
+	movie->on_top_box = on_top_box;
+	movie->on_top_box_udta = udta;
+	*the_file = movie;
+	return GF_OK;
+#endif
+}
+
+GF_EXPORT
+GF_Err gf_isom_push_data(GF_ISOFile *movie, const char *data, u32 size, u64 *BytesMissing)
+{
+#ifdef	GPAC_DISABLE_ISOM_FRAGMENTS
+	return GF_NOT_SUPPORTED;
+#else
+	GF_Err e;
+	u64 missing = 0;
+	if (!movie || !movie->movieFileMap || (movie->movieFileMap->type != GF_ISOM_DATA_MEM)) return GF_BAD_PARAM;
+
+	e = gf_isom_mdm_append((GF_MemDataMap *)movie->movieFileMap, data, size);
+	if (e) return e;
+
+	e = gf_isom_parse_movie_boxes(movie, &missing, GF_TRUE);
+	if (BytesMissing) *BytesMissing = missing;
+	return e;
+#endif
+}
+
+GF_EXPORT
+GF_Err gf_isom_push_release(GF_ISOFile *movie)
+{
+#ifdef	GPAC_DISABLE_ISOM_FRAGMENTS
+	return GF_NOT_SUPPORTED;
+#else
+	GF_Err e;
+	u64 nb_bytes;
+	if (!movie || !movie->movieFileMap || (movie->movieFileMap->type != GF_ISOM_DATA_MEM)) return GF_BAD_PARAM;
+	/*the moov sample description must stay valid, we only discard fragments*/
+	if (!movie->moov || !movie->moov->mvex) return GF_BAD_PARAM;
+
+	nb_bytes = movie->current_top_box_start;
+	if (!nb_bytes) return GF_OK;
+
+	e = gf_isom_reset_tables(movie, GF_FALSE);
+	if (e) return e;
+	e = gf_isom_mdm_discard((GF_MemDataMap *)movie->movieFileMap, (u32) nb_bytes);
+	if (e) return e;
+	movie->push_discarded_bytes += nb_bytes;
+	movie->current_top_box_start = 0;
+	return GF_OK;
+#endif
+}
+
 /**************************************************************
 					File Reading
 **************************************************************/
@@ -1325,7 +1417,7 @@ GF_ISOSample *gf_isom_get_sample(GF_ISOFile *the_file, u32 trackNumber, u32 samp
 	sampleNumber -= trak->sample_count_at_seg_start;
 #endif
 
-	e = Media_GetSample(trak->Media, sampleNumber, &samp, &descIndex, GF_FALSE, NULL);
+	e = Media_GetSample(trak->Media, sampleNumber, &samp, &descIndex, GF_FALSE, NULL, GF_FALSE);
 	if (e) {
 		gf_isom_set_last_error(the_file, e);
 		gf_isom_sample_del(&samp);
@@ -1339,6 +1431,34 @@ GF_ISOSample *gf_isom_get_sample(GF_ISOFile *the_file, u32 trackNumber, u32 samp
 	return samp;
 }
 
+GF_EXPORT
+GF_Err gf_isom_get_sample_ex(GF_ISOFile *the_file, u32 trackNumber, u32 sampleNumber, u32 *sampleDescriptionIndex, GF_ISOSample *static_sample)
+{
+	GF_Err e;
+	u32 descIndex;
+	GF_TrackBox *trak;
+	trak = gf_isom_get_track_from_file(the_file, trackNumber);
+	if (!trak || !static_sample) return GF_BAD_PARAM;
+	if (!sampleNumber) return GF_BAD_PARAM;
+
+#ifndef	GPAC_DISABLE_ISOM_FRAGMENTS
+	if (sampleNumber<=trak->sample_count_at_seg_start)
+		return GF_BAD_PARAM;
+	sampleNumber -= trak->sample_count_at_seg_start;
+#endif
+
+	e = Media_GetSample(trak->Media, sampleNumber, &static_sample, &descIndex, GF_FALSE, NULL, GF_TRUE);
+	if (e) {
+		gf_isom_set_last_error(the_file, e);
+		return e;
+	}
+	if (sampleDescriptionIndex) *sampleDescriptionIndex = descIndex;
+#ifndef	GPAC_DISABLE_ISOM_FRAGMENTS
+	static_sample->DTS += trak->dts_at_seg_start;
+#endif
+	return GF_OK;
+}
+
 GF_EXPORT
 u32 gf_isom_get_sample_duration(GF_ISOFile *the_file, u32 trackNumber, u32 sampleNumber)
 {
@@ -1351,6 +1471,9 @@ u32 gf_isom_get_sample_duration(GF_ISOFile *the_file, u32 trackNumber, u32 sampl
 	sampleNumber -= trak->sample_count_at_seg_start;
 #endif
 
+	if (trak->Media->information->sampleTable->sample_index && stbl_UseSampleIndex(trak->Media->information->sampleTable, sampleNumber, GF_FALSE))
+		return stbl_GetIndexedSampleDuration(trak->Media->information->sampleTable, sampleNumber);
+
 	stbl_GetSampleDTS_and_Duration(trak->Media->information->sampleTable->TimeToSample, sampleNumber, &dts, &dur);
 	return dur;
 }
@@ -1405,7 +1528,7 @@ GF_ISOSample *gf_isom_get_sample_info(GF_ISOFile *the_file, u32 trackNumber, u32
 #endif
 	samp = gf_isom_sample_new();
 	if (!samp) return NULL;
-	e = Media_GetSample(trak->Media, sampleNumber, &samp, sampleDescriptionIndex, GF_TRUE, data_offset);
+	e = Media_GetSample(trak->Media, sampleNumber, &samp, sampleDescriptionIndex, GF_TRUE, data_offset, GF_FALSE);
 	if (e) {
 		gf_isom_set_last_error(the_file, e);
 		gf_isom_sample_del(&samp);
@@ -1431,6 +1554,10 @@ u64 gf_isom_get_sample_dts(GF_ISOFile *the_file, u32 trackNumber, u32 sampleNumb
 	if (sampleNumber<=trak->sample_count_at_seg_start) return 0;
 	sampleNumber -= trak->sample_count_at_seg_start;
 #endif
+	if (trak->Media->information->sampleTable->sample_index && stbl_UseSampleIndex(trak->Media->information->sampleTable, sampleNumber, GF_FALSE)) {
+		stbl_GetIndexedSample(trak->Media->information->sampleTable, sampleNumber, &dts, NULL, NULL, NULL, NULL, NULL);
+		return dts;
+	}
 	if (stbl_GetSampleDTS(trak->Media->information->sampleTable->TimeToSample, sampleNumber, &dts) != GF_OK) return 0;
 	return dts;
 }
@@ -1590,7 +1717,7 @@ GF_Err gf_isom_get_sample_for_media_time(GF_ISOFile *the_file, u32 trackNumber,
 		}
 	}
 
-	e = Media_GetSample(trak->Media, sampleNumber, sample, StreamDescriptionIndex, GF_FALSE, NULL);
+	e = Media_GetSample(trak->Media, sampleNumber, sample, StreamDescriptionIndex, GF_FALSE, NULL, GF_FALSE);
 	if (e) {
 		gf_isom_sample_del(sample);
 		return e;
@@ -3612,6 +3739,22 @@ GF_Err gf_isom_get_fragmented_samples_info(GF_ISOFile *movie, u32 trackID, u32 *
 }
 #endif
 
+GF_EXPORT
+GF_Err gf_isom_enable_sample_index(GF_ISOFile *the_file, u32 trackNumber, Bool enable)
+{
+	GF_TrackBox *trak = gf_isom_get_track_from_file(the_file, trackNumber);
+	if (!trak) return GF_BAD_PARAM;
+	if (enable) {
+		//tables must not change once the index is built
+		if (the_file->openMode != GF_ISOM_OPEN_READ) return GF_NOT_SUPPORTED;
+#ifndef	GPAC_DISABLE_ISOM_FRAGMENTS
+		if (the_file->moov->mvex) return GF_NOT_SUPPORTED;
+#endif
+	}
+	stbl_SetSampleIndex(trak->Media->information->sampleTable, enable);
+	return GF_OK;
+}
+
 GF_EXPORT
 GF_Err gf_isom_set_nalu_extract_mode(GF_ISOFile *the_file, u32 trackNumber, u32 nalu_extract_mode)
 {
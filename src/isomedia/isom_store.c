@@ -85,8 +85,14 @@ typedef struct
 	u32 size;
 	GF_ISOFile *movie;
 	u32 total_samples, nb_done;
+	/*pending run of sample data contiguous in the same data map, copied at once*/
+	GF_DataMap *run_map;
+	u64 run_offset, run_size;
 } MovieWriter;
 
+/*size of the copy buffer used when the kernel cannot copy a run of samples*/
+#define WRITE_RUN_BUFFER_SIZE	0x100000
+
 void CleanWriters(GF_List *writers)
 {
 	TrackWriter *writer;
@@ -348,34 +354,70 @@ u64 GetMoovAndMetaSize(GF_ISOFile *movie, GF_List *writers)
 	return size;
 }
 
+//capture mode: write the moov in the space reserved before the media data if it fits, the remaining space becoming a free box
+static GF_Err WriteMoovInReservedSpace(GF_ISOFile *movie, GF_List *writers, GF_BitStream *bs, Bool *done)
+{
+	GF_Err e;
+	u64 size, pos;
+
+	*done = GF_FALSE;
+	size = GetMoovAndMetaSize(movie, writers);
+	if ((size > movie->moov_reserved_size) || ((size < movie->moov_reserved_size) && (movie->moov_reserved_size - size < 8))) {
+		GF_LOG(GF_LOG_WARNING, GF_LOG_CONTAINER, ("[iso file] Reserved moov space too small (%d bytes for "LLU" bytes), writing moov after media data\n", movie->moov_reserved_size, size));
+		return GF_OK;
+	}
+	pos = gf_bs_get_position(bs);
+	e = gf_bs_seek(bs, movie->moov_reserved_offset);
+	if (e) return e;
+	e = WriteMoovAndMeta(movie, writers, bs);
+	if (e) return e;
+	if (size < movie->moov_reserved_size) {
+		gf_bs_write_u32(bs, (u32) (movie->moov_reserved_size - size));
+		gf_bs_write_u32(bs, GF_ISOM_BOX_TYPE_FREE);
+	}
+	*done = GF_TRUE;
+	return gf_bs_seek(bs, pos);
+}
+
+//copy the pending run of samples to the file
+static GF_Err FlushSampleRun(MovieWriter *mw, GF_BitStream *bs)
+{
+	GF_Err e;
+	if (!mw->run_size) return GF_OK;
+
+	if (!mw->buffer || (mw->size < WRITE_RUN_BUFFER_SIZE)) {
+		mw->buffer = (char*)gf_realloc(mw->buffer, WRITE_RUN_BUFFER_SIZE);
+		if (!mw->buffer) return GF_OUT_OF_MEM;
+		mw->size = WRITE_RUN_BUFFER_SIZE;
+	}
+	e = gf_isom_datamap_copy_data(mw->run_map, mw->run_offset, mw->run_size, bs, mw->buffer, mw->size);
+	mw->run_size = 0;
+	return e;
+}
+
 //Write a sample to the file - this is only called for self-contained media
+//samples following each other in their data map are gathered and copied in a single operation
 GF_Err WriteSample(MovieWriter *mw, u32 size, u64 offset, u8 isEdited, GF_BitStream *bs)
 {
+	GF_Err e;
 	GF_DataMap *map;
-	u32 bytes;
 
 	if (!size) return GF_OK;
 
-	if (size>mw->size) {
-		mw->buffer = (char*)gf_realloc(mw->buffer, size);
-		mw->size = size;
-	}
-
-	if (!mw->buffer) return GF_OUT_OF_MEM;
-
 	if (isEdited) {
 		map = mw->movie->editFileMap;
 	} else {
 		map = mw->movie->movieFileMap;
 	}
-	//get the payload...
-	bytes = gf_isom_datamap_get_data(map, mw->buffer, size, offset);
-	if (bytes != size)
-		return GF_IO_ERR;
-	//write it to our stream...
-	bytes = gf_bs_write_data(bs, mw->buffer, size);
-	if (bytes != size)
-		return GF_IO_ERR;
+	if (mw->run_size && (mw->run_map == map) && (mw->run_offset + mw->run_size == offset)) {
+		mw->run_size += size;
+	} else {
+		e = FlushSampleRun(mw, bs);
+		if (e) return e;
+		mw->run_map = map;
+		mw->run_offset = offset;
+		mw->run_size = size;
+	}
 
 	mw->nb_done++;
 	gf_set_progress("ISO File Writing", mw->nb_done, mw->total_samples);
@@ -447,6 +489,8 @@ GF_Err DoWriteMeta(GF_ISOFile *file, GF_MetaBox *meta, GF_BitStream *bs, Bool Em
 					if (src) {
 						char cache_data[4096];
 						u64 remain = entry->extent_length;
+						remain -= gf_bs_write_file_range(bs, src, 0, remain);
+						if (remain) gf_fseek(src, entry->extent_length - remain, SEEK_SET);
 						while (remain) {
 							u32 size_cache = (remain>4096) ? 4096 : (u32) remain;
 							size_t read = fread(cache_data, sizeof(char), size_cache, src);
@@ -474,15 +518,7 @@ GF_Err DoWriteMeta(GF_ISOFile *file, GF_MetaBox *meta, GF_BitStream *bs, Bool Em
 					/*Reading from the input file*/
 					if (!Emulation) {
 						char cache_data[4096];
-						u64 remain = entry->extent_length;
-						gf_bs_seek(file->movieFileMap->bs, entry->original_extent_offset + iloc->original_base_offset);
-						while (remain) {
-							u32 size_cache = (remain>4096) ? 4096 : (u32) remain;
-							gf_bs_read_data(file->movieFileMap->bs, cache_data, size_cache);
-							/*Writing to the output file*/
-							gf_bs_write_data(bs, cache_data, size_cache);
-							remain -= size_cache;
-						}
+						gf_isom_datamap_copy_data(file->movieFileMap, entry->original_extent_offset + iloc->original_base_offset, entry->extent_length, bs, cache_data, 4096);
 					}
 				}
 			}
@@ -603,6 +639,10 @@ GF_Err DoWrite(MovieWriter *mw, GF_List *writers, GF_BitStream *bs, u8 Emulation
 			}
 		}
 	}
+	if (!Emulation) {
+		e = FlushSampleRun(mw, bs);
+		if (e) return e;
+	}
 	//set the mdatSize...
 	movie->mdat->dataSize = mdatSize;
 	return GF_OK;
@@ -658,6 +698,7 @@ GF_Err WriteFlat(MovieWriter *mw, u8 moovFirst, GF_BitStream *bs)
 				if (movie->is_jp2) begin += 12;
 				if (movie->brand) begin += movie->brand->size;
 				if (movie->pdin) begin += movie->pdin->size;
+				if (movie->moov_reserved_offset) begin += movie->moov_reserved_size;
 			}
 			totSize -= begin;
 		} else {
@@ -721,7 +762,14 @@ GF_Err WriteFlat(MovieWriter *mw, u8 moovFirst, GF_BitStream *bs)
 		}
 
 		//OK, write the movie box.
-		e = WriteMoovAndMeta(movie, writers, bs);
+		if (movie->moov_reserved_offset) {
+			Bool done;
+			e = WriteMoovInReservedSpace(movie, writers, bs, &done);
+			if (e) goto exit;
+			if (!done) e = WriteMoovAndMeta(movie, writers, bs);
+		} else {
+			e = WriteMoovAndMeta(movie, writers, bs);
+		}
 		if (e) goto exit;
 
 #ifndef GPAC_DISABLE_ISOM_ADOBE
@@ -951,6 +999,10 @@ GF_Err DoFullInterleave(MovieWriter *mw, GF_List *writers, GF_BitStream *bs, u8
 		//go to next group
 		curGroupID ++;
 	}
+	if (!Emulation) {
+		e = FlushSampleRun(mw, bs);
+		if (e) return e;
+	}
 	movie->mdat->dataSize = totSize;
 	return GF_OK;
 }
@@ -1157,6 +1209,10 @@ GF_Err DoInterleave(MovieWriter *mw, GF_List *writers, GF_BitStream *bs, u8 Emul
 		//go to next group
 		curGroupID ++;
 	}
+	if (!Emulation) {
+		e = FlushSampleRun(mw, bs);
+		if (e) return e;
+	}
 	if (movie->mdat) movie->mdat->dataSize = mdatSize;
 	return GF_OK;
 }
@@ -75,6 +75,13 @@ GF_Err FlushCaptureMode(GF_ISOFile *movie)
 		if (e) return e;
 	}
 
+	/*space for the moov, filled in as a free box until the file is closed*/
+	if (movie->moov_reserved_size) {
+		movie->moov_reserved_offset = gf_bs_get_position(movie->editFileMap->bs);
+		e = gf_isom_write_free_box(movie->editFileMap->bs, movie->moov_reserved_size);
+		if (e) return e;
+	}
+
 	/*we have a trick here: the data will be stored on the fly, so the first
 	thing in the file is the MDAT. As we don't know if we have a large file (>4 GB) or not
 	do as if we had one and write 16 bytes: 4 (type) + 4 (size) + 8 (largeSize)...*/
@@ -82,6 +89,33 @@ GF_Err FlushCaptureMode(GF_ISOFile *movie)
 	return GF_OK;
 }
 
+/*writes a zero-filled free box of size bytes, holding space for a box written later*/
+GF_Err gf_isom_write_free_box(GF_BitStream *bs, u32 size)
+{
+	char zero[1024];
+	u32 remain = size - 8;
+	memset(zero, 0, sizeof(zero));
+	gf_bs_write_u32(bs, size);
+	gf_bs_write_u32(bs, GF_ISOM_BOX_TYPE_FREE);
+	while (remain) {
+		u32 len = MIN(remain, sizeof(zero));
+		if (gf_bs_write_data(bs, zero, len) != len) return GF_IO_ERR;
+		remain -= len;
+	}
+	return GF_OK;
+}
+
+/*sets the size of a free box reservation, only possible when writing a new file*/
+GF_Err gf_isom_set_reserved_space(GF_ISOFile *movie, u32 *reserved_size, u32 size)
+{
+	if (!movie) return GF_BAD_PARAM;
+	if (movie->openMode != GF_ISOM_OPEN_WRITE) return GF_ISOM_INVALID_MODE;
+	/*we need room for at least the free box header*/
+	if (size && (size<8)) size = 8;
+	*reserved_size = size;
+	return GF_OK;
+}
+
 static GF_Err CheckNoData(GF_ISOFile *movie)
 {
 	if (movie->openMode != GF_ISOM_OPEN_WRITE) return GF_OK;
@@ -1441,6 +1475,18 @@ void gf_isom_force_64bit_chunk_offset(GF_ISOFile *file, Bool set_on)
 	file->force_co64 = set_on;
 }
 
+GF_EXPORT
+GF_Err gf_isom_reserve_moov_space(GF_ISOFile *movie, u32 size)
+{
+	GF_Err e;
+	e = CanAccessMovie(movie, GF_ISOM_OPEN_WRITE);
+	if (e) return e;
+	/*the reserved space is written before the first sample*/
+	e = CheckNoData(movie);
+	if (e) return e;
+	return gf_isom_set_reserved_space(movie, &movie->moov_reserved_size, size);
+}
+
 
 //update or insert a new edit segment in the track time line. Edits are used to modify
 //the media normal timing. EditTime and EditDuration are expressed in Movie TimeScale
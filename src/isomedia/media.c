@@ -342,14 +342,17 @@ Bool Media_IsSampleSyncShadow(GF_ShadowSyncBox *stsh, u32 sampleNumber)
 	return 0;
 }
 
-GF_Err Media_GetSample(GF_MediaBox *mdia, u32 sampleNumber, GF_ISOSample **samp, u32 *sIDX, Bool no_data, u64 *out_offset)
+GF_Err Media_GetSample(GF_MediaBox *mdia, u32 sampleNumber, GF_ISOSample **samp, u32 *sIDX, Bool no_data, u64 *out_offset, Bool static_sample)
 {
 	GF_Err e;
-	u32 bytesRead;
+	u32 bytesRead, data_size;
 	u32 dataRefIndex, chunkNumber;
 	u64 offset, new_size;
 	u8 isEdited;
+	Bool is_nalu, is_encrypted, rewrite_text;
+	char *orig_data;
 	GF_SampleEntryBox *entry;
+	Bool use_index;
 
 	if (!mdia || !mdia->information->sampleTable) return GF_BAD_PARAM;
 	if (!mdia->information->sampleTable->SampleSize)
@@ -358,26 +361,37 @@ GF_Err Media_GetSample(GF_MediaBox *mdia, u32 sampleNumber, GF_ISOSample **samp,
 	//OK, here we go....
 	if (sampleNumber > mdia->information->sampleTable->SampleSize->sampleCount) return GF_BAD_PARAM;
 
-	//get the DTS
-	e = stbl_GetSampleDTS(mdia->information->sampleTable->TimeToSample, sampleNumber, &(*samp)->DTS);
-	if (e) return e;
-	//the CTS offset
-	if (mdia->information->sampleTable->CompositionOffset) {
-		e = stbl_GetSampleCTS(mdia->information->sampleTable->CompositionOffset , sampleNumber, &(*samp)->CTS_Offset);
-		if (e) return e;
+	use_index = GF_FALSE;
+	if (mdia->information->sampleTable->sample_index)
+		use_index = stbl_UseSampleIndex(mdia->information->sampleTable, sampleNumber, GF_FALSE);
+
+	if (use_index) {
+		//get the DTS, CTS offset and RAP from the index
+		stbl_GetIndexedSample(mdia->information->sampleTable, sampleNumber, &(*samp)->DTS, &(*samp)->CTS_Offset, &(*samp)->IsRAP, NULL, NULL, NULL);
 	} else {
-		(*samp)->CTS_Offset = 0;
+		//get the DTS
+		e = stbl_GetSampleDTS(mdia->information->sampleTable->TimeToSample, sampleNumber, &(*samp)->DTS);
+		if (e) return e;
+		//the CTS offset
+		if (mdia->information->sampleTable->CompositionOffset) {
+			e = stbl_GetSampleCTS(mdia->information->sampleTable->CompositionOffset , sampleNumber, &(*samp)->CTS_Offset);
+			if (e) return e;
+		} else {
+			(*samp)->CTS_Offset = 0;
+		}
 	}
 	//the size
 	e = stbl_GetSampleSize(mdia->information->sampleTable->SampleSize, sampleNumber, &(*samp)->dataLength);
 	if (e) return e;
 	//the RAP
-	if (mdia->information->sampleTable->SyncSample) {
-		e = stbl_GetSampleRAP(mdia->information->sampleTable->SyncSample, sampleNumber, &(*samp)->IsRAP, NULL, NULL);
-		if (e) return e;
-	} else {
-		//if no SyncSample, all samples are sync (cf spec)
-		(*samp)->IsRAP = RAP;
+	if (!use_index) {
+		if (mdia->information->sampleTable->SyncSample) {
+			e = stbl_GetSampleRAP(mdia->information->sampleTable->SyncSample, sampleNumber, &(*samp)->IsRAP, NULL, NULL);
+			if (e) return e;
+		} else {
+			//if no SyncSample, all samples are sync (cf spec)
+			(*samp)->IsRAP = RAP;
+		}
 	}
 	/*overwrite sync sample with sample dep if any*/
 	if (mdia->information->sampleTable->SampleDep) {
@@ -400,8 +414,13 @@ GF_Err Media_GetSample(GF_MediaBox *mdia, u32 sampleNumber, GF_ISOSample **samp,
 	if (!sIDX) return GF_OK;
 
 	(*sIDX) = 0;
-	e = stbl_GetSampleInfos(mdia->information->sampleTable, sampleNumber, &offset, &chunkNumber, sIDX, &isEdited);
-	if (e) return e;
+	if (use_index) {
+		stbl_GetIndexedSample(mdia->information->sampleTable, sampleNumber, NULL, NULL, NULL, &offset, &chunkNumber, sIDX);
+		isEdited = 0;
+	} else {
+		e = stbl_GetSampleInfos(mdia->information->sampleTable, sampleNumber, &offset, &chunkNumber, sIDX, &isEdited);
+		if (e) return e;
+	}
 
 	//then get the DataRef
 	e = Media_GetSampleDesc(mdia, *sIDX, &entry, &dataRefIndex);
@@ -426,10 +445,12 @@ GF_Err Media_GetSample(GF_MediaBox *mdia, u32 sampleNumber, GF_ISOSample **samp,
 	if (out_offset) *out_offset = offset;
 	if (no_data) return GF_OK;
 
-	/*and finally get the data, include padding if needed*/
-	(*samp)->data = (char *) gf_malloc(sizeof(char) * ( (*samp)->dataLength + mdia->mediaTrack->padding_bytes) );
-	if (mdia->mediaTrack->padding_bytes)
-		memset((*samp)->data + (*samp)->dataLength, 0, sizeof(char) * mdia->mediaTrack->padding_bytes);
+	is_encrypted = gf_isom_is_track_encrypted(mdia->mediaTrack->moov->mov, gf_isom_get_tracknum_from_id(mdia->mediaTrack->moov, mdia->mediaTrack->Header->trackID));
+	is_nalu = (gf_isom_is_nalu_based_entry(mdia, entry) && !is_encrypted) ? GF_TRUE : GF_FALSE;
+	rewrite_text = (mdia->mediaTrack->moov->mov->convert_streaming_text
+	                && ((mdia->handler->handlerType == GF_ISOM_MEDIA_TEXT) || (mdia->handler->handlerType == GF_ISOM_MEDIA_SUBT))
+	                && (entry->type == GF_ISOM_BOX_TYPE_TX3G || entry->type == GF_ISOM_BOX_TYPE_TEXT)
+	               ) ? GF_TRUE : GF_FALSE;
 
 	//check if we can get the sample (make sure we have enougth data...)
 	new_size = gf_bs_get_size(mdia->information->dataHandler->bs);
@@ -442,28 +463,63 @@ GF_Err Media_GetSample(GF_MediaBox *mdia, u32 sampleNumber, GF_ISOSample **samp,
 		}
 	}
 
+	/*reused sample: point to the file mapping if the payload is used as is*/
+	if (static_sample) {
+		const char *mapped = NULL;
+		if (!mdia->mediaTrack->padding_bytes && !is_encrypted && !rewrite_text
+		        && (mdia->handler->handlerType != GF_ISOM_MEDIA_OD)
+		        && (!is_nalu || !gf_isom_nalu_sample_rewrite_needed(mdia, (GF_MPEGVisualSampleEntryBox *)entry))
+		   ) {
+			mapped = gf_isom_datamap_get_mapped_data(mdia->information->dataHandler, (*samp)->dataLength, offset);
+		}
+		if (mapped) {
+			if (!(*samp)->is_borrowed && (*samp)->data) gf_free((*samp)->data);
+			(*samp)->data = (char *) mapped;
+			(*samp)->alloc_size = 0;
+			(*samp)->is_borrowed = GF_TRUE;
+			mdia->BytesMissing = 0;
+			/*NALU inspection may still update the RAP flag, the payload is not modified*/
+			if (is_nalu) {
+				e = gf_isom_nalu_sample_rewrite(mdia, *samp, sampleNumber, (GF_MPEGVisualSampleEntryBox *)entry);
+				if (e) return e;
+			}
+			return GF_OK;
+		}
+		if ((*samp)->is_borrowed) {
+			(*samp)->data = NULL;
+			(*samp)->alloc_size = 0;
+			(*samp)->is_borrowed = GF_FALSE;
+		}
+	}
+
+	/*and finally get the data, include padding if needed*/
+	data_size = (*samp)->dataLength + mdia->mediaTrack->padding_bytes;
+	if (!static_sample) {
+		(*samp)->data = (char *) gf_malloc(sizeof(char) * data_size);
+	} else if (!(*samp)->data || ((*samp)->alloc_size < data_size)) {
+		(*samp)->data = (char *) gf_realloc((*samp)->data, sizeof(char) * data_size);
+		(*samp)->alloc_size = data_size;
+	}
+	if (mdia->mediaTrack->padding_bytes)
+		memset((*samp)->data + (*samp)->dataLength, 0, sizeof(char) * mdia->mediaTrack->padding_bytes);
+
 	bytesRead = gf_isom_datamap_get_data(mdia->information->dataHandler, (*samp)->data, (*samp)->dataLength, offset);
 	//if bytesRead != sampleSize, we have an IO err
 	if (bytesRead < (*samp)->dataLength) {
 		return GF_IO_ERR;
 	}
 	mdia->BytesMissing = 0;
+	orig_data = (*samp)->data;
+	e = GF_OK;
 	//finally rewrite the sample if this is an OD Access Unit
 	if (mdia->handler->handlerType == GF_ISOM_MEDIA_OD) {
 		e = Media_RewriteODFrame(mdia, *samp);
-		if (e) return e;
 	}
 	/*FIXME: we do NOT rewrite sample if we have a encrypted track*/
-	else if (gf_isom_is_nalu_based_entry(mdia, entry) &&
-	         !gf_isom_is_track_encrypted(mdia->mediaTrack->moov->mov, gf_isom_get_tracknum_from_id(mdia->mediaTrack->moov, mdia->mediaTrack->Header->trackID))
-	        ) {
+	else if (is_nalu) {
 		e = gf_isom_nalu_sample_rewrite(mdia, *samp, sampleNumber, (GF_MPEGVisualSampleEntryBox *)entry);
-		if (e) return e;
 	}
-	else if (mdia->mediaTrack->moov->mov->convert_streaming_text
-	         && ((mdia->handler->handlerType == GF_ISOM_MEDIA_TEXT) || (mdia->handler->handlerType == GF_ISOM_MEDIA_SUBT))
-	         && (entry->type == GF_ISOM_BOX_TYPE_TX3G || entry->type == GF_ISOM_BOX_TYPE_TEXT)
-	        ) {
+	else if (rewrite_text) {
 		u64 dur;
 		if (sampleNumber == mdia->information->sampleTable->SampleSize->sampleCount) {
 			dur = mdia->mediaHeader->duration - (*samp)->DTS;
@@ -472,9 +528,13 @@ GF_Err Media_GetSample(GF_MediaBox *mdia, u32 sampleNumber, GF_ISOSample **samp,
 			dur -= (*samp)->DTS;
 		}
 		e = gf_isom_rewrite_text_sample(*samp, *sIDX, (u32) dur);
-		if (e) return e;
 	}
-	return GF_OK;
+	/*rewriting may have reallocated the payload, only trust what we know of the new buffer*/
+	if (static_sample) {
+		if ((*samp)->data != orig_data) (*samp)->alloc_size = (*samp)->dataLength;
+		else if ((*samp)->alloc_size < (*samp)->dataLength) (*samp)->alloc_size = (*samp)->dataLength;
+	}
+	return e;
 }
 
 
@@ -741,6 +741,60 @@ static u64 moof_get_earliest_cts(GF_MovieFragmentBox *moof, u32 refTrackID)
 	return cts;
 }
 
+static void WriteFragmentReferenceTime(GF_ISOFile *movie, GF_BitStream *bs)
+{
+	gf_bs_write_u32(bs, 8*4);
+	gf_bs_write_u32(bs, GF_4CC('p','r','f','t') );
+	gf_bs_write_u8(bs, 1);
+	gf_bs_write_u24(bs, 0);
+	gf_bs_write_u32(bs, movie->moof->reference_track_ID);
+	gf_bs_write_u64(bs, movie->moof->ntp);
+	gf_bs_write_u64(bs, movie->moof->timestamp);
+}
+
+/*writes the moof in the space reserved before its mdat, the unused space is kept as a free box before the moof so
+that the moof is immediately followed by its media data*/
+static GF_Err WriteMoofInReservedSpace(GF_ISOFile *movie, GF_BitStream *bs, Bool *done)
+{
+	GF_Err e;
+	u32 i, size, free_size;
+	u64 pos;
+	GF_TrackFragmentBox *traf;
+
+	*done = GF_FALSE;
+	e = gf_isom_box_size((GF_Box *) movie->moof);
+	if (e) return e;
+	size = (u32) movie->moof->size;
+	if (movie->moof->ntp) size += 8*4;
+	free_size = (u32) (movie->moof->fragment_offset - movie->moof_reserved_offset);
+	if ((size > free_size) || ((size < free_size) && (free_size - size < 8))) {
+		GF_LOG(GF_LOG_WARNING, GF_LOG_CONTAINER, ("[iso fragment] Reserved moof space too small (%d bytes for %d bytes), moving fragment data\n", free_size, size));
+		return GF_OK;
+	}
+	free_size -= size;
+
+	pos = gf_bs_get_position(bs);
+	e = gf_bs_seek(bs, movie->moof_reserved_offset);
+	if (e) return e;
+	if (free_size) {
+		gf_bs_write_u32(bs, free_size);
+		gf_bs_write_u32(bs, GF_ISOM_BOX_TYPE_FREE);
+		e = gf_bs_seek(bs, movie->moof_reserved_offset + free_size);
+		if (e) return e;
+	}
+	if (movie->moof->ntp) WriteFragmentReferenceTime(movie, bs);
+
+	i=0;
+	while ((traf = (GF_TrackFragmentBox*)gf_list_enum(movie->moof->TrackList, &i))) {
+		traf->moof_start_in_bs = gf_bs_get_position(bs);
+	}
+	e = gf_isom_box_write((GF_Box *) movie->moof, bs);
+	if (e) return e;
+
+	*done = GF_TRUE;
+	return gf_bs_seek(bs, pos);
+}
+
 GF_Err StoreFragment(GF_ISOFile *movie, Bool load_mdat_only, s32 data_offset_diff, u32 *moof_size)
 {
 	GF_Err e;
@@ -812,7 +866,7 @@ GF_Err StoreFragment(GF_ISOFile *movie, Bool load_mdat_only, s32 data_offset_dif
 
 	moof_start = gf_bs_get_position(bs);
 
-	if (movie->moof->ntp) {
+	if (movie->moof->ntp && !movie->moof_reserved_offset) {
 		moof_start += 8*4;
 	}
 
@@ -855,12 +909,32 @@ GF_Err StoreFragment(GF_ISOFile *movie, Bool load_mdat_only, s32 data_offset_dif
 		}
 	}
 
+	/*space reserved for the moof, no need to move the mdat*/
+	if (movie->moof_reserved_offset) {
+		Bool done;
+		e = WriteMoofInReservedSpace(movie, bs, &done);
+		if (e) return e;
+		if (done) {
+			movie->moof_reserved_offset = 0;
+			if (moof_size) *moof_size = (u32) movie->moof->size;
+			gf_isom_box_del((GF_Box *) movie->moof);
+			movie->moof = NULL;
+			return GF_OK;
+		}
+	}
+
 	buffer = NULL;
 	/*rewind bitstream and load mdat in memory */
 	if (movie->moof_first && !movie->moof->mdat) {
 		buffer = (char*)gf_malloc(sizeof(char)*mdat_size);
 		gf_bs_seek(bs, movie->moof->fragment_offset);
 		gf_bs_read_data(bs, buffer, mdat_size);
+		/*the moof did not fit in the reserved space, overwrite it*/
+		if (movie->moof_reserved_offset) {
+			data_offset_diff -= (s32) (movie->moof->fragment_offset - movie->moof_reserved_offset);
+			movie->moof->fragment_offset = movie->moof_reserved_offset;
+			movie->moof_reserved_offset = 0;
+		}
 		/*back to mdat start and erase with moov*/
 		gf_bs_seek(bs, movie->moof->fragment_offset);
 		gf_bs_truncate(bs);
@@ -896,13 +970,7 @@ GF_Err StoreFragment(GF_ISOFile *movie, Bool load_mdat_only, s32 data_offset_dif
 
 
 	if (movie->moof->ntp) {
-		gf_bs_write_u32(bs, 8*4);
-		gf_bs_write_u32(bs, GF_4CC('p','r','f','t') );
-		gf_bs_write_u8(bs, 1);
-		gf_bs_write_u24(bs, 0);
-		gf_bs_write_u32(bs, movie->moof->reference_track_ID);
-		gf_bs_write_u64(bs, movie->moof->ntp);
-		gf_bs_write_u64(bs, movie->moof->timestamp);
+		WriteFragmentReferenceTime(movie, bs);
 	}
 
 	pos = gf_bs_get_position(bs);
@@ -1082,6 +1150,13 @@ GF_Err gf_isom_flush_fragments(GF_ISOFile *movie, Bool last_segment)
 	return GF_OK;
 }
 
+GF_EXPORT
+u64 gf_isom_get_segment_write_offset(GF_ISOFile *movie)
+{
+	if (!movie || !(movie->FragmentsFlags & GF_ISOM_FRAG_WRITE_READY) ) return 0;
+	return movie->segment_start;
+}
+
 typedef struct
 {
 	GF_SegmentIndexBox *sidx;
@@ -1642,6 +1717,14 @@ GF_Err gf_isom_start_fragment(GF_ISOFile *movie, Bool moof_first)
 		gf_list_add(movie->moof_list, movie->moof);
 
 
+	/*space for the moof, filled in as a free box until the fragment is stored*/
+	movie->moof_reserved_offset = 0;
+	if (movie->moof_first && movie->moof_reserved_size && !movie->use_segments) {
+		movie->moof_reserved_offset = gf_bs_get_position(movie->editFileMap->bs);
+		e = gf_isom_write_free_box(movie->editFileMap->bs, movie->moof_reserved_size);
+		if (e) return e;
+	}
+
 	/*remember segment offset*/
 	movie->moof->fragment_offset = gf_bs_get_position(movie->editFileMap->bs);
 	/*prepare MDAT*/
@@ -1663,6 +1746,12 @@ GF_Err gf_isom_start_fragment(GF_ISOFile *movie, Bool moof_first)
 	return GF_OK;
 }
 
+GF_EXPORT
+GF_Err gf_isom_reserve_moof_space(GF_ISOFile *movie, u32 size)
+{
+	return gf_isom_set_reserved_space(movie, &movie->moof_reserved_size, size);
+}
+
 u32 GetRunSize(GF_TrackFragmentRunBox *trun)
 {
 	u32 i, size;
@@ -2098,6 +2187,11 @@ GF_Err gf_isom_start_fragment(GF_ISOFile *the_file, u32 free_data_insert_size)
 	return GF_NOT_SUPPORTED;
 }
 
+GF_Err gf_isom_reserve_moof_space(GF_ISOFile *movie, u32 size)
+{
+	return GF_NOT_SUPPORTED;
+}
+
 GF_Err gf_isom_fragment_add_sample(GF_ISOFile *the_file, u32 TrackID, const GF_ISOSample *sample, u32 DescIndex,
                                    u32 Duration, u8 PaddingBits, u16 DegradationPriority, Bool redCoded)
 {
@@ -43,6 +43,27 @@ GF_Err findEntryForTime(GF_SampleTableBox *stbl, u64 DTS, u8 useCTS, u32 *sample
 	decoding order. */
 	useCTS = 0;
 
+	//binary search in the sample index
+	if (stbl->sample_index && stbl_UseSampleIndex(stbl, 0, GF_TRUE)) {
+		u32 low = 1;
+		u32 high = stbl->sample_index->nb_samples + 1;
+		while (low < high) {
+			u32 mid = low + (high - low) / 2;
+			stbl_GetIndexedSample(stbl, mid, &curDTS, NULL, NULL, NULL, NULL, NULL);
+			if (curDTS < DTS) low = mid + 1;
+			else high = mid;
+		}
+		//no sample at or after this time
+		if (low > stbl->sample_index->nb_samples) return GF_OK;
+		stbl_GetIndexedSample(stbl, low, &curDTS, NULL, NULL, NULL, NULL, NULL);
+		if (curDTS == DTS) {
+			(*sampleNumber) = low;
+		} else {
+			(*prevSampleNumber) = (low != 1) ? low - 1 : 1;
+		}
+		return GF_OK;
+	}
+
 	//our cache
 	if (stbl->TimeToSample->r_FirstSampleInEntry &&
 	        (DTS >= stbl->TimeToSample->r_CurrentDTS) ) {
@@ -242,7 +263,15 @@ GF_Err stbl_GetSampleRAP(GF_SyncSampleBox *stss, u32 SampleNumber, SAPType *IsRA
 	if (stss->r_LastSyncSample && (stss->r_LastSyncSample < SampleNumber) ) {
 		i = stss->r_LastSampleIndex;
 	} else {
-		i = 0;
+		u32 low = 0;
+		u32 high = stss->nb_entries;
+		//cache miss (seek): locate the last sync sample before this sample
+		while (low < high) {
+			u32 mid = low + (high - low) / 2;
+			if (stss->sampleNumbers[mid] < SampleNumber) low = mid + 1;
+			else high = mid;
+		}
+		i = low ? low - 1 : 0;
 	}
 	for (; i < stss->nb_entries; i++) {
 		//get the entry
@@ -618,4 +647,233 @@ u32 stbl_GetSampleFragmentSize(GF_SampleFragmentBox *stsf, u32 sampleNumber, u32
 	return 0;
 }
 
+void stbl_SetSampleIndex(GF_SampleTableBox *stbl, Bool enable)
+{
+	if (!stbl) return;
+	if (enable) {
+		if (!stbl->sample_index) GF_SAFEALLOC(stbl->sample_index, GF_SampleIndex);
+		return;
+	}
+	if (!stbl->sample_index) return;
+	if (stbl->sample_index->blocks) gf_free(stbl->sample_index->blocks);
+	if (stbl->sample_index->samples) gf_free(stbl->sample_index->samples);
+	gf_free(stbl->sample_index);
+	stbl->sample_index = NULL;
+}
+
+static u64 stbl_GetChunkOffset(GF_SampleTableBox *stbl, u32 chunkNumber)
+{
+	if (stbl->ChunkOffset->type == GF_ISOM_BOX_TYPE_STCO) {
+		return ((GF_ChunkOffsetBox *)stbl->ChunkOffset)->offsets[chunkNumber - 1];
+	}
+	return ((GF_ChunkLargeOffsetBox *)stbl->ChunkOffset)->offsets[chunkNumber - 1];
+}
+
+//packs the pending samples of a block, using the smallest offset of the block as base offset
+static GF_Err stbl_PackIndexBlock(GF_SampleIndex *idx, u32 first_sample, u32 nb_samp, u64 *offsets, u64 *dts, u32 *chunks)
+{
+	u32 i;
+	GF_SampleIndexBlock *block = &idx->blocks[(first_sample - 1) / GF_ISOM_SAMPLE_INDEX_BLOCK];
+
+	block->offset = offsets[0];
+	for (i=1; i<nb_samp; i++) {
+		if (offsets[i] < block->offset) block->offset = offsets[i];
+	}
+	block->DTS = dts[0];
+	block->chunk = chunks[0];
+	for (i=0; i<nb_samp; i++) {
+		GF_SampleIndexEntry *ent = &idx->samples[first_sample - 1 + i];
+		if (offsets[i] - block->offset > 0xFFFFFFFFUL) return GF_NOT_SUPPORTED;
+		if (dts[i] - block->DTS > 0xFFFFFFFFUL) return GF_NOT_SUPPORTED;
+		if (chunks[i] - block->chunk > 0xFFFF) return GF_NOT_SUPPORTED;
+		ent->offset_delta = (u32) (offsets[i] - block->offset);
+		ent->dts_delta = (u32) (dts[i] - block->DTS);
+		ent->chunk_delta = (u16) (chunks[i] - block->chunk);
+	}
+	return GF_OK;
+}
+
+static GF_Err stbl_BuildSampleIndex(GF_SampleTableBox *stbl)
+{
+	GF_Err e;
+	GF_SampleIndex *idx = stbl->sample_index;
+	GF_SampleToChunkBox *stsc = stbl->SampleToChunk;
+	GF_TimeToSampleBox *stts = stbl->TimeToSample;
+	GF_CompositionOffsetBox *ctts = stbl->CompositionOffset;
+	GF_SyncSampleBox *stss = stbl->SyncSample;
+	GF_StscEntry *ent;
+	u32 i, nb_samples, nb_chunks, stsc_idx, chunk_in_entry, samp_in_chunk, chunk, size, pos;
+	u32 stts_idx, stts_left, stts_delta, ctts_idx, ctts_left, stss_idx, dur;
+	s32 cts_offset;
+	u64 dts, offset, last_dts;
+	u64 b_offsets[GF_ISOM_SAMPLE_INDEX_BLOCK], b_dts[GF_ISOM_SAMPLE_INDEX_BLOCK];
+	u32 b_chunks[GF_ISOM_SAMPLE_INDEX_BLOCK];
+
+	if (!stbl->SampleSize || !stts || !stsc || !stsc->nb_entries || !stbl->ChunkOffset) return GF_NOT_SUPPORTED;
+	nb_samples = stbl->SampleSize->sampleCount;
+	if (!nb_samples) return GF_NOT_SUPPORTED;
+	if (stbl->ChunkOffset->type == GF_ISOM_BOX_TYPE_STCO) {
+		nb_chunks = ((GF_ChunkOffsetBox *)stbl->ChunkOffset)->nb_entries;
+	} else {
+		nb_chunks = ((GF_ChunkLargeOffsetBox *)stbl->ChunkOffset)->nb_entries;
+	}
+	/*same shortcut as stbl_GetSampleInfos: one entry per sample*/
+	if ((stsc->nb_entries == nb_samples) && (nb_chunks < nb_samples)) return GF_NOT_SUPPORTED;
+
+	if (idx->samples) gf_free(idx->samples);
+	if (idx->blocks) gf_free(idx->blocks);
+	idx->samples = (GF_SampleIndexEntry *) gf_malloc(sizeof(GF_SampleIndexEntry) * nb_samples);
+	idx->blocks = (GF_SampleIndexBlock *) gf_malloc(sizeof(GF_SampleIndexBlock) * (1 + (nb_samples - 1) / GF_ISOM_SAMPLE_INDEX_BLOCK));
+	idx->nb_samples = 0;
+	if (!idx->samples || !idx->blocks) return GF_OUT_OF_MEM;
+
+	stsc_idx = 0;
+	ent = &stsc->entries[0];
+	GetGhostNum(ent, 0, stsc->nb_entries, stbl);
+	chunk_in_entry = 1;
+	samp_in_chunk = 0;
+	chunk = 0;
+	offset = 0;
+	stts_idx = stts_left = stts_delta = 0;
+	ctts_idx = ctts_left = 0;
+	cts_offset = 0;
+	stss_idx = 0;
+	dts = 0;
+
+	for (i=1; i<=nb_samples; i++) {
+		GF_SampleIndexEntry *s_ent = &idx->samples[i-1];
+		u32 descIndex;
+		pos = (i-1) % GF_ISOM_SAMPLE_INDEX_BLOCK;
+
+		//timing - samples not described in stts are not indexed
+		while (!stts_left && (stts_idx < stts->nb_entries)) {
+			stts_left = stts->entries[stts_idx].sampleCount;
+			stts_delta = stts->entries[stts_idx].sampleDelta;
+			stts_idx++;
+		}
+		if (!stts_left) return GF_NOT_SUPPORTED;
+		b_dts[pos] = dts;
+		dts += stts_delta;
+		stts_left--;
+		if (ctts) {
+			while (!ctts_left && (ctts_idx < ctts->nb_entries)) {
+				ctts_left = ctts->entries[ctts_idx].sampleCount;
+				cts_offset = ctts->entries[ctts_idx].decodingOffset;
+				ctts_idx++;
+			}
+			if (ctts_left) {
+				ctts_left--;
+			} else {
+				cts_offset = 0;
+			}
+		}
+		s_ent->CTS_Offset = cts_offset;
+
+		//data location
+		if (stsc->nb_entries == nb_samples) {
+			descIndex = stsc->entries[i-1].sampleDescriptionIndex;
+			chunk = i;
+			offset = stbl_GetChunkOffset(stbl, i);
+		} else {
+			Bool new_chunk = chunk ? GF_FALSE : GF_TRUE;
+			while (samp_in_chunk >= ent->samplesPerChunk) {
+				samp_in_chunk = 0;
+				chunk_in_entry++;
+				if (chunk_in_entry > stsc->ghostNumber) {
+					//sample not found in stsc
+					if (stsc_idx + 1 >= stsc->nb_entries) return GF_ISOM_INVALID_FILE;
+					stsc_idx++;
+					ent = &stsc->entries[stsc_idx];
+					GetGhostNum(ent, stsc_idx, stsc->nb_entries, stbl);
+					chunk_in_entry = 1;
+				}
+				new_chunk = GF_TRUE;
+			}
+			if (new_chunk) {
+				chunk = ent->firstChunk + chunk_in_entry - 1;
+				if (!chunk || (chunk > nb_chunks)) return GF_ISOM_INVALID_FILE;
+				offset = stbl_GetChunkOffset(stbl, chunk);
+			}
+			descIndex = ent->sampleDescriptionIndex;
+			samp_in_chunk++;
+		}
+		if (descIndex > 0x7FFF) return GF_NOT_SUPPORTED;
+		b_offsets[pos] = offset;
+		b_chunks[pos] = chunk;
+		e = stbl_GetSampleSize(stbl->SampleSize, i, &size);
+		if (e) return e;
+		offset += size;
+
+		//sync
+		s_ent->desc_sync = (u16) descIndex;
+		if (stss) {
+			while ((stss_idx < stss->nb_entries) && (stss->sampleNumbers[stss_idx] < i)) stss_idx++;
+			if ((stss_idx < stss->nb_entries) && (stss->sampleNumbers[stss_idx] == i)) s_ent->desc_sync |= 0x8000;
+		} else {
+			s_ent->desc_sync |= 0x8000;
+		}
+
+		if ((pos + 1 == GF_ISOM_SAMPLE_INDEX_BLOCK) || (i == nb_samples)) {
+			e = stbl_PackIndexBlock(idx, i - pos, pos + 1, b_offsets, b_dts, b_chunks);
+			if (e) return e;
+		}
+	}
+	stbl_GetSampleDTS_and_Duration(stts, nb_samples, &last_dts, &dur);
+	idx->last_duration = dur;
+	idx->nb_samples = nb_samples;
+	GF_LOG(GF_LOG_DEBUG, GF_LOG_CONTAINER, ("[iso file] Sample index built for %d samples\n", nb_samples));
+	return GF_OK;
+}
+
+Bool stbl_UseSampleIndex(GF_SampleTableBox *stbl, u32 sampleNumber, Bool is_seek)
+{
+	GF_SampleIndex *idx = stbl->sample_index;
+	if (!idx || idx->failed || !stbl->SampleSize) return GF_FALSE;
+
+	if (!idx->nb_samples) {
+		//sequential access, regular table lookup is as fast as it gets
+		if (!is_seek && ((sampleNumber == idx->last_sample) || (sampleNumber == idx->last_sample + 1))) {
+			idx->last_sample = sampleNumber;
+			return GF_FALSE;
+		}
+		if (stbl_BuildSampleIndex(stbl) != GF_OK) {
+			GF_LOG(GF_LOG_DEBUG, GF_LOG_CONTAINER, ("[iso file] Cannot build sample index, using regular sample table lookup\n"));
+			if (idx->blocks) gf_free(idx->blocks);
+			if (idx->samples) gf_free(idx->samples);
+			idx->blocks = NULL;
+			idx->samples = NULL;
+			idx->nb_samples = 0;
+			idx->failed = GF_TRUE;
+			return GF_FALSE;
+		}
+	}
+	//tables have been modified since the index was built
+	if (idx->nb_samples != stbl->SampleSize->sampleCount) return GF_FALSE;
+	if (sampleNumber > idx->nb_samples) return GF_FALSE;
+	return GF_TRUE;
+}
+
+void stbl_GetIndexedSample(GF_SampleTableBox *stbl, u32 sampleNumber, u64 *DTS, s32 *CTS_Offset, SAPType *IsRAP, u64 *offset, u32 *chunkNumber, u32 *descIndex)
+{
+	GF_SampleIndex *idx = stbl->sample_index;
+	GF_SampleIndexBlock *block = &idx->blocks[(sampleNumber - 1) / GF_ISOM_SAMPLE_INDEX_BLOCK];
+	GF_SampleIndexEntry *ent = &idx->samples[sampleNumber - 1];
+
+	if (DTS) *DTS = block->DTS + ent->dts_delta;
+	if (CTS_Offset) *CTS_Offset = ent->CTS_Offset;
+	if (IsRAP) *IsRAP = (ent->desc_sync & 0x8000) ? RAP : RAP_NO;
+	if (offset) *offset = block->offset + ent->offset_delta;
+	if (chunkNumber) *chunkNumber = block->chunk + ent->chunk_delta;
+	if (descIndex) *descIndex = ent->desc_sync & 0x7FFF;
+}
+
+u32 stbl_GetIndexedSampleDuration(GF_SampleTableBox *stbl, u32 sampleNumber)
+{
+	u64 dts, next_dts;
+	if (sampleNumber == stbl->sample_index->nb_samples) return stbl->sample_index->last_duration;
+	stbl_GetIndexedSample(stbl, sampleNumber, &dts, NULL, NULL, NULL, NULL, NULL);
+	stbl_GetIndexedSample(stbl, sampleNumber + 1, &next_dts, NULL, NULL, NULL, NULL, NULL);
+	return (u32) (next_dts - dts);
+}
+
 #endif /*GPAC_DISABLE_ISOM*/
@@ -28,6 +28,7 @@
 #include <gpac/mpegts.h>
 #include <gpac/config_file.h>
 #include <gpac/network.h>
+#include <gpac/thread.h>
 #ifdef _WIN32_WCE
 #include <winbase.h>
 #else
@@ -110,7 +111,15 @@ struct __gf_dash_segmenter
 	Double mpd_live_duration;
 	Bool insert_utc;
 	Bool real_time;
+	/*low-latency chunked output: chunk duration in seconds and chunk notification*/
+	Double chunk_duration;
+	gf_dasher_chunk_callback on_chunk;
+	void *on_chunk_udta;
 	const char *dash_profile_extension;
+	/*max number of representations of an adaptation set segmented in parallel*/
+	u32 nb_threads;
+	/*set on the configuration of representations segmented by worker threads, progress is not reported*/
+	Bool no_progress;
 
 	GF_Config *dash_ctx;
 
@@ -396,6 +405,18 @@ GF_Err gf_dasher_store_segment_info(GF_DASHSegmenter *dash_cfg, const char *repr
 
 #ifndef GPAC_DISABLE_ISOM
 
+/*same as gf_4cc_to_str but using the caller buffer, since representations may be segmented by several threads*/
+static const char *dasher_4cc_to_str(u32 type, char szType[5])
+{
+	u32 i, ch;
+	for (i = 0; i < 4; i++) {
+		ch = type >> (8 * (3-i) ) & 0xff;
+		szType[i] = ( ch >= 0x20 && ch <= 0x7E ) ? ch : '.';
+	}
+	szType[4] = 0;
+	return szType;
+}
+
 GF_EXPORT
 GF_Err gf_media_get_rfc_6381_codec_name(GF_ISOFile *movie, u32 track, char *szCodec, Bool force_inband, Bool force_sbr)
 {
@@ -404,6 +425,7 @@ GF_Err gf_media_get_rfc_6381_codec_name(GF_ISOFile *movie, u32 track, char *szCo
 #ifndef GPAC_DISABLE_HEVC
 	GF_HEVCConfig *hvcc;
 #endif
+	char szType[5];
 
 	u32 subtype = gf_isom_get_media_subtype(movie, track, 1);
 
@@ -417,7 +439,7 @@ GF_Err gf_media_get_rfc_6381_codec_name(GF_ISOFile *movie, u32 track, char *szCo
 		} else if(gf_isom_is_cenc_media(movie, track, 1)) {
 			e = gf_isom_get_cenc_info(movie, track, 1, &originalFormat, NULL, NULL, NULL);
 		} else {
-			GF_LOG(GF_LOG_WARNING, GF_LOG_AUTHOR, ("[ISOM Tools] Unkown protection scheme type %s\n", gf_4cc_to_str( gf_isom_is_media_encrypted(movie, track, 1)) ));
+			GF_LOG(GF_LOG_WARNING, GF_LOG_AUTHOR, ("[ISOM Tools] Unkown protection scheme type %s\n", dasher_4cc_to_str(gf_isom_is_media_encrypted(movie, track, 1), szType) ));
 			e = gf_isom_get_original_format_type(movie, track, 1, &originalFormat);
 		}
 		if (e) {
@@ -485,12 +507,12 @@ GF_Err gf_media_get_rfc_6381_codec_name(GF_ISOFile *movie, u32 track, char *szCo
 			else if (subtype==GF_ISOM_SUBTYPE_AVC2_H264)
 				subtype = GF_ISOM_SUBTYPE_AVC4_H264;
 		}
-		sprintf(szCodec, "%s.%02x%02x%02x", gf_4cc_to_str(subtype), avcc->AVCProfileIndication, avcc->profile_compatibility, avcc->AVCLevelIndication);
+		sprintf(szCodec, "%s.%02x%02x%02x", dasher_4cc_to_str(subtype, szType), avcc->AVCProfileIndication, avcc->profile_compatibility, avcc->AVCLevelIndication);
 		gf_odf_avc_cfg_del(avcc);
 		return GF_OK;
 	case GF_ISOM_SUBTYPE_SVC_H264:
 		avcc = gf_isom_svc_config_get(movie, track, 1);
-		sprintf(szCodec, "%s.%02x%02x%02x", gf_4cc_to_str(subtype), avcc->AVCProfileIndication, avcc->profile_compatibility, avcc->AVCLevelIndication);
+		sprintf(szCodec, "%s.%02x%02x%02x", dasher_4cc_to_str(subtype, szType), avcc->AVCProfileIndication, avcc->profile_compatibility, avcc->AVCLevelIndication);
 		gf_odf_avc_cfg_del(avcc);
 		return GF_OK;
 #ifndef GPAC_DISABLE_HEVC
@@ -518,7 +540,7 @@ GF_Err gf_media_get_rfc_6381_codec_name(GF_ISOFile *movie, u32 track, char *szCo
 		if (hvcc) {
 			u8 c;
 			char szTemp[40];
-			sprintf(szCodec, "%s.", gf_4cc_to_str(subtype));
+			sprintf(szCodec, "%s.", dasher_4cc_to_str(subtype, szType));
 			if (hvcc->profile_space==1) strcat(szCodec, "A");
 			else if (hvcc->profile_space==2) strcat(szCodec, "B");
 			else if (hvcc->profile_space==3) strcat(szCodec, "C");
@@ -577,14 +599,14 @@ GF_Err gf_media_get_rfc_6381_codec_name(GF_ISOFile *movie, u32 track, char *szCo
 
 			gf_odf_hevc_cfg_del(hvcc);
 		} else {
-			sprintf(szCodec, "%s", gf_4cc_to_str(subtype));
+			sprintf(szCodec, "%s", dasher_4cc_to_str(subtype, szType));
 		}
 		return GF_OK;
 #endif
 
 	default:
-		GF_LOG(GF_LOG_DEBUG, GF_LOG_AUTHOR, ("[ISOM Tools] codec parameters not known - setting codecs string to default value \"%s\"\n", gf_4cc_to_str(subtype) ));
-		sprintf(szCodec, "%s", gf_4cc_to_str(subtype));
+		GF_LOG(GF_LOG_DEBUG, GF_LOG_AUTHOR, ("[ISOM Tools] codec parameters not known - setting codecs string to default value \"%s\"\n", dasher_4cc_to_str(subtype, szType) ));
+		sprintf(szCodec, "%s", dasher_4cc_to_str(subtype, szType));
 		return GF_OK;
 	}
 	return GF_OK;
@@ -643,11 +665,12 @@ static GF_Err gf_isom_write_content_protection(GF_ISOFile *input, FILE *mpd, u32
 	u32 prot_scheme	= gf_isom_is_media_encrypted(input, protected_track, 1);
 	if (gf_isom_is_cenc_media(input, protected_track, 1)) {
 		bin128 default_KID;
+		char szType[5];
 		u8 i;
 		gf_isom_cenc_get_default_info(input, protected_track, 1, NULL, NULL, &default_KID);
 		for (i=0; i<indent; i++)
 			fprintf(mpd, " ");
-		fprintf(mpd, "<ContentProtection schemeIdUri=\"urn:mpeg:dash:mp4protection:2011\" value=\"%s\" cenc:default_KID=\"", gf_4cc_to_str(prot_scheme) );
+		fprintf(mpd, "<ContentProtection schemeIdUri=\"urn:mpeg:dash:mp4protection:2011\" value=\"%s\" cenc:default_KID=\"", dasher_4cc_to_str(prot_scheme, szType) );
 		/* Output canonical UIID form */
 		for (i=0; i<4; i++) fprintf(mpd, "%02x", default_KID[i]);
 		fprintf(mpd, "-");
@@ -738,6 +761,60 @@ static Bool is_splitable(u32 media_type) {
 	}
 }
 
+/*fetches a sample reusing the sample object (and its buffer) of a previously released sample, if any*/
+static GF_ISOSample *dasher_get_sample(GF_ISOFile *input, u32 track, u32 sampleNumber, u32 *descIndex, GF_ISOSample **recycled)
+{
+	GF_ISOSample *samp = *recycled;
+	*recycled = NULL;
+	if (!samp) samp = gf_isom_sample_new();
+	if (!samp) return NULL;
+	if (gf_isom_get_sample_ex(input, track, sampleNumber, descIndex, samp) != GF_OK) {
+		gf_isom_sample_release(samp);
+		*recycled = samp;
+		return NULL;
+	}
+	return samp;
+}
+
+static void dasher_release_sample(GF_ISOSample **samp, GF_ISOSample **recycled)
+{
+	if (! *samp) return;
+	if (! *recycled) {
+		gf_isom_sample_release(*samp);
+		*recycled = *samp;
+		*samp = NULL;
+	} else {
+		gf_isom_sample_del(samp);
+	}
+}
+
+/*notifies the chunk of the segment written since the last notification*/
+static void dasher_notify_chunk(GF_DASHSegmenter *dash_cfg, GF_ISOFile *output, const char *seg_name, u64 *chunk_offset, Bool last_chunk)
+{
+	u64 pos;
+	if (!dash_cfg->on_chunk) return;
+
+	/*once the segment is closed, its file bitstream is restored*/
+	pos = last_chunk ? gf_isom_get_file_size(output) : gf_isom_get_segment_write_offset(output);
+	if (pos < *chunk_offset) pos = *chunk_offset;
+	if (last_chunk || (pos > *chunk_offset)) {
+		dash_cfg->on_chunk(dash_cfg->on_chunk_udta, seg_name ? seg_name : gf_isom_get_filename(output), *chunk_offset, pos - *chunk_offset, last_chunk);
+	}
+	*chunk_offset = pos;
+}
+
+/*writes the availabilityTimeOffset of the segments: in chunked mode, a segment can be requested as soon as its first chunk is produced*/
+static void dasher_write_availability_time_offset(GF_DASHSegmenter *dash_cfg)
+{
+	Double ato = 0;
+	if (dash_cfg->ast_offset_ms<0) ato = - (Double) dash_cfg->ast_offset_ms / 1000.0;
+	if (dash_cfg->chunk_duration && (dash_cfg->segment_duration - dash_cfg->chunk_duration > ato))
+		ato = dash_cfg->segment_duration - dash_cfg->chunk_duration;
+
+	if (ato) fprintf(dash_cfg->mpd, " availabilityTimeOffset=\"%g\"", ato);
+	if (dash_cfg->chunk_duration) fprintf(dash_cfg->mpd, " availabilityTimeComplete=\"false\"");
+}
+
 static GF_Err gf_media_isom_segment_file(GF_ISOFile *input, const char *output_file, GF_DASHSegmenter *dash_cfg, GF_DashSegInput *dash_input, Bool first_in_set)
 {
 	u8 NbBits;
@@ -753,6 +830,7 @@ static GF_Err gf_media_isom_segment_file(GF_ISOFile *input, const char *output_f
 //	u32 first_seg;
 	GF_ISOFile *output, *bs_switch_segment;
 	GF_ISOSample *sample, *next;
+	GF_ISOSample *recycled_sample = NULL;
 	GF_List *fragmenters;
 	u64 MaxFragmentDuration, MaxSegmentDuration, period_duration;
 	Double segment_start_time, SegmentDuration, maxFragDurationOverSegment;
@@ -776,7 +854,7 @@ static GF_Err gf_media_isom_segment_file(GF_ISOFile *input, const char *output_f
 	u64 previous_segment_duration = 0;
 	u32 segment_timeline_repeat_count = 0;
 	//u64 last_ref_cts = 0;
-	u64 start_range, end_range, file_size, init_seg_size, ref_track_first_dts, ref_track_next_cts;
+	u64 start_range, end_range, file_size, init_seg_size, ref_track_first_dts, ref_track_next_cts, chunk_offset;
 	u32 tfref_timescale = 0;
 	u32 bandwidth = 0;
 	GF_ISOMTrackFragmenter *tf, *tfref;
@@ -1114,6 +1192,8 @@ static GF_Err gf_media_isom_segment_file(GF_ISOFile *input, const char *output_f
 		tf->TrackID = gf_isom_get_track_id(output, TrackNum);
 		tf->SampleCount = gf_isom_get_sample_count(input, i+1);
 		tf->OriginalTrack = i+1;
+		/*SAP lookahead fetches samples out of order, use the sample index when possible (read-only inputs)*/
+		gf_isom_enable_sample_index(input, i+1, GF_TRUE);
 		tf->TimeScale = gf_isom_get_media_timescale(input, i+1);
 		tf->MediaType = gf_isom_get_media_type(input, i+1);
 		tf->DefaultDuration = defaultDuration;
@@ -1329,7 +1409,7 @@ static GF_Err gf_media_isom_segment_file(GF_ISOFile *input, const char *output_f
 		goto err_exit;
 	}
 
-	start_range = 0;
+	start_range = chunk_offset = 0;
 	file_size = gf_isom_get_file_size(bs_switch_segment ? bs_switch_segment : output);
 	init_seg_size = file_size;
 
@@ -1476,6 +1556,7 @@ restart_fragmentation_pass:
 				} else {
 					e = gf_isom_start_segment(output, NULL, dash_cfg->fragments_in_memory);
 				}
+				chunk_offset = gf_isom_get_segment_write_offset(output);
 				if (dash_cfg->pssh_moof)
 					store_pssh = GF_TRUE;
 
@@ -1548,7 +1629,7 @@ restart_fragmentation_pass:
 
 				/*first sample*/
 				if (!sample) {
-					sample = gf_isom_get_sample(input, tf->OriginalTrack, tf->SampleNum + 1, &descIndex);
+					sample = dasher_get_sample(input, tf->OriginalTrack, tf->SampleNum + 1, &descIndex, &recycled_sample);
 					if (!sample) {
 						e = gf_isom_last_error(input);
 						goto err_exit;
@@ -1575,7 +1656,7 @@ restart_fragmentation_pass:
 
 				gf_isom_get_sample_padding_bits(input, tf->OriginalTrack, tf->SampleNum+1, &NbBits);
 
-				next = gf_isom_get_sample(input, tf->OriginalTrack, tf->SampleNum + 2, &j);
+				next = dasher_get_sample(input, tf->OriginalTrack, tf->SampleNum + 2, &j, &recycled_sample);
 				if (next) {
 					defaultDuration = (u32) (next->DTS - sample->DTS);
 				} else {
@@ -1662,7 +1743,7 @@ restart_fragmentation_pass:
 					if (e)
 						goto err_exit;
 
-					gf_set_progress("ISO File Fragmenting", nb_done, nb_samp);
+					if (!dash_cfg->no_progress) gf_set_progress("ISO File Fragmenting", nb_done, nb_samp);
 					nb_done++;
 				}
 
@@ -1670,10 +1751,10 @@ restart_fragmentation_pass:
 				tf->next_sample_dts = sample->DTS + defaultDuration;
 
 				if (split_sample_duration) {
-					gf_isom_sample_del(&next);
+					dasher_release_sample(&next, &recycled_sample);
 					sample->DTS += defaultDuration;
 				} else {
-					gf_isom_sample_del(&sample);
+					dasher_release_sample(&sample, &recycled_sample);
 					sample = next;
 					tf->SampleNum += 1;
 					tf->split_sample_dts_shift = 0;
@@ -1786,7 +1867,7 @@ restart_fragmentation_pass:
 				}
 
 				if (stop_frag) {
-					gf_isom_sample_del(&sample);
+					dasher_release_sample(&sample, &recycled_sample);
 					sample = next = NULL;
 
 					//only compute max dur over segment for the track used for indexing / deriving MPD start time
@@ -1843,6 +1924,7 @@ restart_fragmentation_pass:
 
 			e = gf_isom_flush_fragments(output, flush_all_samples ? GF_TRUE : GF_FALSE);
 			if (e) goto err_exit;
+			dasher_notify_chunk(dash_cfg, output, seg_rad_name ? SegmentName : NULL, &chunk_offset, GF_FALSE);
 
 			nbFragmentInSegment++;
 		}
@@ -1930,6 +2012,7 @@ restart_fragmentation_pass:
 
 				GF_LOG(GF_LOG_DEBUG, GF_LOG_DASH, ("[DASH] Closing segment %s at "LLU" us, at UTC "LLU" - segment AST "LLU" (MPD AST "LLU")\n", SegmentName, gf_sys_clock_high_res(), gf_net_get_utc(), generation_start_utc + period_duration + (u64)segment_start_time, generation_start_utc ));
 				gf_isom_close_segment(output, dash_cfg->enable_sidx ? dash_cfg->subsegs_per_sidx : 0, dash_cfg->enable_sidx ? ref_track_id : 0, ref_track_first_dts, tfref ? tfref->media_time_to_pres_time_shift : tf->media_time_to_pres_time_shift, ref_track_next_cts, dash_cfg->daisy_chain_sidx, last_segment, dash_cfg->segment_marker_4cc, &idx_start_range, &idx_end_range);
+				dasher_notify_chunk(dash_cfg, output, seg_rad_name ? SegmentName : NULL, &chunk_offset, GF_TRUE);
 				nbFragmentInSegment = 0;
 
 				//take care of scalable reps
@@ -2004,6 +2087,7 @@ restart_fragmentation_pass:
 
 		GF_LOG(GF_LOG_DEBUG, GF_LOG_DASH, ("[DASH] Closing segment %s at "LLU" us, at UTC "LLU"\n", SegmentName, gf_sys_clock_high_res(), gf_net_get_utc()));
 		gf_isom_close_segment(output, dash_cfg->enable_sidx ? dash_cfg->subsegs_per_sidx : 0, dash_cfg->enable_sidx ? ref_track_id : 0, ref_track_first_dts, tfref ? tfref->media_time_to_pres_time_shift : tf->media_time_to_pres_time_shift, ref_track_next_cts, dash_cfg->daisy_chain_sidx, GF_TRUE, dash_cfg->segment_marker_4cc, &idx_start_range, &idx_end_range);
+		dasher_notify_chunk(dash_cfg, output, seg_rad_name ? SegmentName : NULL, &chunk_offset, GF_TRUE);
 		nb_segments++;
 
 		if (!seg_rad_name) {
@@ -2119,9 +2203,7 @@ restart_fragmentation_pass:
 			const char *rad_name = gf_dasher_strip_output_dir(dash_cfg->mpd_name, seg_rad_name);
 			gf_media_mpd_format_segment_name(GF_DASH_TEMPLATE_TEMPLATE, is_bs_switching, SegmentName, output_file, dash_input->representationID, NULL, rad_name, !stricmp(seg_ext, "null") ? NULL : seg_ext, 0, 0, 0, dash_cfg->use_segment_timeline);
 			fprintf(dash_cfg->mpd, "   <SegmentTemplate timescale=\"%d\" media=\"%s\" startNumber=\"%d\"", mpd_timeline_bs ? dash_cfg->dash_scale : mpd_timescale, SegmentName, startNumber);
-			if (dash_cfg->ast_offset_ms<0) {
-				fprintf(dash_cfg->mpd, " availabilityTimeOffset=\"%g\"", - (Double) dash_cfg->ast_offset_ms / 1000.0);
-			}
+			dasher_write_availability_time_offset(dash_cfg);
 			if (!dash_cfg->use_segment_timeline) {
 				if (!max_segment_duration)
 					max_segment_duration = dash_cfg->segment_duration;
@@ -2158,9 +2240,7 @@ restart_fragmentation_pass:
 				if (presentationTimeOffset)
 					fprintf(dash_cfg->mpd, " presentationTimeOffset=\""LLD"\"", presentationTimeOffset);
 			}
-			if (dash_cfg->ast_offset_ms<0) {
-				fprintf(dash_cfg->mpd, " availabilityTimeOffset=\"%g\"", - (Double) dash_cfg->ast_offset_ms / 1000.0);
-			}
+			dasher_write_availability_time_offset(dash_cfg);
 
 			if (mpd_timeline_bs) {
 				char *mpd_seg_info = NULL;
@@ -2183,9 +2263,7 @@ restart_fragmentation_pass:
 		u32 size;
 
 		fprintf(dash_cfg->mpd, "   <SegmentList timescale=\"%d\"", dash_cfg->dash_scale);
-		if (dash_cfg->ast_offset_ms<0) {
-			fprintf(dash_cfg->mpd, " availabilityTimeOffset=\"%g\"", - (Double) dash_cfg->ast_offset_ms / 1000.0);
-		}
+		dasher_write_availability_time_offset(dash_cfg);
 		fprintf(dash_cfg->mpd, "\n");
 
 		gf_bs_get_content(mpd_timeline_bs, &mpd_seg_info, &size);
@@ -2285,9 +2363,7 @@ restart_fragmentation_pass:
 			if (presentationTimeOffset)
 				fprintf(dash_cfg->mpd, " presentationTimeOffset=\""LLD"\"", presentationTimeOffset);
 
-			if (dash_cfg->ast_offset_ms<0) {
-				fprintf(dash_cfg->mpd, " availabilityTimeOffset=\"%g\"", - (Double) dash_cfg->ast_offset_ms / 1000.0);
-			}
+			dasher_write_availability_time_offset(dash_cfg);
 
 			if (mpd_timeline_bs && (!first_in_set || dash_cfg->segment_alignment_disabled) ) {
 				char *mpd_seg_info = NULL;
@@ -2334,9 +2410,7 @@ restart_fragmentation_pass:
 		if (presentationTimeOffset) {
 			fprintf(dash_cfg->mpd, " presentationTimeOffset=\""LLD"\"", presentationTimeOffset);
 		}
-		if (dash_cfg->ast_offset_ms<0) {
-			fprintf(dash_cfg->mpd, " availabilityTimeOffset=\"%g\"", - (Double) dash_cfg->ast_offset_ms / 1000.0);
-		}
+		dasher_write_availability_time_offset(dash_cfg);
 		fprintf(dash_cfg->mpd, ">\n");
 		/*we are not in bitstreamSwitching mode*/
 		if (!is_bs_switching) {
@@ -2424,6 +2498,7 @@ err_exit:
 	if (langCode) {
 		gf_free(langCode);
 	}
+	if (recycled_sample) gf_isom_sample_del(&recycled_sample);
 	if (fragmenters) {
 		while (gf_list_count(fragmenters)) {
 			tf = (GF_ISOMTrackFragmenter *)gf_list_get(fragmenters, 0);
@@ -2438,7 +2513,7 @@ err_exit:
 	}
 	if (!bs_switching_is_output && bs_switch_segment)
 		gf_isom_delete(bs_switch_segment);
-	gf_set_progress("ISO File Fragmenting", nb_samp, nb_samp);
+	if (!dash_cfg->no_progress) gf_set_progress("ISO File Fragmenting", nb_samp, nb_samp);
 	if (mpd_bs) gf_bs_del(mpd_bs);
 	if (mpd_timeline_bs) gf_bs_del(mpd_timeline_bs);
 	return e;
@@ -3013,14 +3088,14 @@ static u32 isom_get_track_duration_from_samples_in_timescale(GF_ISOFile *in, u32
 	return (u32)track_duration;
 }
 
-static GF_Err dasher_isom_force_duration(GF_ISOFile *in, const Double duration_in_sec, const Double fragment_duration_in_sec) {
+static GF_Err dasher_isom_force_duration(GF_ISOFile *in, const Double duration_in_sec, const Double fragment_duration_in_sec, Bool no_progress) {
 	GF_Err e = GF_OK;
 
 	u32 trackNumber, trackCount=gf_isom_get_track_count(in);
 	for (trackNumber=1; trackNumber<=trackCount; ++trackNumber) {
 		const u32 target_duration_in_timescale = (u32)(duration_in_sec * gf_isom_get_timescale(in));
 		const u32 track_duration = isom_get_track_duration_from_samples_in_timescale(in, trackNumber);
-		gf_set_progress("ISO File Force Duration", trackNumber-1, trackCount);
+		if (!no_progress) gf_set_progress("ISO File Force Duration", trackNumber-1, trackCount);
 
 		if (target_duration_in_timescale < track_duration) {
 			u32 i, j, track_duration2, sample_count = gf_isom_get_sample_count(in, trackNumber);
@@ -3029,7 +3104,7 @@ static GF_Err dasher_isom_force_duration(GF_ISOFile *in, const Double duration_i
 			for (i=1; i <= sample_count; ++i) {
 				u32 di;
 				GF_ISOSample *s = gf_isom_get_sample(in, trackNumber, i, &di);
-				gf_set_progress("ISO File Force Duration", (trackNumber-1)*sample_count+i, trackCount*sample_count);
+				if (!no_progress) gf_set_progress("ISO File Force Duration", (trackNumber-1)*sample_count+i, trackCount*sample_count);
 				if (s->DTS >= duration_in_sec * gf_isom_get_media_timescale(in, trackNumber)) {
 					track_duration2 = (u32)(s->DTS * gf_isom_get_timescale(in) / gf_isom_get_media_timescale(in, trackNumber));
 					break;
@@ -3038,7 +3113,7 @@ static GF_Err dasher_isom_force_duration(GF_ISOFile *in, const Double duration_i
 			for (j=i; j <= sample_count; ++j) {
 				u32 di;
 				GF_ISOSample *s = gf_isom_get_sample(in, trackNumber, i, &di);
-				gf_set_progress("ISO File Force Duration", (trackNumber-1)*sample_count+j, trackCount*sample_count);
+				if (!no_progress) gf_set_progress("ISO File Force Duration", (trackNumber-1)*sample_count+j, trackCount*sample_count);
 				e = gf_isom_remove_sample(in, trackNumber, i);
 				gf_isom_sample_del(&s);
 				assert(e == GF_OK);
@@ -3053,7 +3128,7 @@ static GF_Err dasher_isom_force_duration(GF_ISOFile *in, const Double duration_i
 			for (i=1; i<=edit_count; ++i) {
 				u64 EditTime, SegmentDuration, MediaTime;
 				u8 EditMode;
-				gf_set_progress("ISO File Force Duration", (trackNumber-1)*edit_count+i, trackCount*edit_count);
+				if (!no_progress) gf_set_progress("ISO File Force Duration", (trackNumber-1)*edit_count+i, trackCount*edit_count);
 				e = gf_isom_get_edit_segment(in, trackNumber, i, &EditTime, &SegmentDuration, &MediaTime, &EditMode);
 				if (e) {
 					e = GF_OK;
@@ -3082,7 +3157,7 @@ static GF_Err dasher_isom_force_duration(GF_ISOFile *in, const Double duration_i
 			break;
 	}
 
-	gf_set_progress("ISO File Force Duration", 1, 1);
+	if (!no_progress) gf_set_progress("ISO File Force Duration", 1, 1);
 	gf_isom_update_duration(in);
 
 	return e;
@@ -3093,7 +3168,8 @@ static GF_Err dasher_isom_segment_file(GF_DashSegInput *dash_input, const char *
 	GF_Err e = GF_OK;
 
 	if (!dash_input->isobmf_input) {
-		GF_ISOFile *in = gf_isom_open(dash_input->file_name, dash_input->media_duration ? GF_ISOM_OPEN_EDIT : GF_ISOM_OPEN_READ, dash_cfg->tmpdir);
+		/*input is only read: map it in memory to avoid copying sample payloads*/
+		GF_ISOFile *in = gf_isom_open(dash_input->file_name, dash_input->media_duration ? GF_ISOM_OPEN_EDIT : (GF_ISOM_OPEN_READ | GF_ISOM_OPEN_FILE_MAPPING), dash_cfg->tmpdir);
 
 		GF_LOG(GF_LOG_DEBUG, GF_LOG_DASH, ("[DASH] ISOBMFF opened\n"));
 
@@ -3104,7 +3180,7 @@ static GF_Err dasher_isom_segment_file(GF_DashSegInput *dash_input, const char *
 
 		if (dash_input->media_duration) {
 			GF_LOG(GF_LOG_INFO, GF_LOG_DASH, ("[DASH] Forcing media duration to %lfs.\n", dash_input->media_duration));
-			e = dasher_isom_force_duration(in, dash_input->media_duration, dash_cfg->fragment_duration);
+			e = dasher_isom_force_duration(in, dash_input->media_duration, dash_cfg->fragment_duration, dash_cfg->no_progress);
 			if (e) {
 				gf_isom_delete(in);
 				GF_LOG(GF_LOG_INFO, GF_LOG_DASH, ("[DASH] Media duration couldn't be forced. Aborting.\n"));
@@ -5567,6 +5643,16 @@ GF_Err gf_dasher_enable_real_time(GF_DASHSegmenter *dasher, Bool real_time)
 	return GF_OK;
 }
 
+GF_EXPORT
+GF_Err gf_dasher_enable_chunked_mode(GF_DASHSegmenter *dasher, Double chunk_duration, gf_dasher_chunk_callback on_chunk, void *udta)
+{
+	if (!dasher || (chunk_duration<0)) return GF_BAD_PARAM;
+	dasher->chunk_duration = chunk_duration;
+	dasher->on_chunk = on_chunk;
+	dasher->on_chunk_udta = udta;
+	return GF_OK;
+}
+
 GF_EXPORT
 
 GF_Err gf_dasher_set_content_protection_location_mode(GF_DASHSegmenter *dasher, GF_DASH_ContentLocationMode mode)
@@ -5584,6 +5670,14 @@ GF_Err gf_dasher_set_profile_extension(GF_DASHSegmenter *dasher, const char *das
 	return GF_OK;
 }
 
+GF_EXPORT
+GF_Err gf_dasher_set_thread_count(GF_DASHSegmenter *dasher, u32 nb_threads)
+{
+	if (!dasher) return GF_BAD_PARAM;
+	dasher->nb_threads = nb_threads;
+	return GF_OK;
+}
+
 
 GF_EXPORT
 GF_Err gf_dasher_add_input(GF_DASHSegmenter *dasher, GF_DashSegmenterInput *input)
@@ -5646,6 +5740,152 @@ GF_Err gf_dasher_add_input(GF_DASHSegmenter *dasher, GF_DashSegmenterInput *inpu
 	return GF_OK;
 }
 
+/*one representation of an adaptation set segmented by a worker thread. The job works on its own copy of the segmenter
+configuration, with the MPD redirected to a temporary file so that representations can be merged in input order*/
+typedef struct
+{
+	GF_DashSegInput *dash_input;
+	GF_DASHSegmenter cfg;
+	char szOutName[GF_MAX_PATH];
+	char szSegName[GF_MAX_PATH];
+	Bool first_in_set;
+	char *mpd_temp_name;
+	GF_Err e;
+} GF_DashSegJob;
+
+typedef struct
+{
+	GF_DashSegJob *jobs;
+	u32 nb_jobs, next_job;
+	Bool aborted;
+	GF_Mutex *mx;
+} GF_DashSegJobQueue;
+
+static u32 dasher_segment_worker(void *par)
+{
+	GF_DashSegJobQueue *queue = (GF_DashSegJobQueue *)par;
+	while (1) {
+		GF_DashSegJob *job = NULL;
+		gf_mx_p(queue->mx);
+		if (!queue->aborted && (queue->next_job < queue->nb_jobs)) {
+			job = &queue->jobs[queue->next_job];
+			queue->next_job++;
+		}
+		gf_mx_v(queue->mx);
+		if (!job) break;
+
+		GF_LOG(GF_LOG_INFO, GF_LOG_DASH, ("DASHing file %s\n", job->dash_input->file_name));
+		job->e = job->dash_input->dasher_segment_file(job->dash_input, job->szOutName, &job->cfg, job->first_in_set);
+		if (job->e) {
+			gf_mx_p(queue->mx);
+			queue->aborted = GF_TRUE;
+			gf_mx_v(queue->mx);
+		}
+	}
+	return 0;
+}
+
+static Bool dasher_input_supports_jobs(GF_DashSegInput *dash_input)
+{
+#ifndef GPAC_DISABLE_ISOM_FRAGMENTS
+	/*only ISOBMFF inputs are segmented in parallel*/
+	if (dash_input->dasher_segment_file == dasher_isom_segment_file) return GF_TRUE;
+#endif
+	return GF_FALSE;
+}
+
+static void dasher_reset_jobs(GF_DashSegJobQueue *queue)
+{
+	u32 i;
+	for (i=0; i<queue->nb_jobs; i++) {
+		if (queue->jobs[i].cfg.mpd) gf_fclose(queue->jobs[i].cfg.mpd);
+		queue->jobs[i].cfg.mpd = NULL;
+		if (queue->jobs[i].mpd_temp_name) {
+			gf_delete_file(queue->jobs[i].mpd_temp_name);
+			gf_free(queue->jobs[i].mpd_temp_name);
+			queue->jobs[i].mpd_temp_name = NULL;
+		}
+	}
+	queue->nb_jobs = queue->next_job = 0;
+	queue->aborted = GF_FALSE;
+}
+
+/*runs all queued representations on at most nb_threads threads, then appends their MPD content to the period in queue order*/
+static GF_Err dasher_run_jobs(GF_DASHSegmenter *dasher, GF_DashSegJobQueue *queue, FILE *period_mpd)
+{
+	u32 i, nb_threads;
+	GF_Thread **threads;
+	GF_Err e = GF_OK;
+
+	/*the calling thread is one of the workers*/
+	nb_threads = MIN(dasher->nb_threads, queue->nb_jobs) - 1;
+	/*representations writing to the same files (same source, no $RepresentationID$ in the segment name) cannot run concurrently*/
+	for (i=0; i<queue->nb_jobs && nb_threads; i++) {
+		u32 j;
+		for (j=i+1; j<queue->nb_jobs; j++) {
+			if (strcmp(queue->jobs[i].szOutName, queue->jobs[j].szOutName)) continue;
+			if (queue->jobs[i].cfg.seg_rad_name && strstr(queue->jobs[i].cfg.seg_rad_name, "$RepresentationID$")
+			        && strcmp(queue->jobs[i].dash_input->representationID, queue->jobs[j].dash_input->representationID))
+				continue;
+			GF_LOG(GF_LOG_INFO, GF_LOG_DASH, ("[DASH] Representations %s and %s use the same output files, segmenting sequentially\n", queue->jobs[i].dash_input->representationID, queue->jobs[j].dash_input->representationID));
+			nb_threads = 0;
+			break;
+		}
+	}
+	threads = nb_threads ? (GF_Thread **)gf_malloc(sizeof(GF_Thread *) * nb_threads) : NULL;
+	if (nb_threads && !threads) return GF_OUT_OF_MEM;
+	/*the progress callback is global to the process, do not call it concurrently*/
+	for (i=0; i<queue->nb_jobs && nb_threads; i++) {
+		queue->jobs[i].cfg.no_progress = GF_TRUE;
+	}
+	for (i=0; i<nb_threads; i++) {
+		threads[i] = gf_th_new("DASHSegmenter");
+		if (threads[i] && (gf_th_run(threads[i], dasher_segment_worker, queue) != GF_OK)) {
+			gf_th_del(threads[i]);
+			threads[i] = NULL;
+		}
+	}
+	dasher_segment_worker(queue);
+	for (i=0; i<nb_threads; i++) {
+		if (!threads[i]) continue;
+		gf_th_stop(threads[i]);
+		gf_th_del(threads[i]);
+	}
+	if (threads) gf_free(threads);
+
+	for (i=0; i<queue->nb_jobs; i++) {
+		GF_DashSegJob *job = &queue->jobs[i];
+		u32 size;
+		if (job->e) {
+			e = job->e;
+			break;
+		}
+		/*not processed because of an error in another job*/
+		if (i >= queue->next_job) {
+			e = GF_IO_ERR;
+			break;
+		}
+		if (job->cfg.max_segment_duration > dasher->max_segment_duration)
+			dasher->max_segment_duration = job->cfg.max_segment_duration;
+
+		size = (u32) gf_ftell(job->cfg.mpd);
+		gf_fseek(job->cfg.mpd, 0, SEEK_SET);
+		while (size) {
+			char buf[4096];
+			u32 read = (u32) fread(buf, 1, MIN(size, 4096), job->cfg.mpd);
+			if (!read) {
+				e = GF_IO_ERR;
+				break;
+			}
+			gf_fwrite(buf, 1, read, period_mpd);
+			size -= read;
+		}
+		if (e) break;
+	}
+	dasher_reset_jobs(queue);
+	return e;
+}
+
 
 GF_EXPORT
 GF_Err gf_dasher_process(GF_DASHSegmenter *dasher, Double sub_duration)
@@ -5674,8 +5914,11 @@ GF_Err gf_dasher_process(GF_DASHSegmenter *dasher, Double sub_duration)
 	u32 last_period_rep_idx_plus_one = 0;
 	FILE *mpd = NULL;
 	PeriodEntry *p;
+	GF_DashSegJobQueue job_queue;
 	if (!dasher) return GF_BAD_PARAM;
 
+	memset(&job_queue, 0, sizeof(GF_DashSegJobQueue));
+
 	GF_LOG(GF_LOG_DEBUG, GF_LOG_DASH, ("[DASH] Dashing starting\n"));
 
 	dasher->force_period_end = GF_FALSE;
@@ -5693,6 +5936,10 @@ GF_Err gf_dasher_process(GF_DASHSegmenter *dasher, Double sub_duration)
 		GF_LOG(GF_LOG_ERROR, GF_LOG_DASH, ("[DASH] real-time simulation is only supported with a single representation.\n"));
 		return GF_BAD_PARAM;
 	}
+	/*chunks are written as soon as completed, which cannot be done when the segment is indexed*/
+	if (dasher->chunk_duration && dasher->enable_sidx) {
+		GF_LOG(GF_LOG_WARNING, GF_LOG_DASH, ("[DASH] SIDX cannot be used in chunked mode, disabling it.\n"));
+	}
 
 
 	/*update dash context*/
@@ -5965,6 +6212,12 @@ GF_Err gf_dasher_process(GF_DASHSegmenter *dasher, Double sub_duration)
 
 	dasher->single_file_mode = (dasher->single_segment) ? 1 : (dasher->single_file ? 2 : 0);
 
+	if (dasher->chunk_duration && dasher->single_file_mode) {
+		GF_LOG(GF_LOG_ERROR, GF_LOG_DASH, ("[DASH] Chunked mode requires one file per segment, cannot be used in onDemand profile, single segment or single file modes.\n"));
+		e = GF_BAD_PARAM;
+		goto exit;
+	}
+
 	dasher->subduration = sub_duration * 1000 / dasher->dash_scale;
 
 	max_comp_per_input = 0;
@@ -6160,9 +6413,19 @@ GF_Err gf_dasher_process(GF_DASHSegmenter *dasher, Double sub_duration)
 		return GF_IO_ERR;
 	}
 
-
 	period_links = gf_list_new();
 
+	/*representations of a set may be segmented in parallel when they do not share a DASH context*/
+	if ((dasher->nb_threads > 1) && !dasher->dash_ctx && !dasher->real_time) {
+		job_queue.jobs = (GF_DashSegJob *)gf_malloc(sizeof(GF_DashSegJob) * dasher->nb_inputs);
+		job_queue.mx = gf_mx_new("DASHSegmenterJobs");
+		if (!job_queue.jobs || !job_queue.mx) {
+			e = GF_OUT_OF_MEM;
+			goto exit;
+		}
+		memset(job_queue.jobs, 0, sizeof(GF_DashSegJob) * dasher->nb_inputs);
+	}
+
 	if (dasher->dash_ctx) {
 		u32 count = gf_cfg_get_key_count(dasher->dash_ctx, "PastPeriods");
 		for (i=0; i<count; i++) {
@@ -6268,6 +6531,7 @@ GF_Err gf_dasher_process(GF_DASHSegmenter *dasher, Double sub_duration)
 			u32 fps_denum = 0;
 			Double seg_duration_in_as = 0;
 			Bool has_scalability = GF_FALSE;
+			Bool use_jobs;
 			Bool use_bs_switching = (dasher->bitstream_switching_mode==GF_DASH_BSMODE_NONE) ? GF_FALSE : GF_TRUE;
 			char *lang;
 			char szFPS[100];
@@ -6409,11 +6673,26 @@ GF_Err gf_dasher_process(GF_DASHSegmenter *dasher, Double sub_duration)
 
 			if (e) goto exit;
 
+			use_jobs = GF_FALSE;
+			if (job_queue.jobs && !has_scalability) {
+				u32 nb_reps = 0;
+				use_jobs = GF_TRUE;
+				for (i=0; i<dasher->nb_inputs; i++) {
+					if (dasher->inputs[i].adaptation_set!=cur_adaptation_set+1)
+						continue;
+					nb_reps++;
+					if (!dasher_input_supports_jobs(&dasher->inputs[i]))
+						use_jobs = GF_FALSE;
+				}
+				if (nb_reps<2) use_jobs = GF_FALSE;
+			}
+
 			is_first_rep = GF_TRUE;
 			for (i=0; i<dasher->nb_inputs && !e; i++) {
 				char szOutName[GF_MAX_PATH], *segment_name, *orig_seg_name;
 				GF_DashSegInput *dash_input = &dasher->inputs[i];
-				Double segdur, fragdur;
+				Double segdur, fragdur, chunkdur;
+				Bool enable_sidx, frags_in_mem;
 				if (dash_input->adaptation_set!=cur_adaptation_set+1)
 					continue;
 
@@ -6488,6 +6767,9 @@ GF_Err gf_dasher_process(GF_DASHSegmenter *dasher, Double sub_duration)
 
 				segdur = dasher->segment_duration;
 				fragdur = dasher->fragment_duration;
+				chunkdur = dasher->chunk_duration;
+				enable_sidx = dasher->enable_sidx;
+				frags_in_mem = dasher->fragments_in_memory;
 
 				if (dash_input->segment_duration)
 					dasher->segment_duration = dash_input->segment_duration;
@@ -6496,13 +6778,40 @@ GF_Err gf_dasher_process(GF_DASHSegmenter *dasher, Double sub_duration)
 					dasher->fragment_duration = dasher->segment_duration;
 				}
 
+				/*in chunked mode, each chunk is a fragment flushed as soon as completed and segments are not indexed*/
+				if (dasher->chunk_duration) {
+					if (dasher->chunk_duration > dasher->segment_duration) dasher->chunk_duration = dasher->segment_duration;
+					dasher->fragment_duration = dasher->chunk_duration;
+					dasher->fragments_in_memory = GF_TRUE;
+					dasher->enable_sidx = GF_FALSE;
+				}
+
 
-				GF_LOG(GF_LOG_INFO, GF_LOG_DASH, ("DASHing file %s\n", dash_input->file_name));
-				e = dash_input->dasher_segment_file(dash_input, szOutName, dasher, is_first_rep);
+				if (use_jobs) {
+					GF_DashSegJob *job = &job_queue.jobs[job_queue.nb_jobs];
+					job_queue.nb_jobs++;
+					job->dash_input = dash_input;
+					job->first_in_set = is_first_rep;
+					job->e = GF_OK;
+					job->cfg = *dasher;
+					strcpy(job->szOutName, szOutName);
+					if (dasher->seg_rad_name) {
+						strcpy(job->szSegName, dasher->seg_rad_name);
+						job->cfg.seg_rad_name = job->szSegName;
+					}
+					job->cfg.mpd = gf_temp_file_new(&job->mpd_temp_name);
+					if (!job->cfg.mpd) e = GF_IO_ERR;
+				} else {
+					GF_LOG(GF_LOG_INFO, GF_LOG_DASH, ("DASHing file %s\n", dash_input->file_name));
+					e = dash_input->dasher_segment_file(dash_input, szOutName, dasher, is_first_rep);
+				}
 
 				dasher->seg_rad_name = orig_seg_name;
 				dasher->segment_duration = segdur;
 				dasher->fragment_duration = fragdur;
+				dasher->chunk_duration = chunkdur;
+				dasher->enable_sidx = enable_sidx;
+				dasher->fragments_in_memory = frags_in_mem;
 
 				if (e) {
 					GF_LOG(GF_LOG_ERROR, GF_LOG_DASH, ("Error while DASH-ing file: %s\n", gf_error_to_string(e)));
@@ -6510,6 +6819,13 @@ GF_Err gf_dasher_process(GF_DASHSegmenter *dasher, Double sub_duration)
 				}
 				is_first_rep = GF_FALSE;
 			}
+			if (use_jobs) {
+				e = dasher_run_jobs(dasher, &job_queue, period_mpd);
+				if (e) {
+					GF_LOG(GF_LOG_ERROR, GF_LOG_DASH, ("Error while DASH-ing file: %s\n", gf_error_to_string(e)));
+					goto exit;
+				}
+			}
 			/*close adaptation set*/
 			fprintf(period_mpd, "  </AdaptationSet>\n");
 		}
@@ -6610,6 +6926,12 @@ GF_Err gf_dasher_process(GF_DASHSegmenter *dasher, Double sub_duration)
 	GF_LOG(GF_LOG_DEBUG, GF_LOG_DASH, ("[DASH] Done dashing\n"));
 
 exit:
+	if (job_queue.jobs) {
+		dasher_reset_jobs(&job_queue);
+		gf_free(job_queue.jobs);
+	}
+	if (job_queue.mx) gf_mx_del(job_queue.mx);
+
 	if (mpd) {
 		gf_fclose(mpd);
 		if (!e && dasher->dash_mode) {
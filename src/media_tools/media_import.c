@@ -40,6 +40,7 @@
 #include <gpac/constants.h>
 #include <gpac/base_coding.h>
 #include <gpac/internal/isomedia_dev.h>
+#include <gpac/thread.h>
 
 
 #ifndef GPAC_DISABLE_MEDIA_IMPORT
@@ -4589,6 +4590,167 @@ GF_Err gf_media_avc_rewrite_samples(GF_ISOFile *file, u32 track, u32 prev_size,
 
 #ifndef GPAC_DISABLE_AV_PARSERS
 
+/*Annex-B start code scanner: a background thread reads the file in large blocks and locates the NAL units, so that
+the importer only parses NAL headers and packs samples instead of scanning each NAL byte per byte twice*/
+#define NALU_SCAN_BLOCK_SIZE	0x100000
+#define NALU_SCAN_QUEUE_SIZE	1024
+
+typedef struct
+{
+	/*offset of the first byte after the start code, (u64)-1 signals the end of the scan*/
+	u64 start;
+	/*size up to the next start code, and size without trailing zero bytes*/
+	u32 size, payload_size;
+} NALUScanEntry;
+
+typedef struct
+{
+	FILE *in;
+	u64 start;
+	GF_Thread *th;
+	GF_Semaphore *free_slots, *used_slots;
+	NALUScanEntry entries[NALU_SCAN_QUEUE_SIZE];
+	u32 read_idx, write_idx;
+	volatile Bool stop;
+	Bool done;
+} NALUScanner;
+
+static Bool nalu_scanner_push(NALUScanner *sc, u64 start, u32 size, u32 payload_size)
+{
+	NALUScanEntry *ent;
+	gf_sema_wait(sc->free_slots);
+	if (sc->stop) return GF_FALSE;
+	ent = &sc->entries[sc->write_idx];
+	ent->start = start;
+	ent->size = size;
+	ent->payload_size = payload_size;
+	sc->write_idx = (sc->write_idx + 1) % NALU_SCAN_QUEUE_SIZE;
+	gf_sema_notify(sc->used_slots, 1);
+	return GF_TRUE;
+}
+
+static u32 nalu_scanner_run(void *par)
+{
+	u8 *block;
+	u32 nb_zeros;
+	u64 block_start, nal_start, payload_end;
+	Bool has_payload_end;
+	NALUScanner *sc = (NALUScanner *)par;
+
+	block = (u8*)gf_malloc(sizeof(u8) * NALU_SCAN_BLOCK_SIZE);
+	if (!block) {
+		nalu_scanner_push(sc, (u64) -1, 0, 0);
+		return 1;
+	}
+	gf_fseek(sc->in, sc->start, SEEK_SET);
+	block_start = nal_start = sc->start;
+	payload_end = 0;
+	has_payload_end = GF_FALSE;
+	nb_zeros = 0;
+	while (!sc->stop) {
+		u32 pos = 0;
+		u32 read = (u32) fread(block, 1, NALU_SCAN_BLOCK_SIZE, sc->in);
+		if (!read) break;
+
+		while (pos < read) {
+			u8 c;
+			/*outside a run of zero bytes, jump straight to the next zero byte*/
+			if (!nb_zeros) {
+				u8 *next = (u8*)memchr(block + pos, 0, read - pos);
+				if (!next) break;
+				pos = (u32) (next - block);
+			}
+			c = block[pos];
+			pos++;
+			if (!c) {
+				nb_zeros++;
+				/*same rule as gf_media_nalu_payload_end_bs: payload stops at the first 0x000000*/
+				if ((nb_zeros==3) && !has_payload_end) {
+					payload_end = block_start + pos - 3;
+					has_payload_end = GF_TRUE;
+				}
+				continue;
+			}
+			if ((c==1) && (nb_zeros>=2)) {
+				u64 sc_start = block_start + pos - ((nb_zeros>=3) ? 4 : 3);
+				if (!has_payload_end) payload_end = sc_start;
+				if (!nalu_scanner_push(sc, nal_start, (u32) (sc_start - nal_start), (u32) (payload_end - nal_start)))
+					break;
+				nal_start = block_start + pos;
+				has_payload_end = GF_FALSE;
+			}
+			nb_zeros = 0;
+		}
+		block_start += read;
+	}
+	/*last NAL ends with the file*/
+	if (!sc->stop) {
+		if (!has_payload_end) payload_end = block_start;
+		if (nalu_scanner_push(sc, nal_start, (u32) (block_start - nal_start), (u32) (payload_end - nal_start)))
+			nalu_scanner_push(sc, (u64) -1, 0, 0);
+	}
+	gf_free(block);
+	return 0;
+}
+
+static void nalu_scanner_del(NALUScanner *sc)
+{
+	if (!sc) return;
+	if (sc->th) {
+		sc->stop = GF_TRUE;
+		/*wake up the scanner if waiting for a free slot*/
+		gf_sema_notify(sc->free_slots, 1);
+		gf_th_del(sc->th);
+	}
+	if (sc->free_slots) gf_sema_del(sc->free_slots);
+	if (sc->used_slots) gf_sema_del(sc->used_slots);
+	if (sc->in) gf_fclose(sc->in);
+	gf_free(sc);
+}
+
+static NALUScanner *nalu_scanner_new(const char *file_name, u64 start)
+{
+	NALUScanner *sc;
+	GF_SAFEALLOC(sc, NALUScanner);
+	if (!sc) return NULL;
+	sc->start = start;
+	sc->in = gf_fopen(file_name, "rb");
+	sc->free_slots = gf_sema_new(NALU_SCAN_QUEUE_SIZE + 1, NALU_SCAN_QUEUE_SIZE);
+	sc->used_slots = gf_sema_new(NALU_SCAN_QUEUE_SIZE, 0);
+	if (sc->in && sc->free_slots && sc->used_slots) {
+		sc->th = gf_th_new("NALUScanner");
+		if (sc->th && (gf_th_run(sc->th, nalu_scanner_run, sc) == GF_OK))
+			return sc;
+	}
+	GF_LOG(GF_LOG_WARNING, GF_LOG_CODING, ("[NALU Import] Cannot start background start code scanner, scanning in import thread\n"));
+	nalu_scanner_del(sc);
+	return NULL;
+}
+
+/*gets size of the NAL starting at nal_start - returns GF_FALSE if the scanner is done or out of sync, in which
+case the caller locates the next start code itself*/
+static Bool nalu_scanner_next(NALUScanner *sc, u64 nal_start, u32 *size, u32 *payload_size)
+{
+	NALUScanEntry ent;
+	if (!sc || sc->done) return GF_FALSE;
+
+	gf_sema_wait(sc->used_slots);
+	ent = sc->entries[sc->read_idx];
+	sc->read_idx = (sc->read_idx + 1) % NALU_SCAN_QUEUE_SIZE;
+	gf_sema_notify(sc->free_slots, 1);
+
+	if (ent.start != nal_start) {
+		if (ent.start != (u64) -1) {
+			GF_LOG(GF_LOG_WARNING, GF_LOG_CODING, ("[NALU Import] Start code scanner out of sync ("LLU" vs "LLU"), scanning in import thread\n", ent.start, nal_start));
+		}
+		sc->done = GF_TRUE;
+		return GF_FALSE;
+	}
+	*size = ent.size;
+	*payload_size = ent.payload_size;
+	return GF_TRUE;
+}
+
 static GF_Err gf_import_avc_h264(GF_MediaImporter *import)
 {
 	u64 nal_start, nal_end, total_size;
@@ -4614,6 +4776,7 @@ static GF_Err gf_import_avc_h264(GF_MediaImporter *import)
 	Double FPS;
 	char *buffer;
 	u32 max_size = 4096;
+	NALUScanner *scanner = NULL;
 
 	if (import->flags & GF_IMPORT_PROBE_ONLY) {
 		import->nb_tracks = 1;
@@ -4662,6 +4825,7 @@ restart_import:
 		e = gf_import_message(import, GF_NON_COMPLIANT_BITSTREAM, "Cannot find H264 start code");
 		goto exit;
 	}
+	scanner = nalu_scanner_new(import->in_name, gf_bs_get_position(bs));
 
 	/*NALU size packing disabled*/
 	if (!(import->flags & GF_IMPORT_FORCE_PACKED)) size_length = 32;
@@ -4718,10 +4882,16 @@ restart_import:
 	while (gf_bs_available(bs)) {
 		u8 nal_hdr, skip_nal, is_subseq, add_sps;
 		u32 nal_and_trailing_size;
+		Bool nal_scanned;
 
-		nal_and_trailing_size = nal_size = gf_media_nalu_next_start_code_bs(bs);
-		if (!(import->flags & GF_IMPORT_KEEP_TRAILING)) {
-			nal_size = gf_media_nalu_payload_end_bs(bs);
+		nal_scanned = nalu_scanner_next(scanner, nal_start, &nal_and_trailing_size, &nal_size);
+		if (!nal_scanned) {
+			nal_and_trailing_size = nal_size = gf_media_nalu_next_start_code_bs(bs);
+			if (!(import->flags & GF_IMPORT_KEEP_TRAILING)) {
+				nal_size = gf_media_nalu_payload_end_bs(bs);
+			}
+		} else if (import->flags & GF_IMPORT_KEEP_TRAILING) {
+			nal_size = nal_and_trailing_size;
 		}
 
 		if (nal_size>max_size) {
@@ -4874,6 +5044,8 @@ restart_import:
 					buffer = NULL;
 					gf_bs_del(bs);
 					bs = NULL;
+					nalu_scanner_del(scanner);
+					scanner = NULL;
 					gf_fseek(mdia, 0, SEEK_SET);
 					goto restart_import;
 				}
@@ -5350,8 +5522,8 @@ restart_import:
 		if (duration && (dts_inc*cur_samp > duration)) break;
 		if (import->flags & GF_IMPORT_DO_ABORT) break;
 
-		/*consume next start code*/
-		nal_start = gf_media_nalu_next_start_code_bs(bs);
+		/*consume next start code - when the NAL was located by the scanner, we are already on it*/
+		nal_start = nal_scanned ? 0 : gf_media_nalu_next_start_code_bs(bs);
 		if (nal_start) {
 			GF_LOG(GF_LOG_ERROR, GF_LOG_CODING, ("[avc-h264] invalid nal_size (%u)? Skipping "LLU" bytes to reach next start code\n", nal_size, nal_start));
 			gf_bs_skip_bytes(bs, nal_start);
@@ -5546,6 +5718,7 @@ exit:
 	gf_odf_avc_cfg_del(avccfg);
 	gf_odf_avc_cfg_del(svccfg);
 	gf_free(buffer);
+	nalu_scanner_del(scanner);
 	gf_bs_del(bs);
 	gf_fclose(mdia);
 	return e;
@@ -5757,6 +5930,7 @@ static GF_Err gf_import_hevc(GF_MediaImporter *import)
 	Double FPS;
 	char *buffer;
 	u32 max_size = 4096;
+	NALUScanner *scanner = NULL;
 
 	if (import->flags & GF_IMPORT_PROBE_ONLY) {
 		import->nb_tracks = 1;
@@ -5808,6 +5982,7 @@ restart_import:
 		e = gf_import_message(import, GF_NON_COMPLIANT_BITSTREAM, "Cannot find HEVC start code");
 		goto exit;
 	}
+	scanner = nalu_scanner_new(import->in_name, gf_bs_get_position(bs));
 
 	/*NALU size packing disabled*/
 	if (!(import->flags & GF_IMPORT_FORCE_PACKED)) size_length = 32;
@@ -5865,13 +6040,18 @@ restart_import:
 		s32 res;
 		GF_HEVCConfig *prev_cfg;
 		u8 nal_unit_type, temporal_id, layer_id;
-		Bool skip_nal, add_sps, is_slice, has_vcl_nal;
+		Bool skip_nal, add_sps, is_slice, has_vcl_nal, nal_scanned;
 		u32 nal_and_trailing_size;
 
 		has_vcl_nal = GF_FALSE;
-		nal_and_trailing_size = nal_size = gf_media_nalu_next_start_code_bs(bs);
-		if (!(import->flags & GF_IMPORT_KEEP_TRAILING)) {
-			nal_size = gf_media_nalu_payload_end_bs(bs);
+		nal_scanned = nalu_scanner_next(scanner, nal_start, &nal_and_trailing_size, &nal_size);
+		if (!nal_scanned) {
+			nal_and_trailing_size = nal_size = gf_media_nalu_next_start_code_bs(bs);
+			if (!(import->flags & GF_IMPORT_KEEP_TRAILING)) {
+				nal_size = gf_media_nalu_payload_end_bs(bs);
+			}
+		} else if (import->flags & GF_IMPORT_KEEP_TRAILING) {
+			nal_size = nal_and_trailing_size;
 		}
 
 
@@ -6058,6 +6238,8 @@ restart_import:
 					buffer = NULL;
 					gf_bs_del(bs);
 					bs = NULL;
+					nalu_scanner_del(scanner);
+					scanner = NULL;
 					gf_fseek(mdia, 0, SEEK_SET);
 					goto restart_import;
 				}
@@ -6449,8 +6631,8 @@ next_nal:
 		if (duration && (dts_inc*cur_samp > duration)) break;
 		if (import->flags & GF_IMPORT_DO_ABORT) break;
 
-		/*consume next start code*/
-		nal_start = gf_media_nalu_next_start_code_bs(bs);
+		/*consume next start code - when the NAL was located by the scanner, we are already on it*/
+		nal_start = nal_scanned ? 0 : gf_media_nalu_next_start_code_bs(bs);
 		if (nal_start) {
 			GF_LOG(GF_LOG_ERROR, GF_LOG_CODING, ("[hevc] invalid nal_size (%u)? Skipping "LLU" bytes to reach next start code\n", nal_size, nal_start));
 			gf_bs_skip_bytes(bs, nal_start);
@@ -6723,6 +6905,7 @@ exit:
 	gf_odf_hevc_cfg_del(hevc_cfg);
 	gf_odf_hevc_cfg_del(shvc_cfg);
 	gf_free(buffer);
+	nalu_scanner_del(scanner);
 	gf_bs_del(bs);
 	gf_fclose(mdia);
 	return e;
@@ -2961,6 +2961,16 @@ void gf_m2ts_flush_pes(GF_M2TS_Demuxer *ts, GF_M2TS_PES *pes)
 	pes->rap = 0;
 }
 
+/*makes room for size more bytes in the PES reassembly buffer - the buffer grows geometrically since PES packets are
+rebuilt from 184 bytes chunks and the buffer is reused from one PES to the next*/
+static void gf_m2ts_pes_reserve(GF_M2TS_PES *pes, u32 size)
+{
+	if (pes->pck_data_len + size > pes->pck_alloc_len) {
+		pes->pck_alloc_len = MAX(pes->pck_data_len + size, 2*pes->pck_alloc_len);
+		pes->pck_data = (u8*)gf_realloc(pes->pck_data, pes->pck_alloc_len);
+	}
+}
+
 static void gf_m2ts_process_pes(GF_M2TS_Demuxer *ts, GF_M2TS_PES *pes, GF_M2TS_Header *hdr, unsigned char *data, u32 data_size, GF_M2TS_AdaptationField *paf)
 {
 	u8 expect_cc;
@@ -3015,10 +3025,7 @@ static void gf_m2ts_process_pes(GF_M2TS_Demuxer *ts, GF_M2TS_PES *pes, GF_M2TS_H
 	} else if (pes->pes_len && (pes->pck_data_len + data_size == pes->pes_len + 6)) {
 		/* 6 = startcode+stream_id+length*/
 		/*reassemble pes*/
-		if (pes->pck_data_len + data_size > pes->pck_alloc_len) {
-			pes->pck_alloc_len = pes->pck_data_len + data_size;
-			pes->pck_data = (u8*)gf_realloc(pes->pck_data, pes->pck_alloc_len);
-		}
+		gf_m2ts_pes_reserve(pes, data_size);
 		memcpy(pes->pck_data+pes->pck_data_len, data, data_size);
 		pes->pck_data_len += data_size;
 		/*force discard*/
@@ -3037,10 +3044,7 @@ static void gf_m2ts_process_pes(GF_M2TS_Demuxer *ts, GF_M2TS_PES *pes, GF_M2TS_H
 		return;
 	}
 	/*reassemble*/
-	if (pes->pck_data_len + data_size > pes->pck_alloc_len ) {
-		pes->pck_alloc_len = pes->pck_data_len + data_size;
-		pes->pck_data = (u8*)gf_realloc(pes->pck_data, pes->pck_alloc_len);
-	}
+	gf_m2ts_pes_reserve(pes, data_size);
 	memcpy(pes->pck_data + pes->pck_data_len, data, data_size);
 	pes->pck_data_len += data_size;
 
@@ -3437,11 +3441,66 @@ static GF_Err gf_m2ts_process_packet(GF_M2TS_Demuxer *ts, unsigned char *data)
 	return GF_OK;
 }
 
+/*gets the number of packets, starting at data, only carrying the continuation of the PES currently reassembled on their PID:
+same PID, in sync, no error, no scrambling, no adaptation field, no payload start and no CC gap. The last packet of a PES
+with known length is never part of a run so that flushing is left to gf_m2ts_process_pes*/
+static u32 gf_m2ts_get_pes_run(GF_M2TS_Demuxer *ts, unsigned char *data, u32 nb_pck, u32 pck_size, GF_M2TS_PES **out_pes)
+{
+	GF_M2TS_PES *pes;
+	u32 i, pid, cc, max_pck;
+	unsigned char *pck;
+
+	if (nb_pck<2) return 0;
+	if ((data[0] != 0x47) || (data[1] & 0xC0) || ((data[3] & 0xF0) != 0x10)) return 0;
+
+	pid = ((data[1]&0x1f) << 8) | data[2];
+	pes = (GF_M2TS_PES *) ts->ess[pid];
+	if (!pes || !(pes->flags & GF_M2TS_ES_IS_PES) || !pes->reframe || !pes->pck_data_len || (pes->cc<0))
+		return 0;
+	cc = data[3] & 0xF;
+	if (cc != ((pes->cc + 1) & 0xF)) return 0;
+
+	max_pck = nb_pck;
+	if (pes->pes_len) {
+		u32 remain = pes->pes_len + 6 - pes->pck_data_len;
+		if (pes->pck_data_len >= pes->pes_len + 6) return 0;
+		max_pck = (remain - 1) / 184;
+		if (max_pck > nb_pck) max_pck = nb_pck;
+		if (max_pck<2) return 0;
+	}
+
+	pck = data;
+	for (i=1; i<max_pck; i++) {
+		pck += pck_size;
+		cc = (cc+1) & 0xF;
+		if ((pck[0] != 0x47) || (pck[1] != data[1]) || (pck[2] != data[2]) || (pck[3] != (0x10 | cc)))
+			break;
+	}
+	*out_pes = pes;
+	return i;
+}
+
+/*appends the payload of a run of continuation packets to the PES reassembly buffer in one go*/
+static void gf_m2ts_process_pes_run(GF_M2TS_Demuxer *ts, GF_M2TS_PES *pes, unsigned char *data, u32 nb_pck, u32 pck_size)
+{
+	u32 i;
+	pes->cc = data[(nb_pck-1)*pck_size + 3] & 0xF;
+	gf_m2ts_pes_reserve(pes, nb_pck*184);
+	for (i=0; i<nb_pck; i++) {
+		memcpy(pes->pck_data + pes->pck_data_len, data + 4, 184);
+		pes->pck_data_len += 184;
+		data += pck_size;
+	}
+	ts->pck_number += nb_pck;
+	GF_LOG(GF_LOG_DEBUG, GF_LOG_CONTAINER, ("[MPEG-2 TS] TS Packets %d to %d PID %d: PES continuation\n", ts->pck_number - nb_pck + 1, ts->pck_number, pes->pid));
+}
+
 GF_EXPORT
 GF_Err gf_m2ts_process_data(GF_M2TS_Demuxer *ts, char *data, u32 data_size)
 {
 	GF_Err e;
-	u32 pos, pck_size;
+	u32 pos, pck_size, nb_run;
+	GF_M2TS_PES *run_pes;
 	Bool is_align = 1;
 	if (ts->buffer) {
 		if (ts->alloc_size < ts->buffer_size+data_size) {
@@ -3487,7 +3546,13 @@ GF_Err gf_m2ts_process_data(GF_M2TS_Demuxer *ts, char *data, u32 data_size)
 			}
 			return e;
 		}
-		/*process*/
+		/*process runs of packets continuing the same PES at once, otherwise packet per packet*/
+		nb_run = gf_m2ts_get_pes_run(ts, (unsigned char *)ts->buffer+pos, (ts->buffer_size - pos) / pck_size, pck_size, &run_pes);
+		if (nb_run) {
+			gf_m2ts_process_pes_run(ts, run_pes, (unsigned char *)ts->buffer+pos, nb_run, pck_size);
+			pos += nb_run * pck_size;
+			continue;
+		}
 		e |= gf_m2ts_process_packet(ts, (unsigned char *)ts->buffer+pos);
 		pos += pck_size;
 
@@ -87,9 +87,13 @@ static void gf_es_reset(GF_Channel *ch, Bool for_start)
 	ch->min_computed_cts = 0;
 	gf_es_buffer_off(ch);
 
+	gf_mx_p(ch->buffer_mx);
 	if (ch->buffer) gf_free(ch->buffer);
 	ch->buffer = NULL;
 	ch->len = ch->allocSize = 0;
+	/*AUs are pushed to the inbox under the buffer mutex, no AU dispatched before the reset can get in after it*/
+	gf_db_unit_del(gf_atomic_ptr_swap((void * volatile *) &ch->AU_inbox, NULL));
+	gf_mx_v(ch->buffer_mx);
 
 	gf_db_unit_del(ch->AU_buffer_first);
 	ch->AU_buffer_first = ch->AU_buffer_last = NULL;
@@ -114,6 +118,7 @@ GF_Channel *gf_es_new(GF_ESD *esd)
 	if (!tmp) return NULL;
 
 	tmp->mx = gf_mx_new("Channel");
+	tmp->buffer_mx = gf_mx_new("ChannelBuffer");
 	tmp->esd = esd;
 	tmp->es_state = GF_ESM_ES_SETUP;
 
@@ -193,6 +198,7 @@ void gf_es_del(GF_Channel *ch)
 		gf_modules_close_interface((GF_BaseInterface *) ch->ipmp_tool);
 
 	if (ch->mx) gf_mx_del(ch->mx);
+	if (ch->buffer_mx) gf_mx_del(ch->buffer_mx);
 	gf_free(ch);
 }
 
@@ -290,9 +296,13 @@ void gf_es_reset_buffers(GF_Channel *ch)
 	GF_LOG(GF_LOG_ERROR, GF_LOG_SYNC, ("[SyncLayer] ES%d (%s): reseting buffers (%d AUs)\n", ch->esd->ESID, ch->odm->net_service->url, ch->AU_Count));
 	gf_mx_p(ch->mx);
 
+	gf_mx_p(ch->buffer_mx);
 	if (ch->buffer) gf_free(ch->buffer);
 	ch->buffer = NULL;
 	ch->len = ch->allocSize = 0;
+	/*AUs are pushed to the inbox under the buffer mutex, no AU dispatched before the reset can get in after it*/
+	gf_db_unit_del(gf_atomic_ptr_swap((void * volatile *) &ch->AU_inbox, NULL));
+	gf_mx_v(ch->buffer_mx);
 
 	gf_db_unit_del(ch->AU_buffer_first);
 	ch->AU_buffer_first = ch->AU_buffer_last = NULL;
@@ -306,17 +316,23 @@ void gf_es_reset_buffers(GF_Channel *ch)
 
 }
 
+static void gf_es_flush_inbox(GF_Channel *ch);
+
 void gf_es_reset_timing(GF_Channel *ch, Bool reset_buffer)
 {
-	struct _decoding_buffer *au = ch->AU_buffer_first;
+	struct _decoding_buffer *au;
 	gf_mx_p(ch->mx);
 
 	if (reset_buffer) {
+		gf_mx_p(ch->buffer_mx);
 		if (ch->buffer) gf_free(ch->buffer);
 		ch->buffer = NULL;
 		ch->len = ch->allocSize = 0;
+		gf_mx_v(ch->buffer_mx);
 	}
 
+	gf_es_flush_inbox(ch);
+	au = ch->AU_buffer_first;
 	while (au) {
 		au->CTS = au->DTS = 0;
 		au = au->next;
@@ -444,75 +460,12 @@ static void gf_es_update_buffer_time(GF_Channel *ch)
 	ch->BufferTime += ch->au_duration;
 }
 
-/*dispatch the AU in the DB*/
-static void gf_es_dispatch_au(GF_Channel *ch, u32 duration)
+/*inserts an AU in the decoding buffer - channel must be locked*/
+static void gf_es_insert_au(GF_Channel *ch, GF_DBUnit *au)
 {
-	u32 time;
-	GF_DBUnit *au;
-
-	if (!ch->buffer || !ch->len) {
-		if (ch->buffer) {
-			gf_free(ch->buffer);
-			ch->buffer = NULL;
-		}
-		return;
-	}
-
-	if (ch->odm->codec && ch->odm->codec->decode_only_rap && !ch->IsRap) {
-		if (ch->buffer) {
-			gf_free(ch->buffer);
-			ch->buffer = NULL;
-		}
-		return;
-	}
-
-	au = gf_db_unit_new();
-	if (!au) {
-		gf_free(ch->buffer);
-		ch->buffer = NULL;
-		ch->len = 0;
-		return;
-	}
-
-	au->CTS = ch->CTS;
-	au->DTS = ch->DTS;
-	if (ch->IsRap) au->flags |= GF_DB_AU_RAP;
-	if (ch->SeekFlag) au->flags |= GF_DB_AU_IS_SEEK;
-
-	if (ch->CTS_past_offset) {
-		au->CTS = ch->CTS_past_offset;
-		au->flags |= GF_DB_AU_CTS_IN_PAST;
-		ch->CTS_past_offset = 0;
-	}
-	if (ch->no_timestamps) {
-		au->flags |= GF_DB_AU_NO_TIMESTAMPS;
-		ch->no_timestamps=0;
-	}
-	au->data = ch->buffer;
-	au->dataLength = ch->len;
-	au->PaddingBits = ch->padingBits;
-	au->sender_ntp = ch->sender_ntp;
-	ch->sender_ntp = 0;
-
-	ch->IsRap = 0;
-	ch->SeekFlag = 0;
-	ch->padingBits = 0;
-	au->next = NULL;
-	ch->buffer = NULL;
-
-	if (ch->len + ch->media_padding_bytes != ch->allocSize) {
-		au->data = (char*)gf_realloc(au->data, sizeof(char) * (au->dataLength + ch->media_padding_bytes));
-	}
-	if (ch->media_padding_bytes) memset(au->data + au->dataLength, 0, sizeof(char)*ch->media_padding_bytes);
-
-	ch->len = ch->allocSize = 0;
-
-	gf_es_lock(ch, 1);
-
-
-	if( (ch->MaxBuffer && (ch->BufferTime > (s32) ( 300000)) )
-	        || (ch->AU_Count>10000)
-	  ) {
+	if (ch->AU_buffer_first && ( (ch->MaxBuffer && (ch->BufferTime > (s32) ( 300000)) )
+	                             || (ch->AU_Count>10000) )
+	   ) {
 		if (ch->AU_Count>10000) {
 			GF_LOG(GF_LOG_ERROR, GF_LOG_SYNC, ("[SyncLayer] ES%d (%s): Something really wrong, too many AUs (%d) in decoding buffer - trashing buffers\n", ch->esd->ESID, ch->odm->net_service->url, ch->AU_Count));
 		} else {
@@ -526,17 +479,6 @@ static void gf_es_dispatch_au(GF_Channel *ch, u32 duration)
 		ch->BufferTime = 0;
 	}
 
-	if (ch->service && ch->service->cache) {
-		GF_SLHeader slh;
-		memset(&slh, 0, sizeof(GF_SLHeader));
-		slh.accessUnitEndFlag = slh.accessUnitStartFlag = 1;
-		slh.compositionTimeStampFlag = slh.decodingTimeStampFlag = 1;
-		slh.decodingTimeStamp = ch->net_dts;
-		slh.compositionTimeStamp = ch->net_cts;
-		slh.randomAccessPointFlag = (au->flags & GF_DB_AU_RAP) ? 1 : 0;
-		ch->service->cache->Write(ch->service->cache, ch, au->data, au->dataLength, &slh);
-	}
-
 	if (!ch->AU_buffer_first) {
 		ch->AU_buffer_first = au;
 		ch->AU_buffer_last = au;
@@ -561,7 +503,8 @@ static void gf_es_dispatch_au(GF_Channel *ch, u32 duration)
 					au->DTS = au->CTS;
 
 #else
-				au->CTS = au->DTS = ch->CTS;
+				/*AUs may be inserted in batch, use the channel CTS at the time the AU was dispatched*/
+				au->CTS = au->DTS = au->dispatch_CTS;
 
 #if 0
 				GF_DBUnit *au_prev, *ins_au;
@@ -663,6 +606,7 @@ static void gf_es_dispatch_au(GF_Channel *ch, u32 duration)
 				if (au_prev->next && (au_prev->next->DTS==au->DTS)) {
 					gf_free(au->data);
 					gf_free(au);
+					return;
 				} else {
 					au->next = au_prev->next;
 					au_prev->next = au;
@@ -677,11 +621,131 @@ static void gf_es_dispatch_au(GF_Channel *ch, u32 duration)
 	}
 	assert(!ch->AU_buffer_last || ch->AU_buffer_last->next == NULL);
 
+	ch->au_duration = au->duration;
 	gf_es_update_buffer_time(ch);
-	ch->au_duration = 0;
-	if (duration) ch->au_duration = (u32) ((u64)1000 * duration / ch->ts_res);
 
 	GF_LOG(GF_LOG_DEBUG, GF_LOG_SYNC, ("[SyncLayer] ES%d (%s) - Dispatch AU DTS %d - CTS %d - RAP %d - Seek %d - size %d time %d Buffer %d Nb AUs %d - First AU relative timing %d\n", ch->esd->ESID, ch->odm->net_service->url, au->DTS, au->CTS, au->flags & GF_DB_AU_RAP, (au->flags & GF_DB_AU_IS_SEEK) ? 1 :0, au->dataLength, gf_clock_real_time(ch->clock), ch->BufferTime, ch->AU_Count, ch->AU_buffer_first ? ch->AU_buffer_first->DTS - gf_clock_time(ch->clock) : 0 ));
+}
+
+/*moves the AUs handed over without locking to the decoding buffer, in dispatch order - channel must be locked*/
+static void gf_es_flush_inbox(GF_Channel *ch)
+{
+	GF_DBUnit *au, *next, *batch;
+	if (!ch->AU_inbox) return;
+
+	au = gf_atomic_ptr_swap((void * volatile *) &ch->AU_inbox, NULL);
+	/*the inbox is most recent first*/
+	batch = NULL;
+	while (au) {
+		next = au->next;
+		au->next = batch;
+		batch = au;
+		au = next;
+	}
+	while (batch) {
+		next = batch->next;
+		batch->next = NULL;
+		gf_es_insert_au(ch, batch);
+		batch = next;
+	}
+}
+
+/*dispatch the AU in the DB*/
+static void gf_es_dispatch_au(GF_Channel *ch, u32 duration)
+{
+	u32 time;
+	GF_DBUnit *au, *head;
+
+	gf_mx_p(ch->buffer_mx);
+	if (!ch->buffer || !ch->len) {
+		if (ch->buffer) {
+			gf_free(ch->buffer);
+			ch->buffer = NULL;
+		}
+		gf_mx_v(ch->buffer_mx);
+		return;
+	}
+
+	if (ch->odm->codec && ch->odm->codec->decode_only_rap && !ch->IsRap) {
+		if (ch->buffer) {
+			gf_free(ch->buffer);
+			ch->buffer = NULL;
+		}
+		gf_mx_v(ch->buffer_mx);
+		return;
+	}
+
+	au = gf_db_unit_new();
+	if (!au) {
+		gf_free(ch->buffer);
+		ch->buffer = NULL;
+		ch->len = 0;
+		gf_mx_v(ch->buffer_mx);
+		return;
+	}
+
+	au->CTS = au->dispatch_CTS = ch->CTS;
+	au->DTS = ch->DTS;
+	if (duration) au->duration = (u32) ((u64)1000 * duration / ch->ts_res);
+	if (ch->IsRap) au->flags |= GF_DB_AU_RAP;
+	if (ch->SeekFlag) au->flags |= GF_DB_AU_IS_SEEK;
+
+	if (ch->CTS_past_offset) {
+		au->CTS = ch->CTS_past_offset;
+		au->flags |= GF_DB_AU_CTS_IN_PAST;
+		ch->CTS_past_offset = 0;
+	}
+	if (ch->no_timestamps) {
+		au->flags |= GF_DB_AU_NO_TIMESTAMPS;
+		ch->no_timestamps=0;
+	}
+	au->data = ch->buffer;
+	au->dataLength = ch->len;
+	au->PaddingBits = ch->padingBits;
+	au->sender_ntp = ch->sender_ntp;
+	ch->sender_ntp = 0;
+
+	ch->IsRap = 0;
+	ch->SeekFlag = 0;
+	ch->padingBits = 0;
+	au->next = NULL;
+	ch->buffer = NULL;
+
+	if (ch->len + ch->media_padding_bytes != ch->allocSize) {
+		au->data = (char*)gf_realloc(au->data, sizeof(char) * (au->dataLength + ch->media_padding_bytes));
+	}
+	if (ch->media_padding_bytes) memset(au->data + au->dataLength, 0, sizeof(char)*ch->media_padding_bytes);
+
+	ch->len = ch->allocSize = 0;
+
+	if (ch->service && ch->service->cache) {
+		GF_SLHeader slh;
+		memset(&slh, 0, sizeof(GF_SLHeader));
+		slh.accessUnitEndFlag = slh.accessUnitStartFlag = 1;
+		slh.compositionTimeStampFlag = slh.decodingTimeStampFlag = 1;
+		slh.decodingTimeStamp = ch->net_dts;
+		slh.compositionTimeStamp = ch->net_cts;
+		slh.randomAccessPointFlag = (au->flags & GF_DB_AU_RAP) ? 1 : 0;
+		ch->service->cache->Write(ch->service->cache, ch, au->data, au->dataLength, &slh);
+	}
+
+	/*hand the AU over to the decoding buffer. This does not wait for the channel: if it is locked by the decoder,
+	the AU stays in the inbox and is inserted, with all AUs received meanwhile, by the next thread locking the channel.
+	Systems streams dispatched directly to their decoder always lock the channel.
+	The push is done under the buffer mutex so that a concurrent channel reset drops the AU*/
+	do {
+		head = ch->AU_inbox;
+		au->next = head;
+	} while (!gf_atomic_ptr_cas((void * volatile *) &ch->AU_inbox, head, au));
+
+	gf_mx_v(ch->buffer_mx);
+
+	if (ch->dispatch_after_db) {
+		gf_es_lock(ch, 1);
+	} else if (!gf_mx_try_lock(ch->mx)) {
+		goto exit;
+	}
+	gf_es_flush_inbox(ch);
 
 	/*little optimisation: if direct dispatching is possible, try to decode the AU
 	we must lock the media scheduler to avoid deadlocks with other codecs accessing the scene or
@@ -731,6 +795,7 @@ static void gf_es_dispatch_au(GF_Channel *ch, u32 duration)
 
 	gf_es_lock(ch, 0);
 
+exit:
 	time = gf_term_get_time(ch->odm->term);
 	if (ch->BufferOn) {
 		ch->last_au_time = time;
@@ -787,6 +852,7 @@ void gf_es_receive_skip_sl(GF_ClientService *serv, GF_Channel *ch, const char *S
 		}
 	}
 
+	gf_es_flush_inbox(ch);
 	if (!ch->AU_buffer_first) {
 		ch->AU_buffer_first = au;
 		ch->AU_buffer_last = au;
@@ -1409,7 +1475,7 @@ void gf_es_receive_sl_packet(GF_ClientService *serv, GF_Channel *ch, char *paylo
 		}
 	}
 
-	gf_es_lock(ch, 1);
+	gf_mx_p(ch->buffer_mx);
 
 	if (hdr.paddingFlag && !EndAU) {
 		/*to do - this shouldn't happen anyway */
@@ -1430,9 +1496,9 @@ void gf_es_receive_sl_packet(GF_ClientService *serv, GF_Channel *ch, char *paylo
 		if (hdr.paddingFlag) ch->padingBits = hdr.paddingBits;
 	}
 
-	if (EndAU) gf_es_dispatch_au(ch, hdr.au_duration);
+	gf_mx_v(ch->buffer_mx);
 
-	gf_es_lock(ch, 0);
+	if (EndAU) gf_es_dispatch_au(ch, hdr.au_duration);
 }
 
 
@@ -1465,6 +1531,8 @@ GF_DBUnit *gf_es_get_au(GF_Channel *ch)
 
 	if (!ch->is_pulling) {
 		gf_mx_p(ch->mx);
+		/*insert AUs received while the channel was locked*/
+		gf_es_flush_inbox(ch);
 
 		if (!ch->AU_buffer_first || (ch->BufferTime < (s32) ch->MaxBuffer/2) ) {
 			/*query buffer level, don't sleep if too low*/
@@ -1652,6 +1720,7 @@ void gf_es_drop_au(GF_Channel *ch)
 	gf_es_lock(ch, 1);
 
 	if (!ch->AU_buffer_first) {
+		gf_es_flush_inbox(ch);
 		gf_es_lock(ch, 0);
 		return;
 	}
@@ -1675,6 +1744,10 @@ void gf_es_drop_au(GF_Channel *ch)
 	if (!ch->AU_buffer_first) ch->AU_buffer_last = NULL;
 	else if (!ch->AU_buffer_first->next) ch->AU_buffer_last = ch->AU_buffer_first;
 
+	/*insert AUs received while the channel was locked - this is done after removing the first AU since
+	insertion may reorder the head of the buffer*/
+	gf_es_flush_inbox(ch);
+
 	gf_es_update_buffer_time(ch);
 
 	/*if we get under our limit, rebuffer EXCEPT WHEN EOS is signaled*/
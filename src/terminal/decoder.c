@@ -238,7 +238,7 @@ GF_Err gf_codec_add_channel(GF_Codec *codec, GF_Channel *ch)
 			}
 			GF_LOG(GF_LOG_DEBUG, GF_LOG_CODEC, ("[ODM] Creating composition buffer for codec %s - %d units %d bytes each\n", codec->decio->module_name, max, CUsize));
 
-			codec->CB = gf_cm_new(CUsize, max, no_alloc);
+			codec->CB = gf_cm_new(CUsize, max, no_alloc, codec->odm->term->frame_pool);
 			codec->CB->Min = min;
 			codec->CB->odm = codec->odm;
 		}
@@ -306,7 +306,7 @@ GF_Err gf_codec_add_channel(GF_Codec *codec, GF_Channel *ch)
 		/*create a semaphore in non-notified stage*/
 		codec->odm->raw_frame_sema = gf_sema_new(1, 0);
 
-		codec->CB = gf_cm_new(CUsize, 1, 1);
+		codec->CB = gf_cm_new(CUsize, 1, 1, NULL);
 		codec->CB->Min = 0;
 		codec->CB->odm = codec->odm;
 		ch->is_raw_channel = 1;
@@ -1006,7 +1006,7 @@ static GF_Err MediaCodec_Process(GF_Codec *codec, u32 TimeAvailable)
 
 	entryTime = gf_sys_clock_high_res();
 
-	if (!codec->odm->term->bench_mode) {
+	if (!codec->odm->term->bench_mode && !(codec->odm->term->user->init_flags & GF_TERM_USE_VIRTUAL_CLOCK)) {
 		if ((codec->odm->term->flags & GF_TERM_DROP_LATE_FRAMES) || (codec->flags & GF_ESM_CODEC_IS_LOW_LATENCY))
 			drop_late_frames = GF_TRUE;
 	}
@@ -1346,6 +1346,8 @@ scalable_retry:
 					if (e!=GF_OK) {
 						CU->frame=NULL;
 					}
+					/*the composition unit holds a reference until the frame is consumed*/
+					gf_cm_frame_ref(CU->frame);
 					if (!CU->frame)
 						unit_size = 0;
 					else if (needs_resize) {
@@ -42,6 +42,10 @@ enum
 	/*only used by threaded decs to signal end of thread*/
 	GF_MM_CE_DEAD = 1<<4,
 	GF_MM_CE_DISCARDED = 1<<5,
+	/*decoder is scheduled on the worker pool*/
+	GF_MM_CE_POOLED = 1<<6,
+	/*pooled decoder is in a worker queue or being processed by a worker*/
+	GF_MM_CE_QUEUED = 1<<7,
 };
 
 typedef struct
@@ -51,8 +55,25 @@ typedef struct
 	/*for threaded decoders*/
 	GF_Thread *thread;
 	GF_Mutex *mx;
+	/*for pooled decoders: system time before which the decoder does not need to run again*/
+	u32 deadline;
 } CodecEntry;
 
+typedef struct
+{
+	GF_Terminal *term;
+	GF_Thread *thread;
+	/*pooled decoders owned by this worker, sorted by deadline. The worker takes tasks from the head,
+	idle workers steal from the tail the least urgent of the tasks already due*/
+	GF_List *tasks;
+	GF_Mutex *mx;
+	u32 idx;
+	Bool run, dead;
+} MM_Worker;
+
+static void mm_pool_start(GF_Terminal *term);
+static void mm_pool_stop(GF_Terminal *term);
+
 GF_Err gf_term_init_scheduler(GF_Terminal *term, u32 threading_mode)
 {
 	term->mm_mx = gf_mx_new("MediaManager");
@@ -103,6 +124,7 @@ void gf_term_stop_scheduler(GF_Terminal *term)
 		assert(! gf_list_count(term->codecs));
 		gf_th_del(term->mm_thread);
 	}
+	mm_pool_stop(term);
 	gf_list_del(term->codecs);
 	gf_mx_del(term->mm_mx);
 }
@@ -117,11 +139,233 @@ static CodecEntry *mm_get_codec(GF_List *list, GF_Codec *codec)
 	return NULL;
 }
 
+/*queues a pooled decoder on the given worker, keeping the worker queue sorted by deadline*/
+static void mm_worker_queue(MM_Worker *w, CodecEntry *ce)
+{
+	u32 i, count;
+	gf_mx_p(w->mx);
+	count = gf_list_count(w->tasks);
+	for (i=0; i<count; i++) {
+		CodecEntry *a = (CodecEntry*)gf_list_get(w->tasks, i);
+		if ((s32) (ce->deadline - a->deadline) < 0) break;
+	}
+	gf_list_insert(w->tasks, ce, i);
+	gf_mx_v(w->mx);
+}
+
+/*gets a due decoder from the worker queue - the owner takes the most urgent one, thieves take the least urgent
+due one so that the owner keeps the head of its queue*/
+static CodecEntry *mm_worker_pop(MM_Worker *w, u32 now, Bool steal)
+{
+	s32 i, count;
+	CodecEntry *ce = NULL;
+
+	if (steal) {
+		/*don't wait on a busy queue, try the next one*/
+		if (!gf_mx_try_lock(w->mx)) return NULL;
+	} else {
+		gf_mx_p(w->mx);
+	}
+	count = gf_list_count(w->tasks);
+	if (!steal) {
+		ce = (CodecEntry*)gf_list_get(w->tasks, 0);
+		if (ce && ((s32) (now - ce->deadline) >= 0)) gf_list_rem(w->tasks, 0);
+		else ce = NULL;
+	} else {
+		for (i=count-1; i>=0; i--) {
+			ce = (CodecEntry*)gf_list_get(w->tasks, i);
+			if ((s32) (now - ce->deadline) >= 0) {
+				gf_list_rem(w->tasks, i);
+				break;
+			}
+			ce = NULL;
+		}
+	}
+	gf_mx_v(w->mx);
+	return ce;
+}
+
+/*computes when a pooled decoder must run again from its composition buffer fill level: starving or boosted
+decoders are due right away, a full buffer delays the next run by one frame duration*/
+static u32 mm_pool_get_deadline(GF_Terminal *term, CodecEntry *ce)
+{
+	GF_CompositionMemory *cb = ce->dec->CB;
+	u32 now = gf_sys_clock();
+
+	if (ce->dec->PriorityBoost) return now;
+	if (!cb || !cb->Capacity || (cb->UnitCount < cb->Min)) return now + 1;
+	return now + 1 + term->frame_duration * cb->UnitCount / cb->Capacity;
+}
+
+static void mm_pool_run_task(MM_Worker *w, CodecEntry *ce)
+{
+	GF_Err e;
+	GF_Codec *codec = ce->dec;
+	GF_Terminal *term = w->term;
+
+	gf_mx_p(ce->mx);
+	if ((ce->flags & GF_MM_CE_RUNNING) && !codec->force_cb_resize) {
+		e = gf_codec_process(codec, term->frame_duration);
+		if (e) gf_term_message(term, codec->odm->net_service->url, "Decoding Error", e);
+
+		/*cf RunSingleDec*/
+		if (!codec->CB || (codec->CB->UnitCount == codec->CB->Capacity))
+			codec->PriorityBoost = 0;
+	}
+	/*decoder stopped while queued, drop the task - it will be queued again when restarted*/
+	if (ce->flags & GF_MM_CE_RUNNING) {
+		ce->deadline = mm_pool_get_deadline(term, ce);
+		mm_worker_queue(w, ce);
+	} else {
+		ce->flags &= ~GF_MM_CE_QUEUED;
+	}
+	gf_mx_v(ce->mx);
+}
+
+static u32 MM_WorkerLoop(void *par)
+{
+	MM_Worker *w = (MM_Worker *) par;
+	GF_Terminal *term = w->term;
+
+	GF_LOG(GF_LOG_DEBUG, GF_LOG_CORE, ("[MediaManager] Entering decoder worker %d thread ID %d\n", w->idx, gf_th_id() ));
+
+	while (w->run) {
+		u32 i, count, nb_tasks;
+		u32 now = gf_sys_clock();
+		CodecEntry *ce = mm_worker_pop(w, now, GF_FALSE);
+
+		nb_tasks = gf_list_count(w->tasks);
+		if (!ce) {
+			count = gf_list_count(term->mm_workers);
+			for (i=1; i<count; i++) {
+				MM_Worker *victim = (MM_Worker*)gf_list_get(term->mm_workers, (w->idx + i) % count);
+				nb_tasks += gf_list_count(victim->tasks);
+				ce = mm_worker_pop(victim, now, GF_TRUE);
+				if (ce) {
+					GF_LOG(GF_LOG_DEBUG, GF_LOG_MEDIA, ("[MediaManager] Worker %d stealing decoder %s from worker %d\n", w->idx, ce->dec->decio ? ce->dec->decio->module_name : "RAW", victim->idx));
+					break;
+				}
+			}
+		}
+		if (ce) {
+			mm_pool_run_task(w, ce);
+		} else {
+			/*nothing due, wait for the next deadline - sleep longer if no decoder is scheduled at all*/
+			gf_sleep(nb_tasks ? 1 : term->frame_duration/2);
+		}
+	}
+	w->dead = GF_TRUE;
+	return 0;
+}
+
+static void mm_pool_start(GF_Terminal *term)
+{
+	u32 i, nb_workers = 0;
+	const char *opt;
+
+	if (term->mm_workers) return;
+
+	opt = gf_cfg_get_key(term->user->config, "Systems", "DecoderThreads");
+	if (opt) nb_workers = atoi(opt);
+	if (!nb_workers) {
+		GF_SystemRTInfo rti;
+		if (gf_sys_get_rti(0, &rti, GF_RTI_SYSTEM_MEMORY_ONLY)) nb_workers = rti.nb_cores;
+		if (!nb_workers) nb_workers = 1;
+	}
+
+	GF_LOG(GF_LOG_INFO, GF_LOG_MEDIA, ("[MediaManager] Starting %d decoder worker threads\n", nb_workers));
+	term->mm_workers = gf_list_new();
+	term->mm_next_worker = 0;
+	for (i=0; i<nb_workers; i++) {
+		MM_Worker *w;
+		GF_SAFEALLOC(w, MM_Worker);
+		if (!w) break;
+		w->term = term;
+		w->idx = i;
+		w->tasks = gf_list_new();
+		w->mx = gf_mx_new("MediaWorker");
+		w->thread = gf_th_new("MediaWorker");
+		gf_list_add(term->mm_workers, w);
+	}
+	/*start threads once the worker list is complete, since workers browse it when stealing*/
+	for (i=0; i<gf_list_count(term->mm_workers); i++) {
+		MM_Worker *w = (MM_Worker*)gf_list_get(term->mm_workers, i);
+		w->run = GF_TRUE;
+		gf_th_run(w->thread, MM_WorkerLoop, w);
+		gf_th_set_priority(w->thread, term->priority);
+	}
+}
+
+static void mm_pool_stop(GF_Terminal *term)
+{
+	u32 i, count;
+	if (!term->mm_workers) return;
+
+	count = gf_list_count(term->mm_workers);
+	for (i=0; i<count; i++) {
+		MM_Worker *w = (MM_Worker*)gf_list_get(term->mm_workers, i);
+		w->run = GF_FALSE;
+	}
+	/*wait for all workers to exit before destroying any of them, since running workers may still steal from the others*/
+	for (i=0; i<count; i++) {
+		MM_Worker *w = (MM_Worker*)gf_list_get(term->mm_workers, i);
+		while (!w->dead) gf_sleep(1);
+	}
+	for (i=0; i<count; i++) {
+		MM_Worker *w = (MM_Worker*)gf_list_get(term->mm_workers, i);
+		/*decoders must have been detached from the pool before*/
+		assert(!gf_list_count(w->tasks));
+		gf_th_del(w->thread);
+		gf_mx_del(w->mx);
+		gf_list_del(w->tasks);
+		gf_free(w);
+	}
+	gf_list_del(term->mm_workers);
+	term->mm_workers = NULL;
+}
+
+/*schedules a started pooled decoder - called with the decoder mutex grabbed*/
+static void mm_pool_add_task(GF_Terminal *term, CodecEntry *ce)
+{
+	MM_Worker *w;
+	if (ce->flags & GF_MM_CE_QUEUED) return;
+	if (!term->mm_workers || !gf_list_count(term->mm_workers)) return;
+
+	w = (MM_Worker*)gf_list_get(term->mm_workers, term->mm_next_worker % gf_list_count(term->mm_workers));
+	term->mm_next_worker++;
+	ce->flags |= GF_MM_CE_QUEUED;
+	ce->deadline = gf_sys_clock();
+	mm_worker_queue(w, ce);
+}
+
+/*stops a pooled decoder and waits until no worker uses it anymore*/
+static void mm_pool_detach_task(GF_Terminal *term, CodecEntry *ce)
+{
+	u32 i, count;
+
+	gf_mx_p(ce->mx);
+	ce->flags &= ~GF_MM_CE_RUNNING;
+	count = term->mm_workers ? gf_list_count(term->mm_workers) : 0;
+	for (i=0; i<count; i++) {
+		MM_Worker *w = (MM_Worker*)gf_list_get(term->mm_workers, i);
+		gf_mx_p(w->mx);
+		if (gf_list_del_item(w->tasks, ce)>=0) ce->flags &= ~GF_MM_CE_QUEUED;
+		gf_mx_v(w->mx);
+	}
+	gf_mx_v(ce->mx);
+
+	/*a worker may have taken the task and be waiting for the decoder mutex*/
+	while (ce->flags & GF_MM_CE_QUEUED) gf_sleep(1);
+	/*make sure the worker has released the decoder mutex*/
+	gf_mx_p(ce->mx);
+	gf_mx_v(ce->mx);
+}
+
 
 void gf_term_add_codec(GF_Terminal *term, GF_Codec *codec)
 {
 	u32 i, count;
-	Bool threaded;
+	Bool threaded, pooled = 0;
 	CodecEntry *cd;
 	CodecEntry *ptr, *next;
 	GF_CodecCapability cap;
@@ -163,10 +407,21 @@ void gf_term_add_codec(GF_Terminal *term, GF_Codec *codec)
 		if ((codec->type==GF_STREAM_AUDIO) || (codec->type==GF_STREAM_VISUAL)) threaded = 1;
 	} else if (term->flags & GF_TERM_SINGLE_THREAD) {
 		threaded = 0;
+	} else if (term->flags & GF_TERM_POOL_THREAD) {
+		threaded = 0;
+		if ((codec->type==GF_STREAM_AUDIO) || (codec->type==GF_STREAM_VISUAL)) pooled = 1;
 	}
-	if (codec->flags & GF_ESM_CODEC_IS_RAW_MEDIA)
+	if (codec->flags & GF_ESM_CODEC_IS_RAW_MEDIA) {
 		threaded = 0;
+		pooled = 0;
+	}
 
+	if (pooled) {
+		cd->mx = gf_mx_new(cd->dec->decio->module_name);
+		cd->flags |= GF_MM_CE_POOLED;
+		gf_list_add(term->codecs, cd);
+		goto exit;
+	}
 	if (threaded) {
 		cd->thread = gf_th_new(cd->dec->decio->module_name);
 		cd->mx = gf_mx_new(cd->dec->decio->module_name);
@@ -181,7 +436,7 @@ void gf_term_add_codec(GF_Terminal *term, GF_Codec *codec)
 	count = gf_list_count(term->codecs);
 	for (i=0; i<count; i++) {
 		ptr = (CodecEntry*)gf_list_get(term->codecs, i);
-		if (ptr->flags & GF_MM_CE_THREADED) continue;
+		if (ptr->flags & (GF_MM_CE_THREADED | GF_MM_CE_POOLED)) continue;
 
 		//higher priority, continue
 		if (ptr->dec->Priority > codec->Priority) continue;
@@ -210,7 +465,7 @@ void gf_term_add_codec(GF_Terminal *term, GF_Codec *codec)
 			}
 			next = (CodecEntry*)gf_list_get(term->codecs, i+1);
 			//# priority level, insert
-			if ((next->flags & GF_MM_CE_THREADED) || (next->dec->Priority != codec->Priority)) {
+			if ((next->flags & (GF_MM_CE_THREADED | GF_MM_CE_POOLED)) || (next->dec->Priority != codec->Priority)) {
 				gf_list_insert(term->codecs, cd, i+1);
 				goto exit;
 			}
@@ -252,6 +507,10 @@ void gf_term_remove_codec(GF_Terminal *term, GF_Codec *codec)
 			gf_th_del(ce->thread);
 			gf_mx_del(ce->mx);
 		}
+		else if (ce->flags & GF_MM_CE_POOLED) {
+			mm_pool_detach_task(term, ce);
+			gf_mx_del(ce->mx);
+		}
 		if (locked) {
 			gf_free(ce);
 			gf_list_rem(term->codecs, i-1);
@@ -274,6 +533,43 @@ Bool gf_term_find_codec(GF_Terminal *term, GF_Codec *codec)
 	return 0;
 }
 
+/*virtual clock: the time base does not move while decoding, run all decoders until none of them can process more data
+for the current frame. This is slower than the time-sliced scheduling but gives the same result whatever the CPU load*/
+static void MM_SimulationStep_VirtualClock(GF_Terminal *term, u32 *nb_active_decs)
+{
+	CodecEntry *ce;
+	GF_Err e;
+	u32 i, nb_frames;
+	Bool has_progress = GF_TRUE;
+
+	gf_mx_p(term->mm_mx);
+	*nb_active_decs = 0;
+	while (has_progress) {
+		has_progress = GF_FALSE;
+		i=0;
+		while ((ce = (CodecEntry*)gf_list_enum(term->codecs, &i))) {
+			if (!(ce->flags & GF_MM_CE_RUNNING) || ce->dec->force_cb_resize) continue;
+
+			(*nb_active_decs) ++;
+			nb_frames = ce->dec->nb_dec_frames;
+			e = gf_codec_process(ce->dec, term->frame_duration);
+#ifndef GPAC_DISABLE_LOG
+			if (e) {
+				GF_LOG(GF_LOG_WARNING, GF_LOG_CODEC, ("[ODM%d] Decoding Error %s\n", ce->dec->odm->OD->objectDescriptorID, gf_error_to_string(e) ));
+			}
+#endif
+			if (ce->flags & GF_MM_CE_DISCARDED) {
+				i--;
+				gf_list_rem(term->codecs, i);
+				gf_free(ce);
+				continue;
+			}
+			if (ce->dec->nb_dec_frames != nb_frames) has_progress = GF_TRUE;
+		}
+	}
+	gf_mx_v(term->mm_mx);
+}
+
 static u32 MM_SimulationStep_Decoder(GF_Terminal *term, u32 *nb_active_decs)
 {
 	CodecEntry *ce;
@@ -295,6 +591,13 @@ static u32 MM_SimulationStep_Decoder(GF_Terminal *term, u32 *nb_active_decs)
 #ifndef GF_DISABLE_LOG
 	term->compositor->decoders_time = gf_sys_clock();
 #endif
+	if (term->user->init_flags & GF_TERM_USE_VIRTUAL_CLOCK) {
+		MM_SimulationStep_VirtualClock(term, nb_active_decs);
+#ifndef GF_DISABLE_LOG
+		term->compositor->decoders_time = gf_sys_clock() - term->compositor->decoders_time;
+#endif
+		return term->frame_duration;
+	}
 	gf_mx_p(term->mm_mx);
 
 	count = gf_list_count(term->codecs);
@@ -308,7 +611,7 @@ static u32 MM_SimulationStep_Decoder(GF_Terminal *term, u32 *nb_active_decs)
 		ce = (CodecEntry*)gf_list_get(term->codecs, term->last_codec);
 		if (!ce) break;
 
-		if (!(ce->flags & GF_MM_CE_RUNNING) || (ce->flags & GF_MM_CE_THREADED) || ce->dec->force_cb_resize) {
+		if (!(ce->flags & GF_MM_CE_RUNNING) || (ce->flags & (GF_MM_CE_THREADED | GF_MM_CE_POOLED)) || ce->dec->force_cb_resize) {
 			remain--;
 			if (!remain) break;
 			term->last_codec = (term->last_codec + 1) % count;
@@ -472,6 +775,8 @@ void gf_term_start_codec(GF_Codec *codec, Bool is_resume)
 		if (ce->thread) {
 			gf_th_run(ce->thread, RunSingleDec, ce);
 			gf_th_set_priority(ce->thread, term->priority);
+		} else if (ce->flags & GF_MM_CE_POOLED) {
+			mm_pool_add_task(term, ce);
 		} else {
 			term->cumulated_priority += ce->dec->Priority+1;
 		}
@@ -541,7 +846,7 @@ void gf_term_stop_codec(GF_Codec *codec, u32 reason)
 	/*don't wait for end of thread since this can be triggered within the decoding thread*/
 	if (ce->flags & GF_MM_CE_RUNNING) {
 		ce->flags &= ~GF_MM_CE_RUNNING;
-		if (!ce->thread)
+		if (!ce->thread && !(ce->flags & GF_MM_CE_POOLED))
 			term->cumulated_priority -= codec->Priority+1;
 	}
 	if (codec->CB) gf_cm_abort_buffering(codec->CB);
@@ -554,39 +859,50 @@ void gf_term_stop_codec(GF_Codec *codec, u32 reason)
 void gf_term_set_threading(GF_Terminal *term, u32 mode)
 {
 	u32 i;
-	Bool thread_it, restart_it;
+	Bool thread_it, pool_it, restart_it;
 	CodecEntry *ce;
 
 	switch (mode) {
 	case GF_TERM_THREAD_SINGLE:
 		if (term->flags & GF_TERM_SINGLE_THREAD) return;
-		term->flags &= ~GF_TERM_MULTI_THREAD;
+		term->flags &= ~(GF_TERM_MULTI_THREAD | GF_TERM_POOL_THREAD);
 		term->flags |= GF_TERM_SINGLE_THREAD;
 		break;
 	case GF_TERM_THREAD_MULTI:
 		if (term->flags & GF_TERM_MULTI_THREAD) return;
-		term->flags &= ~GF_TERM_SINGLE_THREAD;
+		term->flags &= ~(GF_TERM_SINGLE_THREAD | GF_TERM_POOL_THREAD);
 		term->flags |= GF_TERM_MULTI_THREAD;
 		break;
+	case GF_TERM_THREAD_POOL:
+		if (term->flags & GF_TERM_POOL_THREAD) return;
+		/*the pool is driven by the media manager thread*/
+		if (term->user->init_flags & GF_TERM_NO_DECODER_THREAD) return;
+		term->flags &= ~(GF_TERM_SINGLE_THREAD | GF_TERM_MULTI_THREAD);
+		term->flags |= GF_TERM_POOL_THREAD;
+		break;
 	default:
-		if (!(term->flags & (GF_TERM_MULTI_THREAD | GF_TERM_SINGLE_THREAD) ) ) return;
-		term->flags &= ~GF_TERM_SINGLE_THREAD;
-		term->flags &= ~GF_TERM_MULTI_THREAD;
+		if (!(term->flags & (GF_TERM_MULTI_THREAD | GF_TERM_SINGLE_THREAD | GF_TERM_POOL_THREAD) ) ) return;
+		term->flags &= ~(GF_TERM_SINGLE_THREAD | GF_TERM_MULTI_THREAD | GF_TERM_POOL_THREAD);
 		break;
 	}
 
 	gf_mx_p(term->mm_mx);
 
+	if (mode == GF_TERM_THREAD_POOL) mm_pool_start(term);
 
 	i=0;
 	while ((ce = (CodecEntry*)gf_list_enum(term->codecs, &i))) {
 		thread_it = 0;
+		pool_it = 0;
 		/*free mode, decoder wants threading - do */
 		if ((mode == GF_TERM_THREAD_FREE) && (ce->flags & GF_MM_CE_REQ_THREAD)) thread_it = 1;
 		else if (mode == GF_TERM_THREAD_MULTI) thread_it = 1;
+		else if ((mode == GF_TERM_THREAD_POOL) && !(ce->dec->flags & GF_ESM_CODEC_IS_RAW_MEDIA)
+		         && ((ce->dec->type==GF_STREAM_AUDIO) || (ce->dec->type==GF_STREAM_VISUAL)) ) pool_it = 1;
 
 		if (thread_it && (ce->flags & GF_MM_CE_THREADED)) continue;
-		if (!thread_it && !(ce->flags & GF_MM_CE_THREADED)) continue;
+		if (pool_it && (ce->flags & GF_MM_CE_POOLED)) continue;
+		if (!thread_it && !pool_it && !(ce->flags & (GF_MM_CE_THREADED | GF_MM_CE_POOLED))) continue;
 
 		restart_it = 0;
 		if (ce->flags & GF_MM_CE_RUNNING) {
@@ -603,6 +919,11 @@ void gf_term_set_threading(GF_Terminal *term, u32 mode)
 			gf_mx_del(ce->mx);
 			ce->mx = NULL;
 			ce->flags &= ~GF_MM_CE_THREADED;
+		} else if (ce->flags & GF_MM_CE_POOLED) {
+			mm_pool_detach_task(term, ce);
+			gf_mx_del(ce->mx);
+			ce->mx = NULL;
+			ce->flags &= ~GF_MM_CE_POOLED;
 		} else {
 			term->cumulated_priority -= ce->dec->Priority+1;
 		}
@@ -611,6 +932,9 @@ void gf_term_set_threading(GF_Terminal *term, u32 mode)
 			ce->flags |= GF_MM_CE_THREADED;
 			ce->thread = gf_th_new(ce->dec->decio->module_name);
 			ce->mx = gf_mx_new(ce->dec->decio->module_name);
+		} else if (pool_it) {
+			ce->flags |= GF_MM_CE_POOLED;
+			ce->mx = gf_mx_new(ce->dec->decio->module_name);
 		}
 
 		if (restart_it) {
@@ -618,11 +942,19 @@ void gf_term_set_threading(GF_Terminal *term, u32 mode)
 			if (ce->thread) {
 				gf_th_run(ce->thread, RunSingleDec, ce);
 				gf_th_set_priority(ce->thread, term->priority);
+			} else if (ce->flags & GF_MM_CE_POOLED) {
+				gf_mx_p(ce->mx);
+				mm_pool_add_task(term, ce);
+				gf_mx_v(ce->mx);
 			} else {
 				term->cumulated_priority += ce->dec->Priority+1;
 			}
 		}
 	}
+
+	/*all pooled decoders are now detached*/
+	if (mode != GF_TERM_THREAD_POOL) mm_pool_stop(term);
+
 	gf_mx_v(term->mm_mx);
 }
 
@@ -671,6 +1003,13 @@ void gf_term_set_priority(GF_Terminal *term, s32 Priority)
 		if (ce->flags & GF_MM_CE_THREADED)
 			gf_th_set_priority(ce->thread, Priority);
 	}
+	i=0;
+	if (term->mm_workers) {
+		MM_Worker *w;
+		while ((w = (MM_Worker*)gf_list_enum(term->mm_workers, &i))) {
+			gf_th_set_priority(w->thread, Priority);
+		}
+	}
 	term->priority = Priority;
 	gf_mx_v(term->mm_mx);
 }
@@ -79,26 +79,157 @@ static GFINLINE void my_large_gf_free(void *ptr) {
 #endif
 
 
-static void gf_cm_unit_del(GF_CMUnit *cb, Bool no_data_allocation)
+/*frame buffers are aligned and allocated by size classes, 8 classes per power of 2, so that a released
+buffer can be reused for any frame size of the same class*/
+#define GF_FRAME_POOL_ALIGN	64
+#define GF_FRAME_POOL_MIN_SIZE	4096
+
+/*stored right before the aligned frame data*/
+typedef struct
+{
+	void *raw;
+	u32 size;
+} GF_FrameHeader;
+
+struct _frame_pool
+{
+	GF_Mutex *mx;
+	/*released frames, least recently released first*/
+	GF_List *frames;
+	/*size of released frames and max size of released frames kept in the pool*/
+	u32 size, max_size;
+};
+
+#define FRAME_HEADER(_data)	((GF_FrameHeader *) ((char *)(_data) - sizeof(GF_FrameHeader)))
+
+static u32 gf_frame_pool_size_class(u32 size)
+{
+	u32 shift = 0;
+	if (size < GF_FRAME_POOL_MIN_SIZE) return GF_FRAME_POOL_MIN_SIZE;
+	/*keep the 4 most significant bits, rounding up*/
+	while ((size >> shift) >= 16) shift++;
+	return ((size + (1<<shift) - 1) >> shift) << shift;
+}
+
+static void gf_frame_pool_free(char *data)
+{
+	my_large_gf_free(FRAME_HEADER(data)->raw);
+}
+
+GF_FramePool *gf_frame_pool_new(u32 max_size)
+{
+	GF_FramePool *pool;
+	GF_SAFEALLOC(pool, GF_FramePool);
+	if (!pool) return NULL;
+	pool->frames = gf_list_new();
+	pool->mx = gf_mx_new("FramePool");
+	pool->max_size = max_size;
+	return pool;
+}
+
+void gf_frame_pool_del(GF_FramePool *pool)
+{
+	if (!pool) return;
+	while (gf_list_count(pool->frames)) {
+		char *data = gf_list_pop_back(pool->frames);
+		gf_frame_pool_free(data);
+	}
+	gf_list_del(pool->frames);
+	gf_mx_del(pool->mx);
+	gf_free(pool);
+}
+
+char *gf_frame_pool_get(GF_FramePool *pool, u32 size)
+{
+	u32 i, count, alloc_size;
+	char *raw, *data;
+	GF_FrameHeader *hdr;
+	if (!size) return NULL;
+
+	if (pool && pool->max_size) {
+		alloc_size = gf_frame_pool_size_class(size);
+		gf_mx_p(pool->mx);
+		count = gf_list_count(pool->frames);
+		/*most recently released first, its pages are more likely to be resident*/
+		for (i=count; i>0; i--) {
+			data = gf_list_get(pool->frames, i-1);
+			if (FRAME_HEADER(data)->size == alloc_size) {
+				gf_list_rem(pool->frames, i-1);
+				pool->size -= alloc_size;
+				gf_mx_v(pool->mx);
+				return data;
+			}
+		}
+		gf_mx_v(pool->mx);
+	} else {
+		alloc_size = size;
+	}
+
+	raw = (char *) my_large_alloc(alloc_size + GF_FRAME_POOL_ALIGN + sizeof(GF_FrameHeader));
+	if (!raw) return NULL;
+	data = raw + sizeof(GF_FrameHeader);
+	data += (GF_FRAME_POOL_ALIGN - (PTR_TO_U_CAST data) % GF_FRAME_POOL_ALIGN) % GF_FRAME_POOL_ALIGN;
+	hdr = FRAME_HEADER(data);
+	hdr->raw = raw;
+	hdr->size = alloc_size;
+	return data;
+}
+
+void gf_frame_pool_release(GF_FramePool *pool, char *data)
+{
+	u32 size;
+	if (!data) return;
+	size = FRAME_HEADER(data)->size;
+	if (!pool || (size > pool->max_size)) {
+		gf_frame_pool_free(data);
+		return;
+	}
+	gf_mx_p(pool->mx);
+	gf_list_add(pool->frames, data);
+	pool->size += size;
+	/*trash the oldest frames until we are back in budget*/
+	while (pool->size > pool->max_size) {
+		char *old = gf_list_get(pool->frames, 0);
+		gf_list_rem(pool->frames, 0);
+		pool->size -= FRAME_HEADER(old)->size;
+		gf_frame_pool_free(old);
+	}
+	gf_mx_v(pool->mx);
+}
+
+
+void gf_cm_frame_ref(GF_MediaDecoderFrame *frame)
+{
+	if (frame) frame->nb_refs++;
+}
+
+void gf_cm_frame_unref(GF_MediaDecoderFrame *frame)
+{
+	if (!frame) return;
+	if (frame->nb_refs) frame->nb_refs--;
+	if (!frame->nb_refs) frame->Release(frame);
+}
+
+static void gf_cm_unit_del(GF_CMUnit *cb, Bool no_data_allocation, GF_FramePool *pool)
 {
 	if (!cb)
 		return;
-	if (cb->next) gf_cm_unit_del(cb->next, no_data_allocation);
+	if (cb->next) gf_cm_unit_del(cb->next, no_data_allocation, pool);
 	cb->next = NULL;
 	if (cb->data) {
 		if (!no_data_allocation) {
-			my_large_gf_free(cb->data);
+			gf_frame_pool_release(pool, cb->data);
 		}
 		cb->data = NULL;
 		if (cb->frame) {
-			cb->frame->Release(cb->frame);
+			gf_cm_frame_unref(cb->frame);
 			cb->frame=NULL;
 		}
 	}
 	gf_free(cb);
 }
 
-GF_CompositionMemory *gf_cm_new(u32 UnitSize, u32 capacity, Bool no_allocation)
+GF_CompositionMemory *gf_cm_new(u32 UnitSize, u32 capacity, Bool no_allocation, GF_FramePool *pool)
 {
 	GF_CompositionMemory *tmp;
 	GF_CMUnit *cu, *prev;
@@ -114,6 +245,7 @@ GF_CompositionMemory *gf_cm_new(u32 UnitSize, u32 capacity, Bool no_allocation)
 	tmp->Capacity = capacity;
 	tmp->UnitSize = UnitSize;
 	tmp->no_allocation = no_allocation;
+	tmp->pool = pool;
 
 	prev = NULL;
 	i = 1;
@@ -129,7 +261,7 @@ GF_CompositionMemory *gf_cm_new(u32 UnitSize, u32 capacity, Bool no_allocation)
 		if (no_allocation) {
 			cu->data = NULL;
 		} else {
-			cu->data = UnitSize ? (char*)my_large_alloc(sizeof(char)*UnitSize) : NULL;
+			cu->data = gf_frame_pool_get(pool, UnitSize);
 			if (cu->data) memset(cu->data, 0, sizeof(char)*UnitSize);
 		}
 		prev = cu;
@@ -158,9 +290,14 @@ void gf_cm_del(GF_CompositionMemory *cb)
 	if (cb->input) {
 		/*break the loop and destroy*/
 		cb->input->prev->next = NULL;
-		gf_cm_unit_del(cb->input, cb->no_allocation);
+		gf_cm_unit_del(cb->input, cb->no_allocation, cb->pool);
 		cb->input = NULL;
 	}
+	/*the frame kept by the media object must be released while the decoder is still loaded*/
+	if (cb->odm->mo && cb->odm->mo->media_frame) {
+		gf_cm_frame_unref(cb->odm->mo->media_frame);
+		cb->odm->mo->media_frame = NULL;
+	}
 	gf_odm_lock(cb->odm, 0);
 	gf_free(cb);
 }
@@ -389,7 +526,7 @@ void gf_cm_reset(GF_CompositionMemory *cb)
 
 	cu->dataLength = 0;
 	if (cu->frame) {
-		cu->frame->Release(cu->frame);
+		gf_cm_frame_unref(cu->frame);
 		cu->frame = NULL;
 	}
 	cu->TS = 0;
@@ -399,7 +536,7 @@ void gf_cm_reset(GF_CompositionMemory *cb)
 		cu->TS = 0;
 		cu->dataLength = 0;
 		if (cu->frame) {
-			cu->frame->Release(cu->frame);
+			gf_cm_frame_unref(cu->frame);
 			cu->frame = NULL;
 		}
 		cu = cu->next;
@@ -440,8 +577,8 @@ void gf_cm_resize(GF_CompositionMemory *cb, u32 newCapacity)
 
 	cb->UnitSize = newCapacity;
 	if (!cb->no_allocation) {
-		my_large_gf_free(cu->data);
-		cu->data = (char*) my_large_alloc(newCapacity);
+		gf_frame_pool_release(cb->pool, cu->data);
+		cu->data = gf_frame_pool_get(cb->pool, newCapacity);
 		cu->dataLength = 0;
 	} else {
 		cu->data = NULL;
@@ -453,8 +590,8 @@ void gf_cm_resize(GF_CompositionMemory *cb, u32 newCapacity)
 	cu = cu->next;
 	while (cu != cb->input) {
 		if (!cb->no_allocation) {
-			my_large_gf_free(cu->data);
-			cu->data = (char*) my_large_alloc(newCapacity);
+			gf_frame_pool_release(cb->pool, cu->data);
+			cu->data = gf_frame_pool_get(cb->pool, newCapacity);
 		} else {
 			cu->data = NULL;
 		}
@@ -480,7 +617,7 @@ void gf_cm_reinit(GF_CompositionMemory *cb, u32 UnitSize, u32 Capacity)
 	if (cb->input) {
 		/*break the loop and destroy*/
 		cb->input->prev->next = NULL;
-		gf_cm_unit_del(cb->input, cb->no_allocation);
+		gf_cm_unit_del(cb->input, cb->no_allocation, cb->pool);
 		cb->input = NULL;
 	}
 
@@ -502,7 +639,7 @@ void gf_cm_reinit(GF_CompositionMemory *cb, u32 UnitSize, u32 Capacity)
 		if (cb->no_allocation) {
 			cu->data = NULL;
 		} else {
-			cu->data = (char*)my_large_alloc(UnitSize);
+			cu->data = gf_frame_pool_get(cb->pool, UnitSize);
 		}
 		prev = cu;
 		Capacity --;
@@ -624,7 +761,7 @@ void gf_cm_drop_output(GF_CompositionMemory *cb)
 	/*reset the output*/
 	cb->output->dataLength = 0;
 	if (cb->output->frame) {
-		cb->output->frame->Release(cb->output->frame);
+		gf_cm_frame_unref(cb->output->frame);
 		cb->output->frame = NULL;
 	}
 	cb->output->TS = 0;
@@ -62,6 +62,10 @@ typedef struct _decoding_buffer
 	/*amount of padding bits*/
 	u8 PaddingBits;
 	u64 sender_ntp;
+	/*AU duration in ms, 0 if unknown*/
+	u32 duration;
+	/*channel CTS at dispatch time, used when DTS is recomputed*/
+	u32 dispatch_CTS;
 
 	u32 dataLength;
 	char *data;
@@ -121,6 +125,8 @@ struct _composition_memory
 	/*Unit size is the size of each buffer*/
 	u32 UnitSize;
 	Bool no_allocation;
+	/*terminal frame pool used to allocate unit buffers, may be NULL*/
+	GF_FramePool *pool;
 
 	/*Status of the buffer*/
 	u32 Status;
@@ -142,8 +148,22 @@ struct _composition_memory
 	s32 LastRenderedNTPDiff;
 };
 
+/*frame pool shared by all composition buffers of a terminal. Released unit buffers are kept for reuse
+by size class, up to max_size bytes; a max_size of 0 disables the pool*/
+GF_FramePool *gf_frame_pool_new(u32 max_size);
+void gf_frame_pool_del(GF_FramePool *pool);
+/*gets an aligned buffer of at least size bytes - pool may be NULL*/
+char *gf_frame_pool_get(GF_FramePool *pool, u32 size);
+/*releases a buffer obtained with gf_frame_pool_get - pool may be NULL*/
+void gf_frame_pool_release(GF_FramePool *pool, char *data);
+
+/*adds a reference to a decoder frame*/
+void gf_cm_frame_ref(GF_MediaDecoderFrame *frame);
+/*removes a reference to a decoder frame, releasing it to the decoder once no longer used*/
+void gf_cm_frame_unref(GF_MediaDecoderFrame *frame);
+
 /*a composition buffer only has fixed-size unit*/
-GF_CompositionMemory *gf_cm_new(u32 UnitSize, u32 capacity, Bool no_allocation);
+GF_CompositionMemory *gf_cm_new(u32 UnitSize, u32 capacity, Bool no_allocation, GF_FramePool *pool);
 void gf_cm_del(GF_CompositionMemory *cb);
 /*re-inits complete cb*/
 void gf_cm_reinit(GF_CompositionMemory *cb, u32 UnitSize, u32 Capacity);
@@ -384,6 +384,33 @@ void gf_mo_update_caps(GF_MediaObject *mo)
 	}
 }
 
+static void gf_mo_decode_until_mature(GF_Codec *codec)
+{
+	GF_CMUnit *CU;
+	u32 nb_frames, obj_time = gf_clock_time(codec->ck);
+
+	while (1) {
+		CU = gf_cm_get_output(codec->CB);
+		if (CU) {
+			/*first frame not yet mature, or next frame not yet mature: the current frame is known*/
+			if (CU->TS > obj_time) break;
+			if (CU->next->dataLength && (CU->next->TS > obj_time)) break;
+			/*composition memory is full of frames older than the object time, drop the oldest one*/
+			if (CU->next->dataLength && (codec->CB->Capacity > 1) && (codec->CB->UnitCount == codec->CB->Capacity)) {
+				gf_cm_drop_output(codec->CB);
+				continue;
+			}
+		}
+		nb_frames = codec->nb_dec_frames;
+		if (gf_term_lock_codec(codec, GF_TRUE, GF_TRUE)) {
+			gf_codec_process(codec, codec->odm->term->frame_duration);
+			gf_term_lock_codec(codec, GF_FALSE, GF_TRUE);
+		}
+		/*nothing more to decode (end of stream or no input data)*/
+		if (nb_frames == codec->nb_dec_frames) break;
+	}
+}
+
 GF_EXPORT
 char *gf_mo_fetch_data(GF_MediaObject *mo, GF_MOFetchMode resync, Bool *eos, u32 *timestamp, u32 *size, s32 *ms_until_pres, s32 *ms_until_next, GF_MediaDecoderFrame **outFrame)
 {
@@ -416,7 +443,10 @@ char *gf_mo_fetch_data(GF_MediaObject *mo, GF_MOFetchMode resync, Bool *eos, u32
 	if (mo->nb_fetch) {
 		GF_LOG(GF_LOG_DEBUG, GF_LOG_MEDIA, ("[ODM%d] ODM %d: CU already fetched, returning\n", mo->odm->OD->objectDescriptorID));
 		mo->nb_fetch ++;
+		if (outFrame) *outFrame = mo->media_frame;
 		gf_odm_lock(mo->odm, 0);
+		if (mo->media_frame)
+			return (char *) mo->media_frame;
 		return mo->frame;
 	}
 	codec = mo->odm->codec;
@@ -479,6 +509,16 @@ char *gf_mo_fetch_data(GF_MediaObject *mo, GF_MOFetchMode resync, Bool *eos, u32
 		}
 	}
 
+	/*virtual clock: decode until the frame matching the object time is in the composition memory*/
+	if (! *eos && (mo->type==GF_MEDIA_OBJECT_VIDEO) && (mo->odm->term->user->init_flags & GF_TERM_USE_VIRTUAL_CLOCK)) {
+		gf_odm_lock(mo->odm, 0);
+		gf_mo_decode_until_mature(codec);
+		if (!gf_odm_lock_mo(mo)) {
+			GF_LOG(GF_LOG_DEBUG, GF_LOG_MEDIA, ("[ODM%d] ODM %d: Failed to lock ODM\n", mo->odm->OD->objectDescriptorID));
+			return NULL;
+		}
+	}
+
 	/*new frame to fetch, lock*/
 	CU = gf_cm_get_output(codec->CB);
 	/*no output*/
@@ -583,7 +623,12 @@ char *gf_mo_fetch_data(GF_MediaObject *mo, GF_MOFetchMode resync, Bool *eos, u32
 
 	mo->framesize = CU->dataLength - CU->RenderedLength;
 	mo->frame = CU->data + CU->RenderedLength;
-	mo->media_frame = CU->frame;
+	/*keep the frame alive after the unit is dropped, until the next one is fetched*/
+	if (mo->media_frame != CU->frame) {
+		gf_cm_frame_ref(CU->frame);
+		gf_cm_frame_unref(mo->media_frame);
+		mo->media_frame = CU->frame;
+	}
 
 	if (CU->next->dataLength) {
 		diff = (s32) (CU->next->TS) - (s32) obj_time;
@@ -379,6 +379,7 @@ static void gf_term_reload_cfg(GF_Terminal *term)
 			mode = GF_TERM_THREAD_FREE;
 			if (!stricmp(sOpt, "Single")) mode = GF_TERM_THREAD_SINGLE;
 			else if (!stricmp(sOpt, "Multi")) mode = GF_TERM_THREAD_MULTI;
+			else if (!stricmp(sOpt, "Pool")) mode = GF_TERM_THREAD_POOL;
 			gf_term_set_threading(term, mode);
 		}
 	} else {
@@ -647,6 +648,7 @@ GF_EXPORT
 GF_Terminal *gf_term_new(GF_User *user)
 {
 	u32 i;
+	s32 pool_size;
 	GF_Terminal *tmp;
 	const char *cf;
 
@@ -666,6 +668,10 @@ GF_Terminal *gf_term_new(GF_User *user)
 
 	tmp->user = user;
 
+	/*virtual clock: decoding and composition are driven by the user, one frame at a time*/
+	if (user->init_flags & GF_TERM_USE_VIRTUAL_CLOCK)
+		user->init_flags |= GF_TERM_NO_DECODER_THREAD | GF_TERM_NO_COMPOSITOR_THREAD | GF_TERM_NO_REGULATION;
+
 	if (user->init_flags & GF_TERM_NO_DECODER_THREAD) {
 		if (user->init_flags & GF_TERM_NO_VISUAL_THREAD) {
 			user->init_flags |= GF_TERM_NO_COMPOSITOR_THREAD;
@@ -715,6 +721,18 @@ GF_Terminal *gf_term_new(GF_User *user)
 	tmp->input_streams = gf_list_new();
 	tmp->x3d_sensors = gf_list_new();
 
+	/*size in MB of the composition frames kept for reuse, not changeable at runtime*/
+	cf = gf_cfg_get_key(user->config, "Systems", "FramePoolSize");
+	if (!cf) {
+		cf = "64";
+		gf_cfg_set_key(user->config, "Systems", "FramePoolSize", cf);
+	}
+	/*clamp before converting to bytes so that the size fits in a u32*/
+	pool_size = atoi(cf);
+	if (pool_size < 0) pool_size = 0;
+	else if (pool_size > 4095) pool_size = 4095;
+	tmp->frame_pool = gf_frame_pool_new((u32) pool_size * 1024 * 1024);
+
 	/*mode is changed when reloading cfg*/
 	gf_term_init_scheduler(tmp, GF_TERM_THREAD_FREE);
 	GF_LOG(GF_LOG_DEBUG, GF_LOG_MEDIA, ("[Terminal] Terminal created - loading config\n"));
@@ -874,6 +892,7 @@ GF_Err gf_term_del(GF_Terminal * term)
 	if (term->downloader) gf_dm_del(term->downloader);
 
 	gf_mx_del(term->media_queue_mx);
+	gf_frame_pool_del(term->frame_pool);
 
 	if (term->locales.szAbsRelocatedPath) gf_free(term->locales.szAbsRelocatedPath);
 	gf_list_del(term->uri_relocators);
@@ -250,6 +250,57 @@ u8 gf_bs_read_bit(GF_BitStream *bs)
 
 }
 
+/*word-at-a-time read for memory streams: the remaining bits of the current byte and the next bytes
+are gathered in a 64 bit register and the result is extracted with shifts. The bitstream state (position,
+current byte and bit count) is left exactly as the bit-by-bit reader would leave it, so that seek, peek,
+rewind and bit offset queries are not impacted. Returns GF_FALSE if the data is not available in memory,
+in which case the generic reader must be used (end of stream signaling). nBits shall not exceed 32*/
+static GFINLINE Bool BS_ReadBitsMem(GF_BitStream *bs, u32 nBits, u64 *val)
+{
+	u64 acc;
+	u32 byte, rem, need, nb_bytes, left;
+	const u8 *ptr;
+
+	/*bits left in the current byte*/
+	rem = 8 - bs->nbBits;
+	if (nBits <= rem) {
+		/*same as reading nBits times a single bit*/
+		bs->current <<= nBits;
+		bs->nbBits += nBits;
+		*val = (bs->current >> 8) & ((1<<nBits) - 1);
+		return GF_TRUE;
+	}
+	byte = (bs->current >> bs->nbBits) & 0xFF;
+	need = nBits - rem;
+	nb_bytes = (need + 7) >> 3;
+	if (bs->position + nb_bytes > bs->size) return GF_FALSE;
+
+	acc = byte & ((1<<rem) - 1);
+	ptr = (const u8 *) bs->original + bs->position;
+	switch (nb_bytes) {
+	case 4:
+		acc = (acc<<8) | *ptr++;
+	case 3:
+		acc = (acc<<8) | *ptr++;
+	case 2:
+		acc = (acc<<8) | *ptr++;
+	case 1:
+		acc = (acc<<8) | *ptr++;
+		break;
+	default:
+		return GF_FALSE;
+	}
+	bs->position += nb_bytes;
+	/*number of unread bits in the last loaded byte*/
+	left = (nb_bytes<<3) - need;
+	bs->nbBits = 8 - left;
+	bs->current = ((u32) ptr[-1]) << bs->nbBits;
+	/*acc holds at most 40 bits, the result is in its upper part*/
+	acc >>= left;
+	*val = acc & ((((u64)1) << nBits) - 1);
+	return GF_TRUE;
+}
+
 GF_EXPORT
 u32 gf_bs_read_int(GF_BitStream *bs, u32 nBits)
 {
@@ -262,6 +313,16 @@ u32 gf_bs_read_int(GF_BitStream *bs, u32 nBits)
 		return ret;
 	}
 #endif
+	/*bits are in the current byte, same as reading nBits times a single bit*/
+	if (nBits + bs->nbBits <= 8) {
+		bs->current <<= nBits;
+		bs->nbBits += nBits;
+		return (bs->current >> 8) & ((1<<nBits) - 1);
+	}
+	if ((bs->bsmode == GF_BITSTREAM_READ) && (nBits<=32)) {
+		u64 val;
+		if (BS_ReadBitsMem(bs, nBits, &val)) return (u32) val;
+	}
 	ret = 0;
 	while (nBits-- > 0) {
 		ret <<= 1;
@@ -305,6 +366,11 @@ u32 gf_bs_read_u16(GF_BitStream *bs)
 {
 	u32 ret;
 	assert(bs->nbBits==8);
+	if ((bs->bsmode == GF_BITSTREAM_READ) && (bs->position + 2 <= bs->size)) {
+		const u8 *ptr = (const u8 *) bs->original + bs->position;
+		bs->position += 2;
+		return ((u32) ptr[0] << 8) | ptr[1];
+	}
 	ret = BS_ReadByte(bs);
 	ret<<=8;
 	ret |= BS_ReadByte(bs);
@@ -317,6 +383,11 @@ u32 gf_bs_read_u24(GF_BitStream *bs)
 {
 	u32 ret;
 	assert(bs->nbBits==8);
+	if ((bs->bsmode == GF_BITSTREAM_READ) && (bs->position + 3 <= bs->size)) {
+		const u8 *ptr = (const u8 *) bs->original + bs->position;
+		bs->position += 3;
+		return ((u32) ptr[0] << 16) | ((u32) ptr[1] << 8) | ptr[2];
+	}
 	ret = BS_ReadByte(bs);
 	ret<<=8;
 	ret |= BS_ReadByte(bs);
@@ -330,6 +401,11 @@ u32 gf_bs_read_u32(GF_BitStream *bs)
 {
 	u32 ret;
 	assert(bs->nbBits==8);
+	if ((bs->bsmode == GF_BITSTREAM_READ) && (bs->position + 4 <= bs->size)) {
+		const u8 *ptr = (const u8 *) bs->original + bs->position;
+		bs->position += 4;
+		return ((u32) ptr[0] << 24) | ((u32) ptr[1] << 16) | ((u32) ptr[2] << 8) | ptr[3];
+	}
 	ret = BS_ReadByte(bs);
 	ret<<=8;
 	ret |= BS_ReadByte(bs);
@@ -344,6 +420,14 @@ GF_EXPORT
 u64 gf_bs_read_u64(GF_BitStream *bs)
 {
 	u64 ret;
+	if ((bs->bsmode == GF_BITSTREAM_READ) && (bs->nbBits==8) && (bs->position + 8 <= bs->size)) {
+		u32 i;
+		const u8 *ptr = (const u8 *) bs->original + bs->position;
+		ret = 0;
+		for (i=0; i<8; i++) ret = (ret<<8) | ptr[i];
+		bs->position += 8;
+		return ret;
+	}
 	ret = gf_bs_read_u32(bs);
 	ret<<=32;
 	ret |= gf_bs_read_u32(bs);
@@ -358,6 +442,14 @@ u64 gf_bs_read_long_int(GF_BitStream *bs, u32 nBits)
 		gf_bs_read_long_int(bs, nBits-64);
 		ret = gf_bs_read_long_int(bs, 64);
 	} else {
+		if ((bs->bsmode == GF_BITSTREAM_READ) && (nBits>32)) {
+			ret = gf_bs_read_int(bs, nBits-32);
+			ret <<= 32;
+			ret |= gf_bs_read_int(bs, 32);
+			return ret;
+		}
+		if ((bs->bsmode == GF_BITSTREAM_READ) && nBits && BS_ReadBitsMem(bs, nBits, &ret))
+			return ret;
 		while (nBits-- > 0) {
 			ret <<= 1;
 			ret |= gf_bs_read_bit(bs);
@@ -483,14 +575,34 @@ static void BS_WriteBit(GF_BitStream *bs, u32 bit)
 	}
 }
 
+/*writes the nBits lower bits of value, filling the current byte then pushing whole bytes at once rather than bit by bit*/
+static void BS_WriteBits(GF_BitStream *bs, u64 value, u32 nBits)
+{
+	while (nBits) {
+		u32 room = 8 - bs->nbBits;
+		if (nBits >= room) {
+			nBits -= room;
+			bs->current = (bs->current << room) | ((nBits<64) ? (u32) ((value >> nBits) & ((1<<room) - 1)) : 0);
+			BS_WriteByte(bs, (u8) bs->current);
+			bs->current = 0;
+			bs->nbBits = 0;
+		} else {
+			bs->current = (bs->current << nBits) | (u32) (value & ((1<<nBits) - 1));
+			bs->nbBits += nBits;
+			return;
+		}
+	}
+}
+
 GF_EXPORT
 void gf_bs_write_int(GF_BitStream *bs, s32 value, s32 nBits)
 {
-	value <<= sizeof (s32) * 8 - nBits;
-	while (--nBits >= 0) {
-		BS_WriteBit (bs, value < 0);
-		value <<= 1;
+	if (nBits <= 0) return;
+	if (nBits>32) {
+		BS_WriteBits(bs, 0, nBits-32);
+		nBits = 32;
 	}
+	BS_WriteBits(bs, (u32) value, nBits);
 }
 
 GF_EXPORT
@@ -499,12 +611,8 @@ void gf_bs_write_long_int(GF_BitStream *bs, s64 value, s32 nBits)
 	if (nBits>64) {
 		gf_bs_write_int(bs, 0, nBits-64);
 		gf_bs_write_long_int(bs, value, 64);
-	} else {
-		value <<= sizeof (s64) * 8 - nBits;
-		while (--nBits >= 0) {
-			BS_WriteBit (bs, value < 0);
-			value <<= 1;
-		}
+	} else if (nBits > 0) {
+		BS_WriteBits(bs, (u64) value, nBits);
 	}
 }
 
@@ -1080,6 +1188,21 @@ void gf_bs_flush(GF_BitStream *bs)
 	fflush(bs->stream);
 }
 
+GF_EXPORT
+u64 gf_bs_write_file_range(GF_BitStream *bs, FILE *src, u64 offset, u64 size)
+{
+	u64 done;
+	if ((bs->bsmode != GF_BITSTREAM_FILE_WRITE) || !BS_IsAlign(bs)) return 0;
+
+	if (bs->buffer_io)
+		bs_flush_cache(bs);
+
+	done = gf_fcopy_range(bs->stream, src, offset, size);
+	bs->position += done;
+	if (bs->position > bs->size) bs->size = bs->position;
+	return done;
+}
+
 void gf_bs_reassign(GF_BitStream *bs, FILE *stream)
 {
 	if (!bs) return;
@@ -951,6 +951,12 @@ void gf_cache_set_end_range(DownloadedCacheEntry entry, u64 range_end)
 	entry->continue_file = GF_TRUE;
 }
 
+u32 gf_cache_get_memory_size(const DownloadedCacheEntry entry)
+{
+	if (!entry || !entry->memory_stored) return 0;
+	return entry->mem_allocated;
+}
+
 Bool gf_cache_is_in_progress(const DownloadedCacheEntry entry)
 {
 	if (!entry) return GF_FALSE;
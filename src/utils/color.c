@@ -28,6 +28,11 @@
 #include <gpac/constants.h>
 #include <gpac/color.h>
 
+#if defined(GPAC_HAS_SSE2)
+# include <emmintrin.h>
+#elif defined(GPAC_HAS_NEON)
+# include <arm_neon.h>
+#endif
 #ifndef GPAC_DISABLE_PLAYER
 
 /* YUV -> RGB conversion loading two lines at each call */
@@ -59,6 +64,210 @@ static void yuv2rgb_init(void)
 	}
 }
 
+/*SIMD YUV -> RGBA conversion of 8 pixels at a time. Products are computed on 32 bits with the same integer
+coefficients as the lookup tables above, so that the result is identical to the scalar code.*/
+#if defined(GPAC_HAS_SSE2) || defined(GPAC_HAS_NEON)
+#define GPAC_HAS_YUV_SIMD
+
+typedef struct
+{
+	s16 y_off, y_min;
+	s16 c_y, c_rv, c_gu, c_gv, c_bu;
+	s32 shift;
+} YUVSimdCoefs;
+
+/*BT.601 coefficients of the RGB_Y/B_U/G_U/G_V/R_V tables*/
+static const YUVSimdCoefs yuv_simd_601 = {16, -32768, FIX_OUT(1.164), FIX_OUT(1.596), FIX_OUT(0.391), FIX_OUT(0.813), FIX_OUT(2.018), SCALEBITS_OUT};
+/*coefficients of the YUV420SP loader, where luma is clamped to 16*/
+static const YUVSimdCoefs yuv_simd_420sp = {16, 0, 1192, 1634, 400, 833, 2066, 10};
+
+#ifdef GPAC_HAS_SSE2
+
+/*converts 8 pixels - y holds the 8 luma values, u and v the chroma values of each pixel, all on 16 bits.
+If a is NULL, alpha is set to 0xFF*/
+static GFINLINE void yuv_simd_store_8(u8 *dst, __m128i y, __m128i u, __m128i v, const u8 *a, const YUVSimdCoefs *c)
+{
+	__m128i r_lo, r_hi, g_lo, g_hi, b_lo, b_hi, r, g, b, alpha, rg, ba;
+	__m128i zero = _mm_setzero_si128();
+	__m128i shift = _mm_cvtsi32_si128(c->shift);
+	__m128i c128 = _mm_set1_epi16(128);
+	__m128i k_yv = _mm_set1_epi32( (u16) c->c_y | ((u32) (u16) c->c_rv << 16) );
+	__m128i k_yu = _mm_set1_epi32( (u16) c->c_y | ((u32) (u16) c->c_bu << 16) );
+	__m128i k_g = _mm_set1_epi32( (u16) c->c_gu | ((u32) (u16) c->c_gv << 16) );
+	__m128i k_gy = _mm_set1_epi32( (u16) c->c_y );
+
+	y = _mm_max_epi16(_mm_sub_epi16(y, _mm_set1_epi16(c->y_off)), _mm_set1_epi16(c->y_min));
+	u = _mm_sub_epi16(u, c128);
+	v = _mm_sub_epi16(v, c128);
+
+	/*r = c_y*y + c_rv*v, b = c_y*y + c_bu*u, g = c_y*y - (c_gu*u + c_gv*v)*/
+	r_lo = _mm_madd_epi16(_mm_unpacklo_epi16(y, v), k_yv);
+	r_hi = _mm_madd_epi16(_mm_unpackhi_epi16(y, v), k_yv);
+	b_lo = _mm_madd_epi16(_mm_unpacklo_epi16(y, u), k_yu);
+	b_hi = _mm_madd_epi16(_mm_unpackhi_epi16(y, u), k_yu);
+	g_lo = _mm_sub_epi32(_mm_madd_epi16(_mm_unpacklo_epi16(y, zero), k_gy), _mm_madd_epi16(_mm_unpacklo_epi16(u, v), k_g));
+	g_hi = _mm_sub_epi32(_mm_madd_epi16(_mm_unpackhi_epi16(y, zero), k_gy), _mm_madd_epi16(_mm_unpackhi_epi16(u, v), k_g));
+
+	r = _mm_packs_epi32(_mm_sra_epi32(r_lo, shift), _mm_sra_epi32(r_hi, shift));
+	g = _mm_packs_epi32(_mm_sra_epi32(g_lo, shift), _mm_sra_epi32(g_hi, shift));
+	b = _mm_packs_epi32(_mm_sra_epi32(b_lo, shift), _mm_sra_epi32(b_hi, shift));
+	/*saturation does the clipping*/
+	r = _mm_packus_epi16(r, r);
+	g = _mm_packus_epi16(g, g);
+	b = _mm_packus_epi16(b, b);
+	alpha = a ? _mm_loadl_epi64((const __m128i *) a) : _mm_set1_epi8((char) 0xFF);
+
+	rg = _mm_unpacklo_epi8(r, g);
+	ba = _mm_unpacklo_epi8(b, alpha);
+	_mm_storeu_si128((__m128i *) dst, _mm_unpacklo_epi16(rg, ba));
+	_mm_storeu_si128((__m128i *) (dst+16), _mm_unpackhi_epi16(rg, ba));
+}
+
+/*loads 8 luma values of 8 or 16 bits, in which case they are downshifted to 8 bits*/
+static GFINLINE __m128i yuv_simd_load_y(const u8 *y, Bool is_10)
+{
+	if (is_10) return _mm_srli_epi16(_mm_loadu_si128((const __m128i *) y), 2);
+	return _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *) y), _mm_setzero_si128());
+}
+
+/*loads 4 chroma values of 8 or 16 bits and duplicates them for 8 pixels*/
+static GFINLINE __m128i yuv_simd_load_c(const u8 *c, Bool is_10)
+{
+	__m128i v;
+	if (is_10) v = _mm_srli_epi16(_mm_loadl_epi64((const __m128i *) c), 2);
+	else {
+		s32 c4;
+		memcpy(&c4, c, 4);
+		v = _mm_unpacklo_epi8(_mm_cvtsi32_si128(c4), _mm_setzero_si128());
+	}
+	return _mm_unpacklo_epi16(v, v);
+}
+
+#else
+
+static GFINLINE void yuv_simd_store_8(u8 *dst, int16x8_t y, int16x8_t u, int16x8_t v, const u8 *a, const YUVSimdCoefs *c)
+{
+	int32x4_t r_lo, r_hi, g_lo, g_hi, b_lo, b_hi, y_lo, y_hi;
+	int32x4_t shift = vdupq_n_s32(-c->shift);
+	int16x8_t c128 = vdupq_n_s16(128);
+	uint8x8x4_t res;
+
+	y = vmaxq_s16(vsubq_s16(y, vdupq_n_s16(c->y_off)), vdupq_n_s16(c->y_min));
+	u = vsubq_s16(u, c128);
+	v = vsubq_s16(v, c128);
+
+	y_lo = vmull_n_s16(vget_low_s16(y), c->c_y);
+	y_hi = vmull_n_s16(vget_high_s16(y), c->c_y);
+	r_lo = vmlal_n_s16(y_lo, vget_low_s16(v), c->c_rv);
+	r_hi = vmlal_n_s16(y_hi, vget_high_s16(v), c->c_rv);
+	b_lo = vmlal_n_s16(y_lo, vget_low_s16(u), c->c_bu);
+	b_hi = vmlal_n_s16(y_hi, vget_high_s16(u), c->c_bu);
+	g_lo = vsubq_s32(y_lo, vmlal_n_s16(vmull_n_s16(vget_low_s16(u), c->c_gu), vget_low_s16(v), c->c_gv));
+	g_hi = vsubq_s32(y_hi, vmlal_n_s16(vmull_n_s16(vget_high_s16(u), c->c_gu), vget_high_s16(v), c->c_gv));
+
+	/*saturation does the clipping*/
+	res.val[0] = vqmovun_s16(vcombine_s16(vqmovn_s32(vshlq_s32(r_lo, shift)), vqmovn_s32(vshlq_s32(r_hi, shift))));
+	res.val[1] = vqmovun_s16(vcombine_s16(vqmovn_s32(vshlq_s32(g_lo, shift)), vqmovn_s32(vshlq_s32(g_hi, shift))));
+	res.val[2] = vqmovun_s16(vcombine_s16(vqmovn_s32(vshlq_s32(b_lo, shift)), vqmovn_s32(vshlq_s32(b_hi, shift))));
+	res.val[3] = a ? vld1_u8(a) : vdup_n_u8(0xFF);
+	vst4_u8(dst, res);
+}
+
+static GFINLINE int16x8_t yuv_simd_load_y(const u8 *y, Bool is_10)
+{
+	if (is_10) return vreinterpretq_s16_u16(vshrq_n_u16(vld1q_u16((const u16 *) y), 2));
+	return vreinterpretq_s16_u16(vmovl_u8(vld1_u8(y)));
+}
+
+static GFINLINE int16x8_t yuv_simd_load_c(const u8 *c, Bool is_10)
+{
+	uint16x4_t v;
+	if (is_10) {
+		v = vshr_n_u16(vld1_u16((const u16 *) c), 2);
+	} else {
+		u32 c4;
+		memcpy(&c4, c, 4);
+		v = vget_low_u16(vmovl_u8(vreinterpret_u8_u32(vdup_n_u32(c4))));
+	}
+	return vreinterpretq_s16_u16(vcombine_u16(vzip_u16(v, v).val[0], vzip_u16(v, v).val[1]));
+}
+
+#endif
+
+/*converts two lines of planar YUV, 8 pixels at a time - returns the number of pixels converted on each line*/
+static u32 yuv_simd_load_lines_planar(u8 *dst, s32 dststride, const u8 *y_src, const u8 *u_src, const u8 *v_src, const u8 *a_src, s32 y_stride, u32 width, Bool is_10)
+{
+	u32 x, nb = width & ~7;
+	u32 bps = is_10 ? 2 : 1;
+	for (x=0; x<nb; x+=8) {
+		const u8 *a2 = a_src ? a_src + y_stride + x : NULL;
+#ifdef GPAC_HAS_SSE2
+		__m128i u = yuv_simd_load_c(u_src + bps*x/2, is_10);
+		__m128i v = yuv_simd_load_c(v_src + bps*x/2, is_10);
+#else
+		int16x8_t u = yuv_simd_load_c(u_src + bps*x/2, is_10);
+		int16x8_t v = yuv_simd_load_c(v_src + bps*x/2, is_10);
+#endif
+		yuv_simd_store_8(dst + 4*x, yuv_simd_load_y(y_src + bps*x, is_10), u, v, a_src ? a_src + x : NULL, &yuv_simd_601);
+		yuv_simd_store_8(dst + dststride + 4*x, yuv_simd_load_y(y_src + y_stride + bps*x, is_10), u, v, a2, &yuv_simd_601);
+	}
+	return nb;
+}
+
+/*converts one line of YUYV, 8 pixels at a time - returns the number of pixels converted*/
+static u32 yuv_simd_load_line_packed(u8 *dst, const u8 *src, u32 width)
+{
+	u32 x, nb = width & ~7;
+	for (x=0; x<nb; x+=8) {
+#ifdef GPAC_HAS_SSE2
+		__m128i p = _mm_loadu_si128((const __m128i *) (src + 2*x));
+		__m128i y = _mm_and_si128(p, _mm_set1_epi16(0xFF));
+		/*chroma lanes are U0 V0 U1 V1 ...*/
+		__m128i c = _mm_srli_epi16(p, 8);
+		__m128i u = _mm_shufflehi_epi16(_mm_shufflelo_epi16(c, _MM_SHUFFLE(2, 2, 0, 0)), _MM_SHUFFLE(2, 2, 0, 0));
+		__m128i v = _mm_shufflehi_epi16(_mm_shufflelo_epi16(c, _MM_SHUFFLE(3, 3, 1, 1)), _MM_SHUFFLE(3, 3, 1, 1));
+#else
+		uint8x8x2_t p = vld2_u8(src + 2*x);
+		/*p.val[1] holds U0 V0 U1 V1 ...*/
+		uint8x8x2_t uv = vuzp_u8(p.val[1], p.val[1]);
+		uint8x8x2_t u2 = vzip_u8(uv.val[0], uv.val[0]);
+		uint8x8x2_t v2 = vzip_u8(uv.val[1], uv.val[1]);
+		int16x8_t y = vreinterpretq_s16_u16(vmovl_u8(p.val[0]));
+		int16x8_t u = vreinterpretq_s16_u16(vmovl_u8(u2.val[0]));
+		int16x8_t v = vreinterpretq_s16_u16(vmovl_u8(v2.val[0]));
+#endif
+		yuv_simd_store_8(dst + 4*x, y, u, v, NULL, &yuv_simd_601);
+	}
+	return nb;
+}
+
+/*converts one line of YUV420SP (interleaved V/U plane), 8 pixels at a time - returns the number of pixels converted*/
+static u32 yuv_simd_load_line_420sp(u8 *dst, const u8 *y_src, const u8 *vu_src, u32 width)
+{
+	u32 x, nb = width & ~7;
+	for (x=0; x<nb; x+=8) {
+#ifdef GPAC_HAS_SSE2
+		__m128i y = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *) (y_src + x)), _mm_setzero_si128());
+		/*lanes are V0 U0 V1 U1 ...*/
+		__m128i c = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *) (vu_src + x)), _mm_setzero_si128());
+		__m128i v = _mm_shufflehi_epi16(_mm_shufflelo_epi16(c, _MM_SHUFFLE(2, 2, 0, 0)), _MM_SHUFFLE(2, 2, 0, 0));
+		__m128i u = _mm_shufflehi_epi16(_mm_shufflelo_epi16(c, _MM_SHUFFLE(3, 3, 1, 1)), _MM_SHUFFLE(3, 3, 1, 1));
+#else
+		uint8x8x2_t vu = vuzp_u8(vld1_u8(vu_src + x), vld1_u8(vu_src + x));
+		uint8x8x2_t v2 = vzip_u8(vu.val[0], vu.val[0]);
+		uint8x8x2_t u2 = vzip_u8(vu.val[1], vu.val[1]);
+		int16x8_t y = vreinterpretq_s16_u16(vmovl_u8(vld1_u8(y_src + x)));
+		int16x8_t u = vreinterpretq_s16_u16(vmovl_u8(u2.val[0]));
+		int16x8_t v = vreinterpretq_s16_u16(vmovl_u8(v2.val[0]));
+#endif
+		yuv_simd_store_8(dst + 4*x, y, u, v, NULL, &yuv_simd_420sp);
+	}
+	return nb;
+}
+
+#endif /*GPAC_HAS_SSE2 || GPAC_HAS_NEON*/
+
+
 static void gf_yuv_load_lines_planar(unsigned char *dst, s32 dststride, unsigned char *y_src, unsigned char *u_src, unsigned char * v_src, s32 y_stride, s32 uv_stride, s32 width)
 {
 	u32 hw, x;
@@ -66,7 +275,16 @@ static void gf_yuv_load_lines_planar(unsigned char *dst, s32 dststride, unsigned
 	unsigned char *y_src2 = (unsigned char *) y_src + y_stride;
 
 	hw = width / 2;
-	for (x = 0; x < hw; x++) {
+	x = 0;
+#ifdef GPAC_HAS_YUV_SIMD
+	x = yuv_simd_load_lines_planar(dst, dststride, y_src, u_src, v_src, NULL, y_stride, width, GF_FALSE);
+	y_src += x;
+	y_src2 += x;
+	dst += 4*x;
+	dst2 += 4*x;
+	x /= 2;
+#endif
+	for (; x < hw; x++) {
 		s32 u, v;
 		s32 b_u, g_uv, r_v, rgb_y;
 
@@ -121,7 +339,16 @@ static void gf_yuv_10_load_lines_planar(unsigned char *dst, s32 dststride, unsig
 
 
 	hw = width / 2;
-	for (x = 0; x < hw; x++) {
+	x = 0;
+#ifdef GPAC_HAS_YUV_SIMD
+	x = yuv_simd_load_lines_planar(dst, dststride, _y_src, _u_src, _v_src, NULL, y_stride, width, GF_TRUE);
+	y_src += x;
+	y_src2 += x;
+	dst += 4*x;
+	dst2 += 4*x;
+	x /= 2;
+#endif
+	for (; x < hw; x++) {
 		s32 u, v;
 		s32 b_u, g_uv, r_v, rgb_y;
 
@@ -171,7 +398,16 @@ static void gf_yuv_load_lines_packed(unsigned char *dst, s32 dststride, unsigned
 	u32 hw, x;
 
 	hw = width / 2;
-	for (x = 0; x < hw; x++) {
+	x = 0;
+#ifdef GPAC_HAS_YUV_SIMD
+	x = yuv_simd_load_line_packed(dst, y_src, width);
+	y_src += 2*x;
+	u_src += 2*x;
+	v_src += 2*x;
+	dst += 4*x;
+	x /= 2;
+#endif
+	for (; x < hw; x++) {
 		s32 u, v;
 		s32 b_u, g_uv, r_v, rgb_y;
 
@@ -213,7 +449,18 @@ static void gf_yuva_load_lines(unsigned char *dst, s32 dststride, unsigned char
 	yuv2rgb_init();
 
 	hw = width / 2;
-	for (x = 0; x < hw; x++) {
+	x = 0;
+#ifdef GPAC_HAS_YUV_SIMD
+	x = yuv_simd_load_lines_planar(dst, dststride, y_src, u_src, v_src, a_src, y_stride, width, GF_FALSE);
+	y_src += x;
+	y_src2 += x;
+	a_src += x;
+	a_src2 += x;
+	dst += 4*x;
+	dst2 += 4*x;
+	x /= 2;
+#endif
+	for (; x < hw; x++) {
 		s32 u, v;
 		s32 b_u, g_uv, r_v, rgb_y;
 
@@ -364,11 +611,63 @@ static void copy_row_bgr_24(u8 *src, u32 src_w, u8 *dst, u32 dst_w, s32 h_inc, s
 	}
 }
 
+#ifdef GPAC_HAS_YUV_SIMD
+/*unscaled copy of RGBA pixels to a 32 bit destination with opaque alpha, skipping transparent pixels
+returns the number of pixels copied*/
+static u32 copy_row_32_simd(u8 *src, u8 *dst, u32 count, Bool swap_rb)
+{
+	u32 i, nb = count & ~7;
+	for (i=0; i<nb; i+=8) {
+#ifdef GPAC_HAS_SSE2
+		u32 k;
+		for (k=0; k<2; k++) {
+			__m128i amask = _mm_set1_epi32((int) 0xFF000000);
+			__m128i s = _mm_loadu_si128((const __m128i *) (src + 4*i + 16*k));
+			__m128i d = _mm_loadu_si128((const __m128i *) (dst + 4*i + 16*k));
+			__m128i skip = _mm_cmpeq_epi32(_mm_and_si128(s, amask), _mm_setzero_si128());
+			if (swap_rb) {
+				__m128i rb = _mm_and_si128(s, _mm_set1_epi32(0x00FF00FF));
+				rb = _mm_shufflehi_epi16(_mm_shufflelo_epi16(rb, _MM_SHUFFLE(2, 3, 0, 1)), _MM_SHUFFLE(2, 3, 0, 1));
+				s = _mm_or_si128(_mm_and_si128(s, _mm_set1_epi32(0x0000FF00)), rb);
+			}
+			s = _mm_or_si128(s, amask);
+			s = _mm_or_si128(_mm_and_si128(skip, d), _mm_andnot_si128(skip, s));
+			_mm_storeu_si128((__m128i *) (dst + 4*i + 16*k), s);
+		}
+#else
+		uint8x8x4_t s = vld4_u8(src + 4*i);
+		uint8x8x4_t d = vld4_u8(dst + 4*i);
+		uint8x8_t skip = vceq_u8(s.val[3], vdup_n_u8(0));
+		if (swap_rb) {
+			uint8x8_t t = s.val[0];
+			s.val[0] = s.val[2];
+			s.val[2] = t;
+		}
+		s.val[0] = vbsl_u8(skip, d.val[0], s.val[0]);
+		s.val[1] = vbsl_u8(skip, d.val[1], s.val[1]);
+		s.val[2] = vbsl_u8(skip, d.val[2], s.val[2]);
+		s.val[3] = vbsl_u8(skip, d.val[3], vdup_n_u8(0xFF));
+		vst4_u8(dst + 4*i, s);
+#endif
+	}
+	return nb;
+}
+#endif
+
 static void copy_row_bgrx(u8 *src, u32 src_w, u8 *dst, u32 dst_w, s32 h_inc, s32 x_pitch, u8 alpha)
 {
 	u8 a=0, r=0, g=0, b=0;
 	s32 pos = 0x10000L;
 
+#ifdef GPAC_HAS_YUV_SIMD
+	if ((h_inc == 0x10000L) && (x_pitch == 4)) {
+		u32 nb = copy_row_32_simd(src, dst, dst_w, GF_TRUE);
+		src += 4*nb;
+		dst += 4*nb;
+		dst_w -= nb;
+	}
+#endif
+
 	while (dst_w) {
 		while ( pos >= 0x10000L ) {
 			r = *src++;
@@ -394,6 +693,15 @@ static void copy_row_rgbx(u8 *src, u32 src_w, u8 *dst, u32 dst_w, s32 h_inc, s32
 	u8 a=0, r=0, g=0, b=0;
 	s32 pos = 0x10000L;
 
+#ifdef GPAC_HAS_YUV_SIMD
+	if ((h_inc == 0x10000L) && (x_pitch == 4)) {
+		u32 nb = copy_row_32_simd(src, dst, dst_w, GF_FALSE);
+		src += 4*nb;
+		dst += 4*nb;
+		dst_w -= nb;
+	}
+#endif
+
 	while ( dst_w) {
 		while ( pos >= 0x10000L ) {
 			r = *src++;
@@ -935,7 +1243,14 @@ static void load_line_YUV420SP(u8 *src_bits, u32 x_offset, u32 y_offset, u32 y_p
 
 	uvp = frameSize + (j >> 1) * width, u = 0, v = 0;
 
-	for (i=0; i<width; i++, yp++) {
+	i = 0;
+#ifdef GPAC_HAS_YUV_SIMD
+	i = yuv_simd_load_line_420sp(dst_bits, src_bits + yp, src_bits + uvp, width);
+	yp += i;
+	uvp += i;
+	dst_bits += 4*i;
+#endif
+	for (; i<width; i++, yp++) {
 
 		y = (0xff & ((int) src_bits[yp])) - 16;
 		if (y < 0) y = 0;
@@ -1142,6 +1457,7 @@ GF_Err gf_stretch_bits(GF_VideoSurface *dst, GF_VideoSurface *src, GF_Window *ds
 	if (has_alpha && dst->is_hardware_memory)
 		dst_temp_bits = (u8 *) gf_malloc(sizeof(u8) * dst_bpp * dst_w);
 
+	ka = kr = kg = kb = kl = kh = 0;
 	if (key) {
 		ka = key->alpha;
 		kr = key->r;
@@ -1476,17 +1792,6 @@ void gf_cmx_apply_fixed(GF_ColorMatrix *_this, Fixed *a, Fixed *r, Fixed *g, Fix
 }
 
 
-
-#if defined(WIN32) && !defined(__GNUC__)
-# include <intrin.h>
-# define GPAC_HAS_SSE2
-#else
-# ifdef __SSE2__
-#  include <emmintrin.h>
-#  define GPAC_HAS_SSE2
-# endif
-#endif
-
 #ifdef GPAC_HAS_SSE2
 
 static GF_Err gf_color_write_yv12_10_to_yuv_intrin(GF_VideoSurface *vs_dst,  unsigned char *pY, unsigned char *pU, unsigned char*pV, u32 src_stride, u32 src_width, u32 src_height, const GF_Window *_src_wnd, Bool swap_uv)
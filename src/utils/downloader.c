@@ -63,6 +63,7 @@
 
 
 static void gf_dm_connect(GF_DownloadSession *sess);
+void http_do_requests(GF_DownloadSession *sess);
 
 /*internal flags*/
 enum
@@ -94,6 +95,20 @@ typedef struct
 } GF_HTTPHeader;
 
 
+/*!idle connection kept alive after a completed request, for reuse by any session to the same server*/
+typedef struct
+{
+	char *server_name;
+	u16 port;
+	Bool use_ssl;
+	GF_Socket *sock;
+#ifdef GPAC_HAS_SSL
+	SSL *ssl;
+#endif
+	/*time at which the connection was put in the pool, in ms*/
+	u32 idle_since;
+} GF_DMIdleConnection;
+
 /**
  * This structure handles partial downloads
  */
@@ -201,6 +216,8 @@ struct __gf_download_manager
 	Bool disable_cache, simulate_no_connection, allow_offline_cache, clean_cache;
 	u32 limit_data_rate, read_buf_size;
 	u64 max_cache_size;
+	/*budget for memory-stored entries, 0 if unlimited*/
+	u64 max_memory_cache_size;
 
 	GF_List *skip_proxy_servers;
 	GF_List *credentials;
@@ -210,6 +227,12 @@ struct __gf_download_manager
 #ifdef GPAC_HAS_SSL
 	SSL_CTX *ssl_ctx;
 #endif
+
+	/*keep-alive connection pool, shared by all sessions*/
+	GF_Mutex *pool_mx;
+	GF_List *idle_connections;
+	u32 max_idle_connections, idle_connection_timeout;
+	u32 nb_connections_created, nb_connections_reused;
 };
 
 #ifdef GPAC_HAS_SSL
@@ -571,6 +594,20 @@ static void gf_dm_remove_cache_entry_from_session(GF_DownloadSession * sess) {
  */
 s32 gf_cache_add_session_to_cache_entry(DownloadedCacheEntry entry, GF_DownloadSession * sess);
 
+static u64 gf_dm_get_memory_cache_size(GF_DownloadManager *dm)
+{
+	u32 i, count;
+	u64 size = 0;
+	gf_mx_p( dm->cache_mx );
+	count = gf_list_count(dm->cache_entries);
+	for (i=0; i<count; i++) {
+		DownloadedCacheEntry e = (DownloadedCacheEntry)gf_list_get(dm->cache_entries, i);
+		size += gf_cache_get_memory_size(e);
+	}
+	gf_mx_v( dm->cache_mx );
+	return size;
+}
+
 static void gf_dm_configure_cache(GF_DownloadSession *sess)
 {
 	DownloadedCacheEntry entry;
@@ -584,7 +621,16 @@ static void gf_dm_configure_cache(GF_DownloadSession *sess)
 		u32 i, count;
 		entry = gf_dm_find_cached_entry_by_url(sess);
 		if (!entry) {
-			entry = gf_cache_create_entry(sess->dm, sess->dm->cache_directory, sess->orig_url, sess->range_start, sess->range_end, (sess->flags&GF_NETIO_SESSION_MEMORY_CACHE) ? GF_TRUE : GF_FALSE);
+			Bool mem_storage = (sess->flags&GF_NETIO_SESSION_MEMORY_CACHE) ? GF_TRUE : GF_FALSE;
+			/*memory budget exhausted, this resource goes through the disk cache*/
+			if (mem_storage && sess->dm->max_memory_cache_size) {
+				u64 mem_size = gf_dm_get_memory_cache_size(sess->dm);
+				if (mem_size >= sess->dm->max_memory_cache_size) {
+					GF_LOG(GF_LOG_INFO, GF_LOG_NETWORK, ("[CACHE] Memory cache uses "LLU" bytes (max "LLU"), storing %s on disk\n", mem_size, sess->dm->max_memory_cache_size, sess->orig_url));
+					mem_storage = GF_FALSE;
+				}
+			}
+			entry = gf_cache_create_entry(sess->dm, sess->dm->cache_directory, sess->orig_url, sess->range_start, sess->range_end, mem_storage);
 			gf_mx_p( sess->dm->cache_mx );
 			gf_list_add(sess->dm->cache_entries, entry);
 			gf_mx_v( sess->dm->cache_mx );
@@ -683,6 +729,126 @@ static void gf_dm_clear_headers(GF_DownloadSession *sess)
 }
 
 
+static void gf_dm_idle_connection_del(GF_DMIdleConnection *conn)
+{
+#ifdef GPAC_HAS_SSL
+	if (conn->ssl) {
+		SSL_shutdown(conn->ssl);
+		SSL_free(conn->ssl);
+	}
+#endif
+	if (conn->sock) gf_sk_del(conn->sock);
+	if (conn->server_name) gf_free(conn->server_name);
+	gf_free(conn);
+}
+
+/*moves the connection of a session whose response has been entirely received to the pool*/
+static Bool gf_dm_pool_release(GF_DownloadSession *sess)
+{
+	GF_DMIdleConnection *conn;
+	GF_DownloadManager *dm = sess->dm;
+
+	if (!dm || !dm->max_idle_connections || !sess->sock || !sess->server_name) return GF_FALSE;
+	/*persistent sessions keep their connection*/
+	if (sess->flags & GF_NETIO_SESSION_PERSISTENT) return GF_FALSE;
+	/*only reuse direct connections with a fully consumed, length-delimited response*/
+	if (sess->connection_close || sess->chunked || sess->remaining_data_size || (sess->proxy_enabled==1)) return GF_FALSE;
+	if (sess->do_requests != http_do_requests) return GF_FALSE;
+
+	GF_SAFEALLOC(conn, GF_DMIdleConnection);
+	if (!conn) return GF_FALSE;
+	conn->server_name = gf_strdup(sess->server_name);
+	conn->port = sess->port;
+	conn->use_ssl = (sess->flags & GF_DOWNLOAD_SESSION_USE_SSL) ? GF_TRUE : GF_FALSE;
+	conn->sock = sess->sock;
+	sess->sock = NULL;
+#ifdef GPAC_HAS_SSL
+	conn->ssl = sess->ssl;
+	sess->ssl = NULL;
+#endif
+	conn->idle_since = gf_sys_clock();
+
+	gf_mx_p(dm->pool_mx);
+	/*pool is full, drop the oldest connection*/
+	if (gf_list_count(dm->idle_connections) >= dm->max_idle_connections) {
+		GF_DMIdleConnection *old = (GF_DMIdleConnection *)gf_list_pop_front(dm->idle_connections);
+		gf_dm_idle_connection_del(old);
+	}
+	gf_list_add(dm->idle_connections, conn);
+	gf_mx_v(dm->pool_mx);
+
+	GF_LOG(GF_LOG_DEBUG, GF_LOG_NETWORK, ("[HTTP] Keeping connection to %s:%d alive for reuse\n", conn->server_name, conn->port));
+	return GF_TRUE;
+}
+
+/*assigns an idle connection to the session server if any. Connections timed out or closed by the server are discarded*/
+static Bool gf_dm_pool_acquire(GF_DownloadSession *sess)
+{
+	u32 i, now;
+	Bool use_ssl;
+	GF_DMIdleConnection *conn;
+	GF_DownloadManager *dm = sess->dm;
+
+	if (!dm || !dm->max_idle_connections || !sess->server_name) return GF_FALSE;
+	use_ssl = (sess->flags & GF_DOWNLOAD_SESSION_USE_SSL) ? GF_TRUE : GF_FALSE;
+
+	while (1) {
+		now = gf_sys_clock();
+		gf_mx_p(dm->pool_mx);
+		i = 0;
+		while ((conn = (GF_DMIdleConnection *)gf_list_enum(dm->idle_connections, &i))) {
+			if (now - conn->idle_since > dm->idle_connection_timeout) {
+				i--;
+				gf_list_rem(dm->idle_connections, i);
+				gf_dm_idle_connection_del(conn);
+				continue;
+			}
+			if ((conn->port != sess->port) || (conn->use_ssl != use_ssl) || strcmp(conn->server_name, sess->server_name))
+				continue;
+
+			i--;
+			gf_list_rem(dm->idle_connections, i);
+			break;
+		}
+		gf_mx_v(dm->pool_mx);
+
+		if (!conn) return GF_FALSE;
+
+		/*an idle connection has nothing to read: anything pending (including the end of stream) means the server closed it.
+		The probe does not consume data, so that TLS records are left untouched*/
+		if (gf_sk_probe(conn->sock) == GF_IP_NETWORK_EMPTY) break;
+
+		GF_LOG(GF_LOG_DEBUG, GF_LOG_NETWORK, ("[HTTP] Idle connection to %s:%d closed by server, discarding\n", conn->server_name, conn->port));
+		gf_dm_idle_connection_del(conn);
+	}
+
+	gf_mx_p(dm->pool_mx);
+	dm->nb_connections_reused++;
+	gf_mx_v(dm->pool_mx);
+
+	GF_LOG(GF_LOG_INFO, GF_LOG_NETWORK, ("[HTTP] Reusing connection to %s:%d\n", conn->server_name, conn->port));
+	sess->sock = conn->sock;
+	conn->sock = NULL;
+#ifdef GPAC_HAS_SSL
+	sess->ssl = conn->ssl;
+	conn->ssl = NULL;
+#endif
+	gf_dm_idle_connection_del(conn);
+	return GF_TRUE;
+}
+
+GF_EXPORT
+GF_Err gf_dm_get_connection_pool_stats(GF_DownloadManager *dm, u32 *nb_created, u32 *nb_reused, u32 *nb_idle)
+{
+	if (!dm) return GF_BAD_PARAM;
+	gf_mx_p(dm->pool_mx);
+	if (nb_created) *nb_created = dm->nb_connections_created;
+	if (nb_reused) *nb_reused = dm->nb_connections_reused;
+	if (nb_idle) *nb_idle = gf_list_count(dm->idle_connections);
+	gf_mx_v(dm->pool_mx);
+	return GF_OK;
+}
+
 static void gf_dm_disconnect(GF_DownloadSession *sess, Bool force_close)
 {
 	assert( sess );
@@ -774,8 +940,6 @@ void gf_dm_sess_del(GF_DownloadSession *sess)
 	GF_LOG(GF_LOG_DEBUG, GF_LOG_NETWORK, ("[Downloader] gf_dm_sess_del(%p) : DONE\n", sess ));
 }
 
-void http_do_requests(GF_DownloadSession *sess);
-
 static void gf_dm_sess_notify_state(GF_DownloadSession *sess, GF_NetIOStatus dnload_status, GF_Err error)
 {
 	if (sess->user_proc) {
@@ -1275,6 +1439,14 @@ static void gf_dm_connect(GF_DownloadSession *sess)
 
 	if (!sess->sock) {
 		sess->num_retry = 40;
+		/*reuse an idle connection to the same server if any*/
+		if (gf_dm_pool_acquire(sess)) {
+			sess->connect_time = 0;
+			sess->status = GF_NETIO_CONNECTED;
+			gf_dm_sess_notify_state(sess, GF_NETIO_CONNECTED, GF_OK);
+			gf_dm_configure_cache(sess);
+			return;
+		}
 		sess->sock = gf_sk_new(GF_SOCK_TYPE_TCP);
 	}
 
@@ -1369,6 +1541,11 @@ static void gf_dm_connect(GF_DownloadSession *sess)
 
 		sess->connect_time = (u32) (gf_sys_clock_high_res() - now);
 		sess->status = GF_NETIO_CONNECTED;
+		if (sess->dm) {
+			gf_mx_p(sess->dm->pool_mx);
+			sess->dm->nb_connections_created++;
+			gf_mx_v(sess->dm->pool_mx);
+		}
 		GF_LOG(GF_LOG_INFO, GF_LOG_NETWORK, ("[HTTP] Connected to %s:%d\n", proxy, proxy_port));
 		gf_dm_sess_notify_state(sess, GF_NETIO_CONNECTED, GF_OK);
 		gf_sk_set_buffer_size(sess->sock, GF_TRUE, GF_DOWNLOAD_BUFFER_SIZE);
@@ -1836,6 +2013,27 @@ retry_cache:
 		}
 	}
 
+	if (cfg) {
+		opt = gf_cfg_get_key(cfg, "Downloader", "MaxMemoryCacheSize");
+		if (opt) {
+			if (sscanf(opt, LLU, &dm->max_memory_cache_size)==1) {
+				if (strchr(opt, 'M')) dm->max_memory_cache_size *= 1000000;
+				else if (strchr(opt, 'K')) dm->max_memory_cache_size *= 1000;
+			}
+		}
+	}
+
+	dm->idle_connections = gf_list_new();
+	dm->pool_mx = gf_mx_new("download_manager_pool_mx");
+	dm->max_idle_connections = 8;
+	dm->idle_connection_timeout = 5000;
+	if (cfg) {
+		opt = gf_cfg_get_key(cfg, "Downloader", "MaxIdleConnections");
+		if (opt) dm->max_idle_connections = atoi(opt);
+		opt = gf_cfg_get_key(cfg, "Downloader", "IdleConnectionTimeout");
+		if (opt) dm->idle_connection_timeout = atoi(opt);
+	}
+
 	gf_mx_v( dm->cache_mx );
 	if (default_cache_dir)
 		gf_free(default_cache_dir);
@@ -1918,6 +2116,15 @@ void gf_dm_del(GF_DownloadManager *dm)
 
 	gf_list_del( dm->partial_downloads );
 	dm->partial_downloads = NULL;
+
+	while (gf_list_count(dm->idle_connections)) {
+		GF_DMIdleConnection *conn = (GF_DMIdleConnection *)gf_list_pop_back(dm->idle_connections);
+		gf_dm_idle_connection_del(conn);
+	}
+	gf_list_del(dm->idle_connections);
+	dm->idle_connections = NULL;
+	gf_mx_del(dm->pool_mx);
+	dm->pool_mx = NULL;
 	/* TODO: Not ready for now, we should find a locking strategy between several GPAC instances...
 	* gf_cache_cleanup_cache(dm);
 	*/
@@ -2143,6 +2350,8 @@ static GFINLINE void gf_dm_data_received(GF_DownloadSession *sess, u8 *payload,
 		if (sess->total_size && (sess->bytes_done > sess->total_size)) {
 			GF_LOG(GF_LOG_WARNING, GF_LOG_NETWORK, ("[HTTP] url %s received more bytes than planned!! Got %d bytes vs %d content length\n", gf_cache_get_url(sess->cache_entry), sess->bytes_done , sess->total_size ));
 			sess->bytes_done = sess->total_size;
+			/*we cannot trust what is left on this connection*/
+			sess->connection_close = GF_TRUE;
 		}
 
 		if (sess->icy_metaint > 0)
@@ -2162,6 +2371,7 @@ static GFINLINE void gf_dm_data_received(GF_DownloadSession *sess, u8 *payload,
 	}
 
 	if (sess->total_size && (sess->bytes_done == sess->total_size)) {
+		gf_dm_pool_release(sess);
 		gf_dm_disconnect(sess, GF_FALSE);
 		par.msg_type = GF_NETIO_DATA_TRANSFERED;
 		par.error = GF_OK;
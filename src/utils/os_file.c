@@ -753,3 +753,52 @@ size_t gf_fwrite(const void *ptr, size_t size, size_t nmemb,
 	return result;
 }
 
+#if defined(GPAC_CONFIG_LINUX) && !defined(GPAC_ANDROID)
+#include <sys/sendfile.h>
+#include <sys/syscall.h>
+#endif
+
+GF_EXPORT
+u64 gf_fcopy_range(FILE *dst, FILE *src, u64 src_offset, u64 size)
+{
+#if defined(GPAC_CONFIG_LINUX) && !defined(GPAC_ANDROID)
+	int fd_in, fd_out;
+	u64 dst_pos, done = 0;
+	ssize_t res;
+
+	if (!dst || !src || !size) return 0;
+	if (fflush(dst)) return 0;
+	dst_pos = gf_ftell(dst);
+	fd_in = fileno(src);
+	fd_out = fileno(dst);
+	if ((fd_in<0) || (fd_out<0)) return 0;
+
+#ifdef __NR_copy_file_range
+	{
+		loff_t off_in = (loff_t) src_offset;
+		loff_t off_out = (loff_t) dst_pos;
+		while (done < size) {
+			size_t len = (size_t) MIN(size - done, 0x40000000);
+			res = syscall(__NR_copy_file_range, fd_in, &off_in, fd_out, &off_out, len, 0);
+			if (res <= 0) break;
+			done += res;
+		}
+	}
+#endif
+	/*copy_file_range not supported (old kernel, different file systems), try sendfile which writes at the current file offset*/
+	if ((done < size) && (lseek64(fd_out, (off64_t) (dst_pos + done), SEEK_SET) != (off64_t) -1)) {
+		off64_t off = (off64_t) (src_offset + done);
+		while (done < size) {
+			size_t len = (size_t) MIN(size - done, 0x40000000);
+			res = sendfile64(fd_out, fd_in, &off, len);
+			if (res <= 0) break;
+			done += res;
+		}
+	}
+	/*resync stdio with the new file offset*/
+	gf_fseek(dst, dst_pos + done, SEEK_SET);
+	return done;
+#else
+	return 0;
+#endif
+}
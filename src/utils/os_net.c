@@ -1225,6 +1225,31 @@ GF_Err gf_sk_receive(GF_Socket *sock, char *buffer, u32 length, u32 startFrom, u
 }
 
 
+//checks without waiting nor consuming data whether something can be read on the socket
+GF_EXPORT
+GF_Err gf_sk_probe(GF_Socket *sock)
+{
+#ifndef __SYMBIAN32__
+	s32 ready;
+	struct timeval timeout;
+	fd_set Group;
+#endif
+	if (!sock || !sock->socket) return GF_BAD_PARAM;
+
+#ifndef __SYMBIAN32__
+	FD_ZERO(&Group);
+	FD_SET(sock->socket, &Group);
+	timeout.tv_sec = 0;
+	timeout.tv_usec = 0;
+
+	ready = select((int) sock->socket+1, &Group, NULL, NULL, &timeout);
+	if (ready == SOCKET_ERROR) return GF_IP_NETWORK_FAILURE;
+	if (ready && FD_ISSET(sock->socket, &Group)) return GF_OK;
+#endif
+	return GF_IP_NETWORK_EMPTY;
+}
+
+
 GF_Err gf_sk_listen(GF_Socket *sock, u32 MaxConnection)
 {
 	s32 i;
@@ -780,4 +780,50 @@ Bool gf_sema_wait_for(GF_Semaphore *sm, u32 TimeOut)
 #endif
 }
 
+
+#if !defined(WIN32) && !defined(_WIN32_WCE) && !defined(__GNUC__)
+static pthread_mutex_t atomic_mx = PTHREAD_MUTEX_INITIALIZER;
+#endif
+
+GF_EXPORT
+Bool gf_atomic_ptr_cas(void * volatile *ptr, void *old_val, void *new_val)
+{
+#if defined(WIN32) || defined(_WIN32_WCE)
+	return (InterlockedCompareExchangePointer((PVOID volatile *) ptr, new_val, old_val) == old_val) ? GF_TRUE : GF_FALSE;
+#elif defined(__GNUC__)
+	return __sync_bool_compare_and_swap(ptr, old_val, new_val) ? GF_TRUE : GF_FALSE;
+#else
+	Bool res = GF_FALSE;
+	pthread_mutex_lock(&atomic_mx);
+	if (*ptr == old_val) {
+		*ptr = new_val;
+		res = GF_TRUE;
+	}
+	pthread_mutex_unlock(&atomic_mx);
+	return res;
+#endif
+}
+
+GF_EXPORT
+void *gf_atomic_ptr_swap(void * volatile *ptr, void *new_val)
+{
+#if defined(WIN32) || defined(_WIN32_WCE)
+	return InterlockedExchangePointer((PVOID volatile *) ptr, new_val);
+#elif defined(__GNUC__)
+	void *old_val;
+	/*__sync_lock_test_and_set is only an acquire barrier*/
+	do {
+		old_val = *ptr;
+	} while (!__sync_bool_compare_and_swap(ptr, old_val, new_val));
+	return old_val;
+#else
+	void *old_val;
+	pthread_mutex_lock(&atomic_mx);
+	old_val = *ptr;
+	*ptr = new_val;
+	pthread_mutex_unlock(&atomic_mx);
+	return old_val;
+#endif
+}
+
 #endif
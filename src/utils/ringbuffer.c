@@ -24,19 +24,57 @@
  */
 #include <gpac/ringbuffer.h>
 
+/*the ringbuffer is single-producer / single-consumer: the writer only modifies write_ptr, the reader only modifies read_ptr.
+Each side publishes its index with release semantics once the data is written (resp. read), and loads the index of the
+other side with acquire semantics, so that no lock is needed*/
+#if defined(__clang__) || (defined(__GNUC__) && ((__GNUC__ > 4) || ((__GNUC__ == 4) && (__GNUC_MINOR__ >= 7))))
+#define RB_LOAD_ACQUIRE(_ptr)	__atomic_load_n(&(_ptr), __ATOMIC_ACQUIRE)
+#define RB_STORE_RELEASE(_ptr, _val)	__atomic_store_n(&(_ptr), (_val), __ATOMIC_RELEASE)
+#elif defined(__GNUC__)
+static GFINLINE u32 rb_load_acquire(volatile u32 *ptr)
+{
+	u32 val = *ptr;
+	__sync_synchronize();
+	return val;
+}
+#define RB_LOAD_ACQUIRE(_ptr)	rb_load_acquire(&(_ptr))
+#define RB_STORE_RELEASE(_ptr, _val)	{ __sync_synchronize(); (_ptr) = (_val); }
+#elif defined(WIN32)
+#include <windows.h>
+static GFINLINE u32 rb_load_acquire(volatile u32 *ptr)
+{
+	u32 val = *ptr;
+	MemoryBarrier();
+	return val;
+}
+#define RB_LOAD_ACQUIRE(_ptr)	rb_load_acquire(&(_ptr))
+#define RB_STORE_RELEASE(_ptr, _val)	{ MemoryBarrier(); (_ptr) = (_val); }
+#else
+#define RB_LOAD_ACQUIRE(_ptr)	(_ptr)
+#define RB_STORE_RELEASE(_ptr, _val)	(_ptr) = (_val)
+#endif
+
 GF_EXPORT
 GF_Ringbuffer * gf_ringbuffer_new(u32 sz)
 {
-	GF_Ringbuffer *rb = (GF_Ringbuffer*)gf_malloc(sizeof(GF_Ringbuffer));
-	if (sz % 2 != 0)
-		sz++;
-	rb->size = sz;
+	GF_Ringbuffer *rb;
+	u32 size = 2;
+	/*indexes are wrapped with a mask, size must be a power of 2 - the largest one fitting in a u32 is 2^31*/
+	if (sz > 0x80000000) return NULL;
+	while (size < sz) size <<= 1;
+
+	GF_SAFEALLOC(rb, GF_Ringbuffer);
+	if (!rb) return NULL;
+	rb->size = size;
 	rb->size_mask = rb->size;
 	rb->size_mask -= 1;
 	rb->write_ptr = 0;
 	rb->read_ptr = 0;
 	rb->buf = (u8*)gf_malloc (rb->size);
-	rb->mx = gf_mx_new("RingBufferMutex");
+	if (!rb->buf) {
+		gf_free(rb);
+		return NULL;
+	}
 	return rb;
 }
 
@@ -44,10 +82,8 @@ GF_EXPORT
 void gf_ringbuffer_del(GF_Ringbuffer * ringbuffer) {
 	if (!ringbuffer)
 		return;
-	gf_mx_p(ringbuffer->mx);
-	gf_free( ringbuffer->buf);
-	ringbuffer->mx = NULL;
-	gf_mx_v(ringbuffer->mx);
+	gf_free(ringbuffer->buf);
+	gf_free(ringbuffer);
 }
 
 /*!
@@ -62,96 +98,104 @@ u32 gf_ringbuffer_available_for_write (GF_Ringbuffer * rb)
 	u32 w, r;
 
 	w = rb->write_ptr;
-	r = rb->read_ptr;
+	r = RB_LOAD_ACQUIRE(rb->read_ptr);
 
-	if (w > r) {
-		return ((r - w + rb->size) & rb->size_mask) - 1;
-	} else if (w < r) {
-		return (r - w) - 1;
-	} else {
-		return rb->size - 1;
-	}
+	return (r - w - 1) & rb->size_mask;
 }
 
 GF_EXPORT
 u32 gf_ringbuffer_available_for_read (GF_Ringbuffer * rb)
 {
-	size_t w, r;
+	u32 w, r;
 
-	w = rb->write_ptr;
+	w = RB_LOAD_ACQUIRE(rb->write_ptr);
 	r = rb->read_ptr;
 
-	if (w > r) {
-		return (u32) (w - r);
-	} else {
-		return (u32) (w - r + rb->size) & rb->size_mask;
-	}
+	return (w - r) & rb->size_mask;
 }
 
 GF_EXPORT
 u32 gf_ringbuffer_read(GF_Ringbuffer *rb, u8 *dest, u32 szDest)
 {
-	u32 free_sz, sz2, to_read, n1, n2;
+	u32 free_sz, to_read, n1, read_ptr;
 
 	if ((free_sz = gf_ringbuffer_available_for_read(rb)) == 0) {
 		return 0;
 	}
 
 	to_read = szDest > free_sz ? free_sz : szDest;
+	read_ptr = rb->read_ptr;
 
-	sz2 = rb->read_ptr + to_read;
+	n1 = rb->size - read_ptr;
+	if (n1 > to_read) n1 = to_read;
 
-	if (sz2 > rb->size) {
-		n1 = rb->size - rb->read_ptr;
-		n2 = sz2 & rb->size_mask;
-	} else {
-		n1 = to_read;
-		n2 = 0;
-	}
-
-	memcpy (dest, &(rb->buf[rb->read_ptr]), n1);
-	rb->read_ptr += n1;
-	rb->read_ptr &= rb->size_mask;
-
-	if (n2) {
-		memcpy (dest + n1, &(rb->buf[rb->read_ptr]), n2);
-		rb->read_ptr += n2;
-		rb->read_ptr &= rb->size_mask;
-	}
+	memcpy (dest, &(rb->buf[read_ptr]), n1);
+	if (to_read > n1)
+		memcpy (dest + n1, rb->buf, to_read - n1);
 
+	RB_STORE_RELEASE(rb->read_ptr, (read_ptr + to_read) & rb->size_mask);
 	return to_read;
 }
 
 GF_EXPORT
 u32 gf_ringbuffer_write (GF_Ringbuffer * rb, const u8 *src, u32 sz)
 {
-	u32 free_sz, sz2, to_write, n1, n2;
+	u32 free_sz, to_write, n1, write_ptr;
 
 	if ((free_sz = gf_ringbuffer_available_for_write(rb)) == 0) {
 		return 0;
 	}
 
 	to_write = sz > free_sz ? free_sz : sz;
+	write_ptr = rb->write_ptr;
 
-	sz2 = rb->write_ptr + to_write;
-
-	if (sz2 > rb->size) {
-		n1 = rb->size - rb->write_ptr;
-		n2 = sz2 & rb->size_mask;
-	} else {
-		n1 = to_write;
-		n2 = 0;
-	}
+	n1 = rb->size - write_ptr;
+	if (n1 > to_write) n1 = to_write;
 
-	memcpy (&(rb->buf[rb->write_ptr]), src, n1);
-	rb->write_ptr += n1;
-	rb->write_ptr &= rb->size_mask;
+	memcpy (&(rb->buf[write_ptr]), src, n1);
+	if (to_write > n1)
+		memcpy (rb->buf, src + n1, to_write - n1);
 
-	if (n2) {
-		memcpy (&(rb->buf[rb->write_ptr]), src + n1, n2);
-		rb->write_ptr += n2;
-		rb->write_ptr &= rb->size_mask;
-	}
+	RB_STORE_RELEASE(rb->write_ptr, (write_ptr + to_write) & rb->size_mask);
 	return to_write;
 }
 
+GF_EXPORT
+u32 gf_ringbuffer_reserve(GF_Ringbuffer *rb, u8 **data)
+{
+	u32 free_sz, contiguous;
+
+	free_sz = gf_ringbuffer_available_for_write(rb);
+	contiguous = rb->size - rb->write_ptr;
+	if (contiguous > free_sz) contiguous = free_sz;
+	*data = contiguous ? &(rb->buf[rb->write_ptr]) : NULL;
+	return contiguous;
+}
+
+GF_EXPORT
+void gf_ringbuffer_commit(GF_Ringbuffer *rb, u32 size)
+{
+	u32 free_sz = gf_ringbuffer_available_for_write(rb);
+	if (size > free_sz) size = free_sz;
+	RB_STORE_RELEASE(rb->write_ptr, (rb->write_ptr + size) & rb->size_mask);
+}
+
+GF_EXPORT
+u32 gf_ringbuffer_peek(GF_Ringbuffer *rb, u8 **data)
+{
+	u32 avail, contiguous;
+
+	avail = gf_ringbuffer_available_for_read(rb);
+	contiguous = rb->size - rb->read_ptr;
+	if (contiguous > avail) contiguous = avail;
+	*data = contiguous ? &(rb->buf[rb->read_ptr]) : NULL;
+	return contiguous;
+}
+
+GF_EXPORT
+void gf_ringbuffer_consume(GF_Ringbuffer *rb, u32 size)
+{
+	u32 avail = gf_ringbuffer_available_for_read(rb);
+	if (size > avail) size = avail;
+	RB_STORE_RELEASE(rb->read_ptr, (rb->read_ptr + size) & rb->size_mask);
+}
@@ -5,5 +5,10 @@ test_begin "dash"
 do_test "$MP4BOX -add $MEDIA_DIR/auxiliary_files/enst_video.h264 -add $MEDIA_DIR/auxiliary_files/enst_audio.aac -new $TEMP_DIR/file.mp4" "dash-input-preparation"
 do_test "$MP4BOX -dash 1000 $TEMP_DIR/file.mp4 -out $TEMP_DIR/file.mpd" "basic-dash"
 do_playback_test "$TEMP_DIR/file.mpd" "basic-dash-playback"
+do_test "$MP4BOX -dash 1000 -dash-threads 2 -segment-name rep\$RepresentationID\$_ $TEMP_DIR/file.mp4#video $TEMP_DIR/file.mp4#video:id=v2 -out $TEMP_DIR/file-threads.mpd" "dash-threads"
+do_test "$MP4BOX -dash 2000 -frag 500 -chunk-dur 500 -profile live $TEMP_DIR/file.mp4 -out $TEMP_DIR/file-chunked.mpd" "dash-chunked"
+do_test "$MP4BOX -dash-scale 1 -dash 2 -frag 1 -chunk-dur 1 -profile live -segment-name chunk-scale_ $TEMP_DIR/file.mp4 -out $TEMP_DIR/file-chunked-scale.mpd" "dash-chunked-scale"
+do_test "$MP4BOX -dash 2000 -chunk-dur 500 -profile onDemand $TEMP_DIR/file.mp4 -out $TEMP_DIR/file-chunked-ondemand.mpd" "dash-chunked-ondemand"
+do_test "$MP4BOX -dash 2000 -chunk-dur 500 -single-file $TEMP_DIR/file.mp4 -out $TEMP_DIR/file-chunked-single.mpd" "dash-chunked-single-file"
 
 test_end
\ No newline at end of file
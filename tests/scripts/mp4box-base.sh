@@ -26,7 +26,7 @@ do_test "$MP4BOX -languages" "Languages" &
 
 test_end
 
-test_begin "mp4box-base-dump" "create-mp4" "create-dref-mp4" "raw-264" "raw-aac" "raw-text" "srt-text" "ttxt-text" "raw-sample" "flat-storage" "interleave-250ms" "frag-1s"
+test_begin "mp4box-base-dump" "create-mp4" "create-dref-mp4" "raw-264" "raw-aac" "raw-text" "srt-text" "ttxt-text" "raw-sample" "flat-storage" "interleave-250ms" "frag-1s" "push-1k" "push-single" "moov-reserve" "moov-reserve-too-small"
 if [ $test_skip != 1 ] ; then
 
 mp4file="$TEMP_DIR/test.mp4"
@@ -77,6 +77,36 @@ do_hash_test $mp4file "interleave-250ms"
 do_test "$MP4BOX -rb iso6 -frag 1000 $mp4file" "frag-1s"
 do_hash_test $mp4file "frag-1s"
 
+#parse the fragmented file in push mode by small chunks, the result must not depend on the chunk size
+do_test "$MP4BOX -dpush 1000 $mp4file -out $TEMP_DIR/push.txt" "push-1k"
+do_hash_test $TEMP_DIR/push.txt "push-1k"
+
+do_test "$MP4BOX -dpush 100000000 $mp4file -out $TEMP_DIR/push-single.txt" "push-single"
+$DIFF $TEMP_DIR/push.txt $TEMP_DIR/push-single.txt > /dev/null
+if [ $? != 0 ] ; then
+result="Push mode parsing by chunks differs from parsing in one chunk"
+fi
+
+#flat file with moov space reserved before media data, and fallback to moov after media data when the reservation is too small
+do_test "$MP4BOX -add $MEDIA_DIR/auxiliary_files/enst_video.h264 -add $MEDIA_DIR/auxiliary_files/enst_audio.aac -flat -new $TEMP_DIR/flat.mp4" "moov-reserve-ref"
+do_test "$MP4BOX -dpush 100000000 $TEMP_DIR/flat.mp4 -out $TEMP_DIR/flat.txt" "moov-reserve-ref-dump"
+
+do_test "$MP4BOX -add $MEDIA_DIR/auxiliary_files/enst_video.h264 -add $MEDIA_DIR/auxiliary_files/enst_audio.aac -flat -moov-reserve 64 -new $TEMP_DIR/reserve.mp4" "moov-reserve"
+do_hash_test $TEMP_DIR/reserve.mp4 "moov-reserve"
+do_test "$MP4BOX -dpush 100000000 $TEMP_DIR/reserve.mp4 -out $TEMP_DIR/reserve.txt" "moov-reserve-dump"
+$DIFF $TEMP_DIR/flat.txt $TEMP_DIR/reserve.txt > /dev/null
+if [ $? != 0 ] ; then
+result="Samples differ when reserving moov space"
+fi
+
+do_test "$MP4BOX -add $MEDIA_DIR/auxiliary_files/enst_video.h264 -add $MEDIA_DIR/auxiliary_files/enst_audio.aac -flat -moov-reserve 1 -new $TEMP_DIR/reserve-small.mp4" "moov-reserve-too-small"
+do_hash_test $TEMP_DIR/reserve-small.mp4 "moov-reserve-too-small"
+do_test "$MP4BOX -dpush 100000000 $TEMP_DIR/reserve-small.mp4 -out $TEMP_DIR/reserve-small.txt" "moov-reserve-too-small-dump"
+$DIFF $TEMP_DIR/flat.txt $TEMP_DIR/reserve-small.txt > /dev/null
+if [ $? != 0 ] ; then
+result="Samples differ when moov does not fit in reserved space"
+fi
+
 fi
 
 test_end